@@ -0,0 +1,128 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __BatchMath_h
+#define __BatchMath_h
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/Timer.h>
+
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
+
+#include <dax/math/Batch.h>
+#include <dax/math/Exp.h>
+#include <dax/math/Trig.h>
+
+#include <vector>
+
+namespace worklet {
+
+// Each function is described by a struct with the dax::math version for the
+// scalar worklet and the dax::math::batch version for the packet worklet.
+#define DAX_BATCH_MATH_FUNCTION(name) \
+  struct name \
+  { \
+    static const char *GetName() { return #name; } \
+    DAX_EXEC_EXPORT static dax::Scalar Scalar(dax::Scalar x) \
+    { return dax::math::name(x); } \
+    template<int Width> \
+    DAX_EXEC_EXPORT static dax::Tuple<dax::Scalar,Width> \
+    Batch(const dax::Tuple<dax::Scalar,Width> &x) \
+    { return dax::math::batch::name(x); } \
+  };
+
+DAX_BATCH_MATH_FUNCTION(Exp)
+DAX_BATCH_MATH_FUNCTION(Log)
+DAX_BATCH_MATH_FUNCTION(Sin)
+DAX_BATCH_MATH_FUNCTION(Cos)
+DAX_BATCH_MATH_FUNCTION(Sqrt)
+DAX_BATCH_MATH_FUNCTION(RSqrt)
+
+#undef DAX_BATCH_MATH_FUNCTION
+
+struct Pow
+{
+  static const char *GetName() { return "Pow"; }
+  DAX_EXEC_EXPORT static dax::Scalar Scalar(dax::Scalar x)
+  { return dax::math::Pow(x, dax::Scalar(1.5)); }
+  template<int Width>
+  DAX_EXEC_EXPORT static dax::Tuple<dax::Scalar,Width>
+  Batch(const dax::Tuple<dax::Scalar,Width> &x)
+  { return dax::math::batch::Pow(x, dax::Scalar(1.5)); }
+};
+
+template<class Function>
+class ScalarMath : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar x) const
+  {
+    return Function::Scalar(x);
+  }
+};
+
+template<class Function>
+class BatchMath : public dax::exec::WorkletMapFieldPacket<8>
+{
+public:
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar x) const
+  {
+    return Function::Batch(dax::Tuple<dax::Scalar,1>(x))[0];
+  }
+
+  template<int Width>
+  DAX_EXEC_EXPORT
+  dax::Tuple<dax::Scalar,Width>
+  operator()(const dax::Tuple<dax::Scalar,Width> &x) const
+  {
+    return Function::Batch(x);
+  }
+};
+
+}
+
+/// Returns the average time of \p iterations invocations of \p worklet.
+///
+template<class Worklet>
+double TimeWorklet(Worklet worklet,
+                   dax::cont::ArrayHandle<dax::Scalar> input,
+                   dax::cont::ArrayHandle<dax::Scalar> output,
+                   int iterations)
+{
+  dax::cont::Scheduler<> scheduler;
+
+  // Run once so that the output is allocated before timing.
+  scheduler.Invoke(worklet, input, output);
+
+  dax::cont::Timer<> timer;
+  for (int i = 0; i < iterations; i++)
+    {
+    scheduler.Invoke(worklet, input, output);
+    }
+  return timer.GetElapsedTime()/iterations;
+}
+
+#endif //__BatchMath_h
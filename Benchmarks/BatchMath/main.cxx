@@ -0,0 +1,78 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+// Compares the throughput of the dax::math functions, which call the system
+// math library once per value, with the dax::math::batch kernels evaluated on
+// packets of 8 values.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "BatchMath.h"
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 4000000;
+const int ITERATIONS = 4;
+
+template<class Function>
+void RunFunction(dax::cont::ArrayHandle<dax::Scalar> input)
+{
+  dax::cont::ArrayHandle<dax::Scalar> scalarResult;
+  dax::cont::ArrayHandle<dax::Scalar> batchResult;
+
+  const double scalarTime =
+      TimeWorklet(worklet::ScalarMath<Function>(), input, scalarResult,
+                  ITERATIONS);
+  const double batchTime =
+      TimeWorklet(worklet::BatchMath<Function>(), input, batchResult,
+                  ITERATIONS);
+
+  printf("%-6s  dax::math %7.3f ns/value  batch %7.3f ns/value  speedup %5.2fx\n",
+         Function::GetName(),
+         1E9*scalarTime/ARRAY_SIZE,
+         1E9*batchTime/ARRAY_SIZE,
+         scalarTime/batchTime);
+}
+
+} // anonymous namespace
+
+int main(int, char **)
+{
+  printf("Initializing data...\n");
+
+  // Positive values so that every function is defined on all of them.
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  srand(5347);
+  for (dax::Id i = 0; i < ARRAY_SIZE; i++)
+    {
+    const dax::Scalar t = (dax::Scalar)rand() / (dax::Scalar)RAND_MAX;
+    values[i] = (1.0f - t) * 0.01f + t * 50.0f;
+    }
+  dax::cont::ArrayHandle<dax::Scalar> input = dax::cont::make_ArrayHandle(values);
+
+  printf("Values per function       : %i\n\n", static_cast<int>(ARRAY_SIZE));
+  RunFunction<worklet::Exp>(input);
+  RunFunction<worklet::Log>(input);
+  RunFunction<worklet::Sin>(input);
+  RunFunction<worklet::Cos>(input);
+  RunFunction<worklet::Sqrt>(input);
+  RunFunction<worklet::RSqrt>(input);
+  RunFunction<worklet::Pow>(input);
+  return 0;
+}
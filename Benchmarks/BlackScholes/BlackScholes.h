@@ -24,6 +24,8 @@
 #include <dax/cont/Scheduler.h>
 #include <dax/cont/Timer.h>
 
+#include <dax/exec/WorkletMapFieldPacket.h>
+
 #include <dax/math/Exp.h>
 
 namespace worklet {
@@ -52,7 +54,7 @@ dax::Scalar CumulativeNormalDistribution(dax::Scalar d)
 }
 
 
-class BlackScholes : public dax::exec::WorkletMapField
+class BlackScholes : public dax::exec::WorkletMapFieldPacket<8>
 {
 public:
   typedef void ControlSignature(Field(In), Field(In), Field(In), Field(In),
@@ -84,6 +86,26 @@ public:
   putResult = X * expRT * (1.0f - CNDD2) - S * (1.0f - CNDD1);
   }
 
+  // The risk free rate and volatility are constants, so only the per option
+  // values come in packets.
+  template<int Width>
+  DAX_EXEC_EXPORT
+  void operator()(dax::Tuple<dax::Scalar,Width>& callResult,
+                  dax::Tuple<dax::Scalar,Width>& putResult,
+                  const dax::Tuple<dax::Scalar,Width>& stockPrice,
+                  const dax::Tuple<dax::Scalar,Width>& optionStrike,
+                  const dax::Tuple<dax::Scalar,Width>& optionYears,
+                  const dax::Scalar Riskfree,
+                  const dax::Scalar Volatility) const
+  {
+  for (int lane = 0; lane < Width; lane++)
+    {
+    (*this)(callResult[lane], putResult[lane],
+            stockPrice[lane], optionStrike[lane], optionYears[lane],
+            Riskfree, Volatility);
+    }
+  }
+
 };
 
 }
@@ -0,0 +1,126 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __HugePageGather_h
+#define __HugePageGather_h
+
+#include <dax/CellTag.h>
+#include <dax/cont/ArrayContainerControlAligned.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <vector>
+
+namespace worklet {
+
+// Averages the coordinates of the points of each cell, which gathers
+// NUM_VERTICES point coordinates per cell through the cell connections.
+class CellCentroid : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,CellTag> &coordinates) const
+  {
+    dax::Vector3 sum = coordinates[0];
+    for (int vertex = 1; vertex < coordinates.NUM_VERTICES; vertex++)
+      {
+      sum = sum + coordinates[vertex];
+      }
+    return (dax::Scalar(1)/coordinates.NUM_VERTICES)*sum;
+  }
+};
+
+}
+
+/// The average times of the gathers for one way of allocating the arrays.
+///
+struct GatherTimes
+{
+  double CellGather;
+  double PermutationGather;
+};
+
+/// Copies the connections and points into arrays allocated with \c
+/// ContainerTag and returns the average time of \p iterations gathers of the
+/// cell centroids through the topology and of the point coordinates through
+/// an ArrayHandlePermutation.
+///
+template<class ContainerTag>
+GatherTimes TimeGathers(const std::vector<dax::Id> &connections,
+                        const std::vector<dax::Vector3> &points,
+                        int iterations)
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+  typedef dax::cont::UnstructuredGrid<
+      dax::CellTagHexahedron, ContainerTag, ContainerTag> GridType;
+
+  GridType grid;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(connections),
+                  grid.GetCellConnections());
+  Algorithm::Copy(dax::cont::make_ArrayHandle(points),
+                  grid.GetPointCoordinates());
+
+  dax::cont::Scheduler<> scheduler;
+  dax::cont::ArrayHandle<dax::Vector3, ContainerTag> centroids;
+  dax::cont::ArrayHandle<dax::Vector3, ContainerTag> gathered;
+
+  // Run once so that the outputs are allocated before timing.
+  scheduler.Invoke(worklet::CellCentroid(),
+                   grid,
+                   grid.GetPointCoordinates(),
+                   centroids);
+  Algorithm::Copy(
+        dax::cont::make_ArrayHandlePermutation(grid.GetCellConnections(),
+                                               grid.GetPointCoordinates()),
+        gathered);
+
+  GatherTimes times;
+  dax::cont::Timer<> timer;
+  for (int i = 0; i < iterations; i++)
+    {
+    scheduler.Invoke(worklet::CellCentroid(),
+                     grid,
+                     grid.GetPointCoordinates(),
+                     centroids);
+    }
+  times.CellGather = timer.GetElapsedTime()/iterations;
+
+  timer.Reset();
+  for (int i = 0; i < iterations; i++)
+    {
+    Algorithm::Copy(
+          dax::cont::make_ArrayHandlePermutation(grid.GetCellConnections(),
+                                                 grid.GetPointCoordinates()),
+          gathered);
+    }
+  times.PermutationGather = timer.GetElapsedTime()/iterations;
+  return times;
+}
+
+#endif //__HugePageGather_h
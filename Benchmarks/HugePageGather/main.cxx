@@ -0,0 +1,86 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+// Compares the time of gathering point coordinates for cells (through the
+// unstructured topology and through an ArrayHandlePermutation) when the
+// arrays are allocated with std::allocator, aligned to a cache line, and
+// backed by transparent or hugetlb huge pages. The cells connect random
+// points, so nearly every gather misses both the cache and the TLB.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "HugePageGather.h"
+
+namespace {
+
+const dax::Id NUMBER_OF_POINTS = 4*1024*1024;
+const dax::Id NUMBER_OF_CELLS = 256*1024;
+const int ITERATIONS = 4;
+
+template<class ContainerTag>
+void RunGathers(const char *name,
+                const std::vector<dax::Id> &connections,
+                const std::vector<dax::Vector3> &points)
+{
+  GatherTimes times =
+      TimeGathers<ContainerTag>(connections, points, ITERATIONS);
+  printf("%-22s  cell gather %7.3f ns/cell  permutation %7.3f ns/value\n",
+         name,
+         1E9*times.CellGather/NUMBER_OF_CELLS,
+         1E9*times.PermutationGather/connections.size());
+}
+
+} // anonymous namespace
+
+int main(int, char **)
+{
+  printf("Initializing data...\n");
+
+  std::vector<dax::Vector3> points(NUMBER_OF_POINTS);
+  srand(5347);
+  for (dax::Id i = 0; i < NUMBER_OF_POINTS; i++)
+    {
+    points[i] = dax::make_Vector3(static_cast<dax::Scalar>(rand()),
+                                  static_cast<dax::Scalar>(rand()),
+                                  static_cast<dax::Scalar>(rand()));
+    }
+  std::vector<dax::Id> connections(8*NUMBER_OF_CELLS);
+  for (std::size_t i = 0; i < connections.size(); i++)
+    {
+    connections[i] = static_cast<dax::Id>(
+          ((static_cast<unsigned long>(rand()) << 16) ^ rand())
+          % NUMBER_OF_POINTS);
+    }
+
+  printf("Number of points          : %i\n", static_cast<int>(NUMBER_OF_POINTS));
+  printf("Number of hexahedra       : %i\n\n", static_cast<int>(NUMBER_OF_CELLS));
+
+  RunGathers<dax::cont::ArrayContainerControlTagBasic>(
+        "std::allocator", connections, points);
+  RunGathers<dax::cont::ArrayContainerControlTagAligned<
+      dax::cont::ALIGNMENT_CACHE_LINE> >(
+        "cache line aligned", connections, points);
+  RunGathers<dax::cont::ArrayContainerControlTagAligned<
+      dax::cont::ALIGNMENT_CACHE_LINE, dax::cont::HUGE_PAGES_TRANSPARENT> >(
+        "transparent huge pages", connections, points);
+  RunGathers<dax::cont::ArrayContainerControlTagAligned<
+      dax::cont::ALIGNMENT_CACHE_LINE, dax::cont::HUGE_PAGES_HUGETLB> >(
+        "hugetlb huge pages", connections, points);
+  return 0;
+}
@@ -0,0 +1,146 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __PrecisionPolicy_h
+#define __PrecisionPolicy_h
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/worklet/CellGradient.h>
+#include <dax/worklet/Magnitude.h>
+
+#include <algorithm>
+#include <vector>
+
+typedef dax::worklet::CellGradientWithPrecision<dax::math::PrecisionTagExact>
+    CellGradientExact;
+typedef dax::worklet::CellGradientWithPrecision<dax::math::PrecisionTagFast>
+    CellGradientFast;
+typedef dax::worklet::MagnitudeWithPrecision<dax::math::PrecisionTagExact>
+    MagnitudeExact;
+typedef dax::worklet::MagnitudeWithPrecision<dax::math::PrecisionTagFast>
+    MagnitudeFast;
+
+typedef dax::cont::UnstructuredGrid<dax::CellTagHexahedron> HexahedronGrid;
+
+/// Builds a grid of hexahedra with the same points and cells as \p uniform.
+///
+HexahedronGrid MakeHexahedronGrid(const dax::cont::UniformGrid<> &uniform)
+{
+  const dax::Id3 cellDims = dax::extentCellDimensions(uniform.GetExtent());
+  const dax::Id3 offsets[8] = {
+    dax::make_Id3(0,0,0), dax::make_Id3(1,0,0),
+    dax::make_Id3(1,1,0), dax::make_Id3(0,1,0),
+    dax::make_Id3(0,0,1), dax::make_Id3(1,0,1),
+    dax::make_Id3(1,1,1), dax::make_Id3(0,1,1)
+  };
+
+  std::vector<dax::Id> connections;
+  connections.reserve(8*uniform.GetNumberOfCells());
+  for (dax::Id k = 0; k < cellDims[2]; k++)
+    {
+    for (dax::Id j = 0; j < cellDims[1]; j++)
+      {
+      for (dax::Id i = 0; i < cellDims[0]; i++)
+        {
+        for (int vertex = 0; vertex < 8; vertex++)
+          {
+          connections.push_back(uniform.ComputePointIndex(
+                                  dax::make_Id3(i,j,k) + offsets[vertex]));
+          }
+        }
+      }
+    }
+
+  std::vector<dax::Vector3> points(uniform.GetNumberOfPoints());
+  for (dax::Id index = 0; index < uniform.GetNumberOfPoints(); index++)
+    {
+    points[index] = uniform.ComputePointCoordinates(index);
+    }
+
+  // Copy the data into the grid's own arrays since the vectors go away.
+  typedef dax::cont::DeviceAdapterAlgorithm<
+      DAX_DEFAULT_DEVICE_ADAPTER_TAG> Algorithm;
+  dax::cont::ArrayHandle<dax::Id> connectionsHandle;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(connections), connectionsHandle);
+  dax::cont::ArrayHandle<dax::Vector3> pointsHandle;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(points), pointsHandle);
+  return HexahedronGrid(connectionsHandle, pointsHandle);
+}
+
+/// Returns the largest relative difference between the magnitudes of
+/// corresponding values, ignoring values that are nearly zero.
+///
+template<typename T>
+double MaxRelativeError(dax::cont::ArrayHandle<T> approximate,
+                        dax::cont::ArrayHandle<T> exact)
+{
+  std::vector<T> approximateValues(approximate.GetNumberOfValues());
+  std::vector<T> exactValues(exact.GetNumberOfValues());
+  approximate.CopyInto(approximateValues.begin());
+  exact.CopyInto(exactValues.begin());
+
+  double maxError = 0;
+  for (std::size_t index = 0; index < exactValues.size(); index++)
+    {
+    const double expected = dax::math::Magnitude(exactValues[index]);
+    if (expected < 1e-6) { continue; }
+    const double difference =
+        dax::math::Magnitude(approximateValues[index] - exactValues[index]);
+    maxError = std::max(maxError, difference/expected);
+    }
+  return maxError;
+}
+
+template<class Worklet, class Grid, class Coordinates, class Field, class Result>
+double TimeCellWorklet(const Grid &grid,
+                       Coordinates coordinates,
+                       Field field,
+                       Result result,
+                       int iterations)
+{
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Worklet(), grid, coordinates, field, result);
+
+  dax::cont::Timer<> timer;
+  for (int i = 0; i < iterations; i++)
+    {
+    scheduler.Invoke(Worklet(), grid, coordinates, field, result);
+    }
+  return timer.GetElapsedTime()/iterations;
+}
+
+template<class Worklet, class Input, class Result>
+double TimeFieldWorklet(Input input, Result result, int iterations)
+{
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Worklet(), input, result);
+
+  dax::cont::Timer<> timer;
+  for (int i = 0; i < iterations; i++)
+    {
+    scheduler.Invoke(Worklet(), input, result);
+    }
+  return timer.GetElapsedTime()/iterations;
+}
+
+#endif //__PrecisionPolicy_h
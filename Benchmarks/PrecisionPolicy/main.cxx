@@ -0,0 +1,101 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+// Compares the speed and accuracy of the CellGradient and Magnitude worklets
+// when they use dax::math::PrecisionTagExact and dax::math::PrecisionTagFast.
+
+#include <stdio.h>
+
+#include "PrecisionPolicy.h"
+
+namespace {
+
+const dax::Id GRID_SIZE = 64;
+const int ITERATIONS = 4;
+
+void PrintResult(const char *name,
+                 dax::Id count,
+                 double exactTime,
+                 double fastTime,
+                 double error)
+{
+  printf("%-24s exact %7.2f ns  fast %7.2f ns  speedup %5.2fx  "
+         "max relative error %.2e\n",
+         name,
+         1E9*exactTime/count,
+         1E9*fastTime/count,
+         exactTime/fastTime,
+         error);
+}
+
+template<class Grid>
+void RunCellGradient(const char *name,
+                     const Grid &grid,
+                     dax::cont::ArrayHandle<dax::Scalar> field)
+{
+  dax::cont::ArrayHandle<dax::Vector3> exactGradient;
+  dax::cont::ArrayHandle<dax::Vector3> fastGradient;
+
+  const double exactTime = TimeCellWorklet<CellGradientExact>(
+        grid, grid.GetPointCoordinates(), field, exactGradient, ITERATIONS);
+  const double fastTime = TimeCellWorklet<CellGradientFast>(
+        grid, grid.GetPointCoordinates(), field, fastGradient, ITERATIONS);
+
+  PrintResult(name,
+              grid.GetNumberOfCells(),
+              exactTime,
+              fastTime,
+              MaxRelativeError(fastGradient, exactGradient));
+}
+
+} // anonymous namespace
+
+int main(int, char **)
+{
+  printf("Initializing data...\n");
+
+  dax::cont::UniformGrid<> uniform;
+  uniform.SetExtent(dax::make_Id3(0, 0, 0),
+                    dax::make_Id3(GRID_SIZE, GRID_SIZE, GRID_SIZE));
+  uniform.SetOrigin(dax::make_Vector3(-1, -1, -1));
+  uniform.SetSpacing(dax::make_Vector3(2.0f/GRID_SIZE,
+                                       2.0f/GRID_SIZE,
+                                       2.0f/GRID_SIZE));
+  HexahedronGrid hexahedra = MakeHexahedronGrid(uniform);
+
+  printf("Cells: %d  Points: %d\n\n",
+         static_cast<int>(uniform.GetNumberOfCells()),
+         static_cast<int>(uniform.GetNumberOfPoints()));
+
+  // Magnitude of the point coordinates, which is also the field for the
+  // gradients.
+  dax::cont::ArrayHandle<dax::Scalar> exactMagnitude;
+  dax::cont::ArrayHandle<dax::Scalar> fastMagnitude;
+  const double exactTime = TimeFieldWorklet<MagnitudeExact>(
+        uniform.GetPointCoordinates(), exactMagnitude, ITERATIONS);
+  const double fastTime = TimeFieldWorklet<MagnitudeFast>(
+        uniform.GetPointCoordinates(), fastMagnitude, ITERATIONS);
+  PrintResult("Magnitude",
+              uniform.GetNumberOfPoints(),
+              exactTime,
+              fastTime,
+              MaxRelativeError(fastMagnitude, exactMagnitude));
+
+  RunCellGradient("CellGradient (voxel)", uniform, exactMagnitude);
+  RunCellGradient("CellGradient (hexahedron)", hexahedra, exactMagnitude);
+
+  return 0;
+}
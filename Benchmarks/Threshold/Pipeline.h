@@ -27,6 +27,7 @@
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/VectorOperations.h>
+#include <dax/cont/io/LegacyVTKWriter.h>
 
 #include <dax/worklet/Magnitude.h>
 #include <dax/worklet/Threshold.h>
@@ -100,64 +101,6 @@ void PrintResults(int pipeline, double time)
             << pipeline << "," << time << std::endl;
 }
 
-template<typename T, typename Stream>
-void PrintContentsToStream(dax::cont::UnstructuredGrid<T>& grid, Stream &stream)
-  {
-  const dax::Id num_points(grid.GetNumberOfPoints());
-  const dax::Id num_cells(grid.GetNumberOfCells());
-
-  //dump header
-  stream << "# vtk DataFile Version 3.0"  << std::endl;
-  stream << "vtk output" << std::endl;
-  stream << "ASCII"  << std::endl;
-  stream << "DATASET UNSTRUCTURED_GRID" << std::endl;
-  stream << "POINTS " << num_points << " float" << std::endl;
-
-  std::vector<dax::Vector3> contPoints(num_points);
-  grid.GetPointCoordinates().CopyInto(contPoints.begin());
-
-  for(dax::Id i=0; i < num_points; ++i)
-    {
-    dax::Vector3 coord = contPoints[i];
-    stream << coord[0] << " " << coord[1] << " " << coord[2] << " ";
-    if(i%3==2)
-      {
-      stream << std::endl; //pump new line after each 3rd vector
-      }
-    }
-  if(num_points%3!=0)
-    {
-    stream << std::endl;
-    }
-
-  //print cells
-  enum {NUM_VERTS = dax::CellTraits<T>::NUM_VERTICES};
-  stream << "CELLS " << num_cells << " " << num_cells  * (NUM_VERTS+1) << std::endl;
-
-  std::vector<dax::Id> contTopo(num_cells*NUM_VERTS);
-  grid.GetCellConnections().CopyInto(contTopo.begin());
-
-  dax::Id index=0;
-  for(dax::Id i=0; i < num_cells; ++i,index+=NUM_VERTS)
-    {
-    stream << NUM_VERTS << " ";
-    stream << contTopo[index+0] << " ";
-    stream << contTopo[index+1] << " ";
-    stream << contTopo[index+2] << " ";
-    stream << contTopo[index+3] << " ";
-    stream << contTopo[index+4] << " ";
-    stream << contTopo[index+5] << " ";
-    stream << contTopo[index+6] << " ";
-    stream << contTopo[index+7] << std::endl;
-    }
-  stream << std::endl;
-  stream << "CELL_TYPES " << num_cells << std::endl;
-  for(dax::Id i=0; i < num_cells; ++i)
-    {
-    stream << "12" << std::endl; //11 is voxel && 12 is hexa
-    }
-  }
-
 void RunDAXPipeline(const dax::cont::UniformGrid<> &grid)
 {
   std::cout << "Running pipeline 1: Magnitude -> Threshold" << std::endl;
@@ -198,9 +141,10 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid)
 
   if(time < 0) //rough dump to file, currently disabled
     {
-    std::ofstream file;
-    file.open ("daxResult.vtk");
-    PrintContentsToStream(grid2,file);
+    std::ofstream file("daxResult.vtk", std::ios::out | std::ios::binary);
+    dax::cont::io::LegacyVTKWriter<> writer(file);
+    writer.WriteGrid(grid2);
+    writer.WritePointField("magnitude", resultHandle);
     file.close();
     }
 
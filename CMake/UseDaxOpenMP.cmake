@@ -35,16 +35,6 @@ if (Dax_OpenMP_FOUND)
   endif (NOT Boost_FOUND)
 endif (Dax_OpenMP_FOUND)
 
-# Find the Thrust library.
-if (Dax_OpenMP_FOUND)
-  find_package(Thrust)
-
-  if (NOT THRUST_FOUND)
-    message(STATUS "Thrust not found")
-    set(Dax_OpenMP_FOUND)
-  endif (NOT THRUST_FOUND)
-endif (Dax_OpenMP_FOUND)
-
 # Find OpenMP support.
 if (Dax_OpenMP_FOUND)
   find_package(OpenMP)
@@ -59,7 +49,6 @@ endif (Dax_OpenMP_FOUND)
 if (Dax_OpenMP_FOUND)
   include_directories(
     ${Boost_INCLUDE_DIRS}
-    ${THRUST_INCLUDE_DIRS}
     ${Dax_INCLUDE_DIRS}
     )
 
@@ -32,6 +32,38 @@ struct not_default_constructor
     return (x  != T());
   }
 };
+
+/// Binary functor returning the sum of its arguments. This is the operation
+/// used by the scans in DeviceAdapterAlgorithm when none is given.
+struct Add
+{
+  template<typename T>
+  DAX_EXEC_CONT_EXPORT T operator()(const T &a, const T &b) const
+  {
+    return a + b;
+  }
+};
+
+/// Binary functor returning the larger of its arguments. Scanning with it
+/// gives the running maximum.
+struct Maximum
+{
+  template<typename T>
+  DAX_EXEC_CONT_EXPORT T operator()(const T &a, const T &b) const
+  {
+    return (a < b) ? b : a;
+  }
+};
+
+/// Binary functor returning the smaller of its arguments.
+struct Minimum
+{
+  template<typename T>
+  DAX_EXEC_CONT_EXPORT T operator()(const T &a, const T &b) const
+  {
+    return (b < a) ? b : a;
+  }
+};
 }
 
 
@@ -0,0 +1,369 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlAligned_h
+#define __dax_cont_ArrayContainerControlAligned_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlOutOfMemory.h>
+#include <dax/cont/internal/ArrayPortalFromIterators.h>
+
+#include <boost/static_assert.hpp>
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#else
+#include <malloc.h>
+#endif
+
+#include <cstddef>
+
+namespace dax {
+namespace cont {
+
+/// Special alignments for ArrayContainerControlTagAligned. Any other power of
+/// two (in bytes) may be used as well.
+///
+enum AllocationAlignment {
+  /// Align to a cache line, which is also enough for any aligned SIMD load.
+  ALIGNMENT_CACHE_LINE = 64,
+  /// Align to the page size of the system.
+  ALIGNMENT_PAGE = 0
+};
+
+/// How ArrayContainerControlTagAligned backs large arrays with huge pages.
+/// Huge pages cut the TLB misses of random gathers into multi-megabyte
+/// arrays. Arrays smaller than a huge page always use normal pages.
+///
+enum HugePageMode {
+  /// Use normal pages.
+  HUGE_PAGES_NONE,
+  /// Align the array to a huge page and ask the kernel to back it with
+  /// transparent huge pages (madvise MADV_HUGEPAGE).
+  HUGE_PAGES_TRANSPARENT,
+  /// Map the array from the reserved huge page pool (mmap MAP_HUGETLB). If
+  /// the pool does not have enough pages, fall back to transparent huge pages.
+  HUGE_PAGES_HUGETLB
+};
+
+/// \brief A tag for basic arrays with control over how memory is allocated.
+///
+/// These arrays behave like those of ArrayContainerControlTagBasic, but the
+/// start of the array is aligned to \c Alignment bytes (either a power of two
+/// or ALIGNMENT_PAGE) and large arrays can be backed by huge pages as
+/// selected by \c HugePages. Device adapters that share memory with the
+/// control environment run directly on this memory.
+///
+/// Unlike the basic container, the memory cannot be stolen because it has to
+/// be released the same way it was allocated.
+///
+template<int Alignment = ALIGNMENT_CACHE_LINE,
+         HugePageMode HugePages = HUGE_PAGES_NONE>
+struct ArrayContainerControlTagAligned {
+  BOOST_STATIC_ASSERT((Alignment >= 0) && ((Alignment & (Alignment-1)) == 0));
+};
+
+namespace internal {
+
+/// Returns the size of a normal memory page.
+///
+DAX_CONT_EXPORT std::size_t GetPageSize()
+{
+#ifndef _WIN32
+  static const std::size_t pageSize =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return pageSize;
+#else
+  return 4096;
+#endif
+}
+
+/// Returns the size of the default huge page, as reported by the kernel.
+///
+DAX_CONT_EXPORT std::size_t GetHugePageSize()
+{
+#ifndef _WIN32
+  static std::size_t hugePageSize = 0;
+  if (hugePageSize == 0)
+    {
+    // Use the common x86 size if the kernel does not say.
+    std::size_t size = 2*1024*1024;
+    std::ifstream meminfo("/proc/meminfo");
+    std::string field;
+    while (meminfo >> field)
+      {
+      if (field == "Hugepagesize:")
+        {
+        std::size_t kilobytes;
+        if (meminfo >> kilobytes) { size = kilobytes*1024; }
+        break;
+        }
+      }
+    hugePageSize = size;
+    }
+  return hugePageSize;
+#else
+  return 2*1024*1024;
+#endif
+}
+
+/// Owns a block of memory with a given alignment, optionally backed by huge
+/// pages. The block is released when the object is destroyed.
+///
+class AlignedAllocation
+{
+public:
+  DAX_CONT_EXPORT
+  AlignedAllocation()
+    : Memory(NULL), NumberOfBytes(0), HugePages(HUGE_PAGES_NONE) {  }
+
+  DAX_CONT_EXPORT
+  ~AlignedAllocation()
+  {
+    this->Release();
+  }
+
+  /// Allocates \p numberOfBytes, releasing any previous block. Throws
+  /// ErrorControlOutOfMemory if the memory cannot be allocated.
+  ///
+  DAX_CONT_EXPORT
+  void Allocate(std::size_t numberOfBytes,
+                std::size_t alignment,
+                HugePageMode hugePages)
+  {
+    this->Release();
+    if (numberOfBytes == 0) { return; }
+    if (alignment == ALIGNMENT_PAGE) { alignment = GetPageSize(); }
+    if (alignment < sizeof(void*)) { alignment = sizeof(void*); }
+
+    const std::size_t hugePageSize = GetHugePageSize();
+    if (numberOfBytes < hugePageSize) { hugePages = HUGE_PAGES_NONE; }
+
+#if !defined(_WIN32) && defined(MAP_HUGETLB)
+    if (hugePages == HUGE_PAGES_HUGETLB)
+      {
+      const std::size_t mappedBytes = RoundUp(numberOfBytes, hugePageSize);
+      void *mapping = mmap(NULL,
+                           mappedBytes,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                           -1,
+                           0);
+      if (mapping != MAP_FAILED)
+        {
+        this->Memory = mapping;
+        this->NumberOfBytes = mappedBytes;
+        this->HugePages = HUGE_PAGES_HUGETLB;
+        return;
+        }
+      }
+#endif
+    if (hugePages != HUGE_PAGES_NONE)
+      {
+      // Align to (and fill) whole huge pages so that the kernel can back all
+      // of the array with them.
+      hugePages = HUGE_PAGES_TRANSPARENT;
+      if (alignment < hugePageSize) { alignment = hugePageSize; }
+      numberOfBytes = RoundUp(numberOfBytes, hugePageSize);
+      }
+
+#ifndef _WIN32
+    void *memory;
+    if (posix_memalign(&memory, alignment, numberOfBytes) != 0)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate aligned control array.");
+      }
+#ifdef MADV_HUGEPAGE
+    // The hint is only advice, so a failure just leaves normal pages.
+    if ((hugePages == HUGE_PAGES_TRANSPARENT)
+        && (madvise(memory, numberOfBytes, MADV_HUGEPAGE) != 0))
+      {
+      hugePages = HUGE_PAGES_NONE;
+      }
+#else
+    hugePages = HUGE_PAGES_NONE;
+#endif
+#else //_WIN32
+    void *memory = _aligned_malloc(numberOfBytes, alignment);
+    if (memory == NULL)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate aligned control array.");
+      }
+    hugePages = HUGE_PAGES_NONE;
+#endif //_WIN32
+
+    this->Memory = memory;
+    this->NumberOfBytes = numberOfBytes;
+    this->HugePages = hugePages;
+  }
+
+  DAX_CONT_EXPORT
+  void Release()
+  {
+    if (this->Memory == NULL) { return; }
+#ifndef _WIN32
+    if (this->HugePages == HUGE_PAGES_HUGETLB)
+      {
+      munmap(this->Memory, this->NumberOfBytes);
+      }
+    else
+      {
+      free(this->Memory);
+      }
+#else
+    _aligned_free(this->Memory);
+#endif
+    this->Memory = NULL;
+    this->NumberOfBytes = 0;
+    this->HugePages = HUGE_PAGES_NONE;
+  }
+
+  DAX_CONT_EXPORT
+  void *GetMemory() const { return this->Memory; }
+
+  /// The size of the block, which may be larger than requested when it is
+  /// rounded up to whole huge pages.
+  DAX_CONT_EXPORT
+  std::size_t GetNumberOfBytes() const { return this->NumberOfBytes; }
+
+  /// How the block is actually backed, which can be less than requested if
+  /// the block is small or huge pages are not available.
+  DAX_CONT_EXPORT
+  HugePageMode GetHugePageMode() const { return this->HugePages; }
+
+private:
+  // Not implemented.
+  AlignedAllocation(const AlignedAllocation &);
+  void operator=(const AlignedAllocation &);
+
+  DAX_CONT_EXPORT
+  static std::size_t RoundUp(std::size_t numberOfBytes, std::size_t size)
+  {
+    return ((numberOfBytes + size - 1)/size)*size;
+  }
+
+  void *Memory;
+  std::size_t NumberOfBytes;
+  HugePageMode HugePages;
+};
+
+/// An implementation of ArrayContainerControl for the aligned tag. It works
+/// like the basic container except for how the memory is allocated.
+///
+template <typename ValueT, int Alignment, HugePageMode HugePages>
+class ArrayContainerControl<
+    ValueT, dax::cont::ArrayContainerControlTagAligned<Alignment,HugePages> >
+{
+public:
+  typedef ValueT ValueType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<ValueType*> PortalType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<const ValueType*> PortalConstType;
+
+  ArrayContainerControl() : Array(NULL), NumberOfValues(0), AllocatedSize(0) { }
+
+  void ReleaseResources()
+  {
+    this->Allocation.Release();
+    this->Array = NULL;
+    this->NumberOfValues = 0;
+    this->AllocatedSize = 0;
+  }
+
+  void Allocate(dax::Id numberOfValues)
+  {
+    if (numberOfValues <= this->AllocatedSize)
+      {
+      this->NumberOfValues = numberOfValues;
+      return;
+      }
+
+    this->ReleaseResources();
+    try
+      {
+      this->Allocation.Allocate(numberOfValues*sizeof(ValueType),
+                                Alignment,
+                                HugePages);
+      }
+    catch (dax::cont::ErrorControlOutOfMemory)
+      {
+      this->ReleaseResources();
+      throw;
+      }
+    this->Array = static_cast<ValueType*>(this->Allocation.GetMemory());
+    this->AllocatedSize  = numberOfValues;
+    this->NumberOfValues = numberOfValues;
+  }
+
+  dax::Id GetNumberOfValues() const
+  {
+    return this->NumberOfValues;
+  }
+
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shrink method cannot be used to grow array.");
+      }
+
+    this->NumberOfValues = numberOfValues;
+  }
+
+  PortalType GetPortal()
+  {
+    return PortalType(this->Array, this->Array + this->NumberOfValues);
+  }
+
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Array, this->Array + this->NumberOfValues);
+  }
+
+  /// Returns how the array is actually backed. Arrays smaller than a huge
+  /// page, or allocated when huge pages are not available, report
+  /// HUGE_PAGES_NONE.
+  ///
+  HugePageMode GetHugePageMode() const
+  {
+    return this->Allocation.GetHugePageMode();
+  }
+
+private:
+  // Not implemented.
+  ArrayContainerControl(const ArrayContainerControl &src);
+  void operator=(const ArrayContainerControl &src);
+
+  AlignedAllocation Allocation;
+  ValueType *Array;
+  dax::Id NumberOfValues;
+  dax::Id AllocatedSize;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlAligned_h
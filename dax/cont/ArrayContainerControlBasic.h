@@ -68,7 +68,9 @@ public:
 
   void ReleaseResources()
   {
-    if (this->NumberOfValues > 0)
+    // Shrinking to zero values keeps the allocation, so check the allocated
+    // size rather than the number of values.
+    if (this->AllocatedSize > 0)
       {
       DAX_ASSERT_CONT(this->Array != NULL);
       AllocatorType allocator;
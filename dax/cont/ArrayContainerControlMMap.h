@@ -0,0 +1,350 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlMMap_h
+#define __dax_cont_ArrayContainerControlMMap_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+#include <string>
+
+namespace dax {
+namespace cont {
+
+/// \brief A tag for read-only arrays memory-mapped from a file.
+///
+/// An ArrayHandle with this tag reads its values straight from a region of a
+/// file mapped into memory, so loading a large raw volume neither reads the
+/// whole file up front nor holds a second copy of it. Device adapters that
+/// share memory with the control environment (such as serial, OpenMP and TBB)
+/// run directly on the mapped pages through
+/// ArrayManagerExecutionShareWithControl. Other devices copy the values as
+/// they would for any other control array.
+///
+/// Create these arrays with make_ArrayHandleMMap. Like implicit arrays, they
+/// raise an error on any operation that tries to modify them.
+///
+struct ArrayContainerControlTagMMap {  };
+
+/// Access hints passed to the operating system (with madvise) when mapping a
+/// file. The values can be or-ed together.
+///
+enum MMapAdvice {
+  MMAP_ADVICE_NORMAL = 0x0,
+  /// The values will be read mostly in order, so read ahead aggressively.
+  MMAP_ADVICE_SEQUENTIAL = 0x1,
+  /// The values will be read in no particular order, so do not read ahead.
+  MMAP_ADVICE_RANDOM = 0x2,
+  /// The values will be needed soon, so start paging them in now.
+  MMAP_ADVICE_WILL_NEED = 0x4
+};
+
+namespace internal {
+
+/// Owns a read-only mapping of a region of a file. The mapping is released
+/// when the object is destroyed.
+///
+class MappedFileRegion
+{
+public:
+  DAX_CONT_EXPORT
+  MappedFileRegion(const std::string &filename,
+                   boost::int64_t offset,
+                   boost::int64_t numberOfBytes,
+                   int advice)
+    : Data(NULL), NumberOfBytes(0)
+#ifndef _WIN32
+      , Mapping(NULL), MappingSize(0)
+#endif
+  {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Could not open " + filename + ": " + strerror(errno));
+      }
+
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) != 0)
+      {
+      close(fd);
+      throw dax::cont::ErrorControlBadValue(
+            "Could not stat " + filename + ": " + strerror(errno));
+      }
+    numberOfBytes = this->CheckRegion(fileStatus.st_size, offset, numberOfBytes);
+    if (numberOfBytes == 0) { close(fd); return; }
+
+    // mmap offsets have to be a multiple of the page size.
+    const boost::int64_t pageSize = sysconf(_SC_PAGESIZE);
+    const boost::int64_t mapOffset = (offset/pageSize)*pageSize;
+    this->MappingSize = static_cast<size_t>(numberOfBytes + offset - mapOffset);
+    this->Mapping = mmap(NULL,
+                         this->MappingSize,
+                         PROT_READ,
+                         MAP_PRIVATE,
+                         fd,
+                         static_cast<off_t>(mapOffset));
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (this->Mapping == MAP_FAILED)
+      {
+      this->Mapping = NULL;
+      throw dax::cont::ErrorControlBadValue(
+            "Could not map " + filename + ": " + strerror(errno));
+      }
+
+    // The hints are only advice, so failures are ignored.
+    if (advice & MMAP_ADVICE_SEQUENTIAL)
+      {
+      madvise(this->Mapping, this->MappingSize, MADV_SEQUENTIAL);
+      }
+    if (advice & MMAP_ADVICE_RANDOM)
+      {
+      madvise(this->Mapping, this->MappingSize, MADV_RANDOM);
+      }
+    if (advice & MMAP_ADVICE_WILL_NEED)
+      {
+      madvise(this->Mapping, this->MappingSize, MADV_WILLNEED);
+      }
+
+    this->Data = static_cast<const char *>(this->Mapping) + (offset - mapOffset);
+#else //_WIN32
+    // Without mmap we fall back to reading the region into memory.
+    (void)advice;
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+      {
+      throw dax::cont::ErrorControlBadValue("Could not open " + filename);
+      }
+    file.seekg(0, std::ios::end);
+    numberOfBytes =
+        this->CheckRegion(static_cast<boost::int64_t>(file.tellg()), offset, numberOfBytes);
+    this->Buffer.resize(static_cast<std::size_t>(numberOfBytes));
+    file.seekg(offset, std::ios::beg);
+    if (numberOfBytes > 0)
+      {
+      file.read(&this->Buffer[0], numberOfBytes);
+      this->Data = &this->Buffer[0];
+      }
+#endif //_WIN32
+    this->NumberOfBytes = numberOfBytes;
+  }
+
+  DAX_CONT_EXPORT
+  ~MappedFileRegion()
+  {
+#ifndef _WIN32
+    if (this->Mapping != NULL)
+      {
+      munmap(this->Mapping, this->MappingSize);
+      }
+#endif
+  }
+
+  DAX_CONT_EXPORT
+  const char *GetData() const { return this->Data; }
+
+  DAX_CONT_EXPORT
+  boost::int64_t GetNumberOfBytes() const { return this->NumberOfBytes; }
+
+private:
+  // Not implemented.
+  MappedFileRegion(const MappedFileRegion &);
+  void operator=(const MappedFileRegion &);
+
+  /// Returns the size of the region, which is the rest of the file if
+  /// \p numberOfBytes is negative.
+  DAX_CONT_EXPORT
+  static boost::int64_t CheckRegion(boost::int64_t fileSize,
+                                    boost::int64_t offset,
+                                    boost::int64_t numberOfBytes)
+  {
+    if ((offset < 0) || (offset > fileSize))
+      {
+      throw dax::cont::ErrorControlBadValue("File offset is past end of file.");
+      }
+    if (numberOfBytes < 0)
+      {
+      return fileSize - offset;
+      }
+    if (offset + numberOfBytes > fileSize)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Mapped region extends past end of file.");
+      }
+    return numberOfBytes;
+  }
+
+  const char *Data;
+  boost::int64_t NumberOfBytes;
+#ifndef _WIN32
+  void *Mapping;
+  size_t MappingSize;
+#else
+  std::vector<char> Buffer;
+#endif
+};
+
+/// An ArrayPortal to the values of a mapped file. The portal holds a
+/// reference to the mapping so that it stays valid as long as any copy of the
+/// portal (including those held by an ArrayHandle) exists.
+///
+template<typename T>
+class ArrayPortalMMap
+{
+public:
+  typedef T ValueType;
+  typedef const T *IteratorType;
+
+  DAX_CONT_EXPORT ArrayPortalMMap() : Begin(NULL), NumberOfValues(0) {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalMMap(const boost::shared_ptr<MappedFileRegion> &region)
+    : Region(region),
+      Begin(reinterpret_cast<const T *>(region->GetData())),
+      NumberOfValues(static_cast<dax::Id>(region->GetNumberOfBytes()/sizeof(T)))
+  {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    DAX_ASSERT_CONT(index >= 0);
+    DAX_ASSERT_CONT(index < this->GetNumberOfValues());
+    return this->Begin[index];
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const { return this->Begin; }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return this->Begin + this->NumberOfValues;
+  }
+
+private:
+  boost::shared_ptr<MappedFileRegion> Region;
+  const T *Begin;
+  dax::Id NumberOfValues;
+};
+
+template<typename T>
+class ArrayContainerControl<T, dax::cont::ArrayContainerControlTagMMap>
+{
+public:
+  typedef T ValueType;
+  typedef dax::cont::internal::ArrayPortalMMap<ValueType> PortalConstType;
+
+  // The array is read-only, so this portal has no Set and is never returned.
+  // It only exists so that the execution array managers can be declared.
+  typedef PortalConstType PortalType;
+
+  // All these methods do nothing but raise errors. The ArrayHandle holds the
+  // portal (and thus the mapping), not the container.
+  PortalType GetPortal() {
+    throw dax::cont::ErrorControlBadValue("Mapped file arrays are read-only.");
+  }
+  PortalConstType GetPortalConst() const {
+    throw dax::cont::ErrorControlBadValue(
+          "Mapped file container does not store array portal.  "
+          "Create the ArrayHandle with make_ArrayHandleMMap.");
+  }
+  dax::Id GetNumberOfValues() const {
+    throw dax::cont::ErrorControlBadValue(
+          "Mapped file container does not store array portal.  "
+          "Create the ArrayHandle with make_ArrayHandleMMap.");
+  }
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue("Mapped file arrays are read-only.");
+  }
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue("Mapped file arrays are read-only.");
+  }
+  void ReleaseResources() {
+    throw dax::cont::ErrorControlBadValue("Mapped file arrays are read-only.");
+  }
+};
+
+} // namespace internal
+
+/// Creates a read-only ArrayHandle of the \p numberOfValues values of type
+/// \c T stored in \p filename starting \p offset bytes into the file. If
+/// \p numberOfValues is negative, the array covers the rest of the file. The
+/// values are expected in the native byte order.
+///
+/// \p advice is an or-ed combination of MMapAdvice flags. Ignored on platforms
+/// without mmap, where the region is read into memory instead.
+///
+template<typename T, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandle<T, ArrayContainerControlTagMMap, DeviceAdapterTag>
+make_ArrayHandleMMap(const std::string &filename,
+                     dax::Id numberOfValues,
+                     boost::int64_t offset,
+                     int advice,
+                     DeviceAdapterTag)
+{
+  typedef dax::cont::ArrayHandle<
+      T, ArrayContainerControlTagMMap, DeviceAdapterTag> ArrayHandleType;
+  typedef typename ArrayHandleType::PortalConstControl PortalType;
+
+  const boost::int64_t numberOfBytes = (numberOfValues < 0) ?
+        -1 : static_cast<boost::int64_t>(numberOfValues)*sizeof(T);
+  boost::shared_ptr<internal::MappedFileRegion> region(
+        new internal::MappedFileRegion(filename, offset, numberOfBytes, advice));
+  return ArrayHandleType(PortalType(region));
+}
+template<typename T>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandle<
+    T, ArrayContainerControlTagMMap, DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+make_ArrayHandleMMap(const std::string &filename,
+                     dax::Id numberOfValues = -1,
+                     boost::int64_t offset = 0,
+                     int advice = MMAP_ADVICE_SEQUENTIAL)
+{
+  return make_ArrayHandleMMap<T>(filename,
+                                 numberOfValues,
+                                 offset,
+                                 advice,
+                                 DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlMMap_h
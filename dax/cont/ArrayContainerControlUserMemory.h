@@ -0,0 +1,263 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlUserMemory_h
+#define __dax_cont_ArrayContainerControlUserMemory_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlOutOfMemory.h>
+#include <dax/cont/internal/ArrayPortalFromIterators.h>
+
+#include <boost/checked_delete.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include <new>
+
+namespace dax {
+namespace cont {
+
+/// \brief A tag for arrays stored in memory owned by the caller.
+///
+/// An ArrayHandle with this tag reads and writes a buffer handed to Dax with
+/// make_ArrayHandleUserMemory, such as a field of a simulation coupled in
+/// situ. Unlike the read-only arrays made with make_ArrayHandle, these arrays
+/// can also be used as outputs. Allocating an output array of at most the
+/// size of the buffer just reuses the buffer, so device adapters that share
+/// memory with the control environment (such as serial, OpenMP and TBB) write
+/// the results of worklets straight into it, without allocating or copying.
+/// Other devices copy the results back into the buffer.
+///
+/// The buffer cannot grow. Allocating more values than it holds raises an
+/// ErrorControlBadValue.
+///
+struct ArrayContainerControlTagUserMemory {  };
+
+/// The release callback used by make_ArrayHandleUserMemory when none is
+/// given. It does nothing, so the caller keeps ownership of the buffer and
+/// has to keep it alive while any ArrayHandle uses it.
+///
+struct UserMemoryNoRelease
+{
+  template<typename T>
+  DAX_CONT_EXPORT void operator()(T *) const {  }
+};
+
+namespace internal {
+
+/// An ArrayContainerControl that uses a buffer owned by the caller. Copies of
+/// the container share the buffer. When the last copy lets go of it, the
+/// release callback given with the buffer is called.
+///
+/// A container constructed without a buffer (as for an intermediate array)
+/// allocates its own memory like the basic container does.
+///
+template <typename ValueT>
+class ArrayContainerControl<ValueT, dax::cont::ArrayContainerControlTagUserMemory>
+{
+public:
+  typedef ValueT ValueType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<ValueType*> PortalType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<const ValueType*> PortalConstType;
+
+  ArrayContainerControl()
+    : NumberOfValues(0), BufferSize(0), UserBuffer(false) {  }
+
+  /// Wraps the \p bufferSize values at \p array. \p release is called with
+  /// \p array once no container holds the buffer anymore.
+  ///
+  template<class ReleaseFunctor>
+  ArrayContainerControl(ValueType *array,
+                        dax::Id bufferSize,
+                        ReleaseFunctor release)
+    : Buffer(array, release),
+      NumberOfValues(bufferSize),
+      BufferSize(bufferSize),
+      UserBuffer(true)
+  {
+    DAX_ASSERT_CONT(bufferSize >= 0);
+    DAX_ASSERT_CONT((array != NULL) || (bufferSize == 0));
+  }
+
+  /// Lets go of the buffer. The buffer is only released once no other
+  /// container holds it.
+  ///
+  void ReleaseResources()
+  {
+    this->Buffer.reset();
+    this->NumberOfValues = 0;
+    this->BufferSize = 0;
+    this->UserBuffer = false;
+  }
+
+  void Allocate(dax::Id numberOfValues)
+  {
+    if (numberOfValues <= this->BufferSize)
+      {
+      this->NumberOfValues = numberOfValues;
+      return;
+      }
+    if (this->UserBuffer)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "A user memory array cannot grow past the size of its buffer.");
+      }
+
+    this->ReleaseResources();
+    try
+      {
+      this->Buffer.reset(new ValueType[numberOfValues],
+                         boost::checked_array_deleter<ValueType>());
+      }
+    catch (std::bad_alloc)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate user memory control array.");
+      }
+    this->NumberOfValues = numberOfValues;
+    this->BufferSize = numberOfValues;
+  }
+
+  dax::Id GetNumberOfValues() const
+  {
+    return this->NumberOfValues;
+  }
+
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shrink method cannot be used to grow array.");
+      }
+
+    this->NumberOfValues = numberOfValues;
+  }
+
+  PortalType GetPortal()
+  {
+    ValueType *array = this->Buffer.get();
+    return PortalType(array, array + this->NumberOfValues);
+  }
+
+  PortalConstType GetPortalConst() const
+  {
+    const ValueType *array = this->Buffer.get();
+    return PortalConstType(array, array + this->NumberOfValues);
+  }
+
+  /// Returns the number of values the buffer can hold.
+  ///
+  dax::Id GetBufferSize() const
+  {
+    return this->BufferSize;
+  }
+
+  /// Returns true if the buffer was given by the caller rather than
+  /// allocated by this container.
+  ///
+  bool HasUserBuffer() const
+  {
+    return this->UserBuffer;
+  }
+
+private:
+  boost::shared_ptr<ValueType> Buffer;
+  dax::Id NumberOfValues;
+  dax::Id BufferSize;
+  bool UserBuffer;
+};
+
+} // namespace internal
+
+namespace detail {
+
+/// Builds an ArrayHandle around a container that already holds a user
+/// buffer. Only used by make_ArrayHandleUserMemory, which returns the
+/// ArrayHandle itself.
+///
+template<typename T, class DeviceAdapterTag>
+class ArrayHandleUserMemory
+    : public ArrayHandle<T,
+                         dax::cont::ArrayContainerControlTagUserMemory,
+                         DeviceAdapterTag>
+{
+  typedef dax::cont::ArrayHandle<
+      T, dax::cont::ArrayContainerControlTagUserMemory, DeviceAdapterTag>
+      Superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      T, dax::cont::ArrayContainerControlTagUserMemory>
+      ArrayContainerControlType;
+
+public:
+  template<class ReleaseFunctor>
+  ArrayHandleUserMemory(T *array, dax::Id numberOfValues, ReleaseFunctor release)
+    : Superclass(ArrayContainerControlType(array, numberOfValues, release))
+  {  }
+};
+
+} // namespace detail
+
+/// Creates an ArrayHandle that reads and writes the \p numberOfValues values
+/// at \p array in place. The array starts with the values in the buffer,
+/// which the first output written to the array replaces. \p release is
+/// called with \p array (for example to free it or to hand it back to a
+/// simulation) once no ArrayHandle refers to the buffer anymore. Without
+/// \p release, the caller keeps ownership of the buffer and has to keep it
+/// alive as long as the array is used.
+///
+template<typename T, class ReleaseFunctor, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandle<T, ArrayContainerControlTagUserMemory, DeviceAdapterTag>
+make_ArrayHandleUserMemory(T *array,
+                           dax::Id numberOfValues,
+                           ReleaseFunctor release,
+                           DeviceAdapterTag)
+{
+  return detail::ArrayHandleUserMemory<T, DeviceAdapterTag>(
+        array, numberOfValues, release);
+}
+template<typename T, class ReleaseFunctor>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandle<
+    T, ArrayContainerControlTagUserMemory, DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+make_ArrayHandleUserMemory(T *array,
+                           dax::Id numberOfValues,
+                           ReleaseFunctor release)
+{
+  return make_ArrayHandleUserMemory(array,
+                                    numberOfValues,
+                                    release,
+                                    DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+}
+template<typename T>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandle<
+    T, ArrayContainerControlTagUserMemory, DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+make_ArrayHandleUserMemory(T *array, dax::Id numberOfValues)
+{
+  return make_ArrayHandleUserMemory(array,
+                                    numberOfValues,
+                                    dax::cont::UserMemoryNoRelease(),
+                                    DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlUserMemory_h
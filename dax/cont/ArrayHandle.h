@@ -26,7 +26,13 @@
 
 #include <boost/concept_check.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/smart_ptr/weak_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 namespace dax {
@@ -35,6 +41,28 @@ namespace cont {
 // Forward declaration
 namespace internal { class ArrayHandleAccess; }
 
+namespace detail {
+
+/// Whether values can be written through the iterators of a control portal.
+/// Read-only containers either give const iterators or, like the implicit
+/// containers, declare a portal whose iterator type is \c void*.
+///
+template<class IteratorType>
+struct ArrayIteratorIsWritable
+{
+  typedef typename std::iterator_traits<IteratorType>::reference ReferenceType;
+  typedef boost::integral_constant<bool,
+      !boost::is_const<
+        typename boost::remove_reference<ReferenceType>::type>::value> type;
+};
+template<>
+struct ArrayIteratorIsWritable<void*>
+{
+  typedef boost::false_type type;
+};
+
+} // namespace detail
+
 /// \brief Manages an array-worth of data.
 ///
 /// \c ArrayHandle manages as array of data that can be manipulated by Dax
@@ -53,7 +81,9 @@ namespace internal { class ArrayHandleAccess; }
 /// \c ArrayHandle behaves like a shared smart pointer in that when it is copied
 /// each copy holds a reference to the same array.  These copies are reference
 /// counted so that when all copies of the \c ArrayHandle are destroyed, any
-/// allocated memory is released.
+/// allocated memory is released. To get an independent array with the same
+/// values, use CopyOnWrite, which shares the memory until either array is
+/// modified.
 ///
 template<
     typename T,
@@ -104,6 +134,7 @@ public:
   ///
   DAX_CONT_EXPORT PortalControl GetPortalControl()
   {
+    this->PrepareForWrite();
     this->SyncControlArray();
     if (this->Internals->UserPortalValid)
       {
@@ -128,6 +159,10 @@ public:
   ///
   DAX_CONT_EXPORT PortalConstControl GetPortalConstControl() const
   {
+    if (this->Internals->SharedSource)
+      {
+      return ArrayHandle(this->Internals->SharedSource).GetPortalConstControl();
+      }
     this->SyncControlArray();
     if (this->Internals->UserPortalValid)
       {
@@ -147,7 +182,11 @@ public:
   ///
   DAX_CONT_EXPORT dax::Id GetNumberOfValues() const
   {
-    if (this->Internals->UserPortalValid)
+    if (this->Internals->SharedSource)
+      {
+      return ArrayHandle(this->Internals->SharedSource).GetNumberOfValues();
+      }
+    else if (this->Internals->UserPortalValid)
       {
       return this->Internals->UserPortal.GetNumberOfValues();
       }
@@ -174,7 +213,11 @@ public:
   {
     BOOST_CONCEPT_ASSERT((boost::OutputIterator<IteratorType, ValueType>));
     BOOST_CONCEPT_ASSERT((boost::ForwardIterator<IteratorType>));
-    if (this->Internals->ExecutionArrayValid)
+    if (this->Internals->SharedSource)
+      {
+      ArrayHandle(this->Internals->SharedSource).CopyInto(dest);
+      }
+    else if (this->Internals->ExecutionArrayValid)
       {
       this->Internals->ExecutionArray.CopyInto(dest);
       }
@@ -199,6 +242,7 @@ public:
 
     if (numberOfValues < originalNumberOfValues)
       {
+      this->PrepareForWrite();
       if (this->Internals->UserPortalValid)
         {
         throw dax::cont::ErrorControlBadValue(
@@ -231,6 +275,9 @@ public:
   ///
   DAX_CONT_EXPORT void ReleaseResourcesExecution()
   {
+    // The execution array may hold the only copy of values that other arrays
+    // are sharing, so they have to take their copy first.
+    this->DetachSharedCopies();
     if (this->Internals->ExecutionArrayValid)
       {
       this->Internals->ExecutionArray.ReleaseResources();
@@ -242,6 +289,8 @@ public:
   ///
   DAX_CONT_EXPORT void ReleaseResources()
   {
+    this->DetachSharedCopies();
+    this->Internals->SharedSource.reset();
     this->ReleaseResourcesExecution();
 
     // Forget about any user iterators.
@@ -263,7 +312,11 @@ public:
   DAX_CONT_EXPORT
   PortalConstExecution PrepareForInput() const
   {
-    if (this->Internals->ExecutionArrayValid)
+    if (this->Internals->SharedSource)
+      {
+      return ArrayHandle(this->Internals->SharedSource).PrepareForInput();
+      }
+    else if (this->Internals->ExecutionArrayValid)
       {
       // Nothing to do, data already loaded.
       }
@@ -298,6 +351,11 @@ public:
   DAX_CONT_EXPORT
   PortalExecution PrepareForOutput(dax::Id numberOfValues)
   {
+    // The old values are about to be overwritten, so arrays sharing them have
+    // to take a copy, but there is no need to copy them into this array.
+    this->DetachSharedCopies();
+    this->Internals->SharedSource.reset();
+
     // Invalidate any control arrays.
     // Should the control array resource be released? Probably not a good
     // idea when shared with execution.
@@ -330,6 +388,7 @@ public:
   DAX_CONT_EXPORT
   PortalExecution PrepareForInPlace()
   {
+    this->PrepareForWrite();
     if (this->Internals->UserPortalValid)
       {
       throw dax::cont::ErrorControlBadValue(
@@ -340,17 +399,19 @@ public:
 
     // This code is similar to PrepareForInput except that we have to give a
     // writable portal instead of the const portal to the execution array
-    // manager so that the data can (potentially) be written to.
-    if (this->Internals->ExecutionArrayValid)
-      {
-      // Nothing to do, data already loaded.
-      }
-    else if (this->Internals->ControlArrayValid)
+    // manager so that the data can (potentially) be written to. If the
+    // control array is still valid, the execution array may have been loaded
+    // for input only (and thus have no writable portal), so load it again.
+    if (this->Internals->ControlArrayValid)
       {
       this->Internals->ExecutionArray.LoadDataForInPlace(
             this->Internals->ControlArray.GetPortal());
       this->Internals->ExecutionArrayValid = true;
       }
+    else if (this->Internals->ExecutionArrayValid)
+      {
+      // Nothing to do, data already loaded.
+      }
     else
       {
       throw dax::cont::ErrorControlBadValue(
@@ -365,6 +426,50 @@ public:
     return this->Internals->ExecutionArray.GetPortalExecution();
   }
 
+  /// \brief Returns an independent array with the same values.
+  ///
+  /// Unlike copying the ArrayHandle, which gives another reference to the
+  /// same array, the returned array behaves like a copy made with the
+  /// device adapter's Copy. However, the values are not copied until either
+  /// this array or the returned array is modified, so copies that are only
+  /// read cost no memory. When one of them is modified, the values are first
+  /// copied into the control array of the one that still shares them.
+  ///
+  DAX_CONT_EXPORT
+  ArrayHandle CopyOnWrite() const
+  {
+    ArrayHandle copy;
+    boost::shared_ptr<InternalStruct> source = this->Internals->SharedSource;
+    if (!source)
+      {
+      if (   !this->Internals->UserPortalValid
+          && !this->Internals->ControlArrayValid
+          && !this->Internals->ExecutionArrayValid)
+        {
+        // Nothing to share.
+        return copy;
+        }
+      source = this->Internals;
+      }
+    copy.Internals->SharedSource = source;
+
+    // Forget copies that have since been destroyed so that the list does not
+    // keep growing.
+    std::vector<boost::weak_ptr<InternalStruct> > &sharedCopies =
+        source->SharedCopies;
+    std::size_t numberOfCopies = 0;
+    for (std::size_t index = 0; index < sharedCopies.size(); index++)
+      {
+      if (!sharedCopies[index].expired())
+        {
+        sharedCopies[numberOfCopies++] = sharedCopies[index];
+        }
+      }
+    sharedCopies.resize(numberOfCopies);
+    sharedCopies.push_back(copy.Internals);
+    return copy;
+  }
+
 protected:
   /// Special constructor for subclass specializations that need to set the
   /// initial state of the control and execution arrays.
@@ -382,7 +487,26 @@ protected:
     this->Internals->ExecutionArrayValid = executionArrayValid;
   }
 
+  /// Special constructor for subclass specializations that start with a
+  /// valid control array. Unlike the constructor above, it does not copy an
+  /// array transfer, which not every transfer supports.
+  ///
+  ArrayHandle(const ArrayContainerControlType &container)
+    : Internals(new InternalStruct)
+  {
+    this->Internals->UserPortalValid = false;
+    this->Internals->ControlArray = container;
+    this->Internals->ControlArrayValid = true;
+    this->Internals->ExecutionArrayValid = false;
+  }
+
 private:
+  struct InternalStruct;
+
+  DAX_CONT_EXPORT
+  ArrayHandle(const boost::shared_ptr<InternalStruct> &internals)
+    : Internals(internals) {  }
+
   struct InternalStruct {
     PortalConstControl UserPortal;
     bool UserPortalValid;
@@ -392,8 +516,94 @@ private:
 
     ArrayTransferType ExecutionArray;
     bool ExecutionArrayValid;
+
+    // Set for an array made by CopyOnWrite that still reads the values of
+    // another array. In this case none of the arrays above are valid.
+    boost::shared_ptr<InternalStruct> SharedSource;
+
+    // The arrays made by CopyOnWrite that may still read the values of this
+    // array.
+    std::vector<boost::weak_ptr<InternalStruct> > SharedCopies;
   };
 
+  /// Called before the values of this array are modified. Makes sure that
+  /// this array has its own copy of the values and that no other array is
+  /// still reading them.
+  ///
+  DAX_CONT_EXPORT void PrepareForWrite()
+  {
+    this->DetachSharedCopies();
+    if (this->Internals->SharedSource)
+      {
+      ArrayHandle source(this->Internals->SharedSource);
+      this->Internals->SharedSource.reset();
+      this->CopyValuesFrom(source);
+      }
+  }
+
+  /// Gives every array still sharing the values of this array its own copy
+  /// of them.
+  ///
+  DAX_CONT_EXPORT void DetachSharedCopies()
+  {
+    if (this->Internals->SharedCopies.empty()) { return; }
+
+    std::vector<boost::weak_ptr<InternalStruct> > sharedCopies;
+    sharedCopies.swap(this->Internals->SharedCopies);
+    for (typename std::vector<boost::weak_ptr<InternalStruct> >::iterator
+         iter = sharedCopies.begin();
+         iter != sharedCopies.end();
+         iter++)
+      {
+      boost::shared_ptr<InternalStruct> copyInternals = iter->lock();
+      // The copy may have been given new values since it was made.
+      if (copyInternals && (copyInternals->SharedSource == this->Internals))
+        {
+        copyInternals->SharedSource.reset();
+        ArrayHandle(copyInternals).CopyValuesFrom(*this);
+        }
+      }
+  }
+
+  /// Copies the values of \p source into the control array of this array.
+  ///
+  DAX_CONT_EXPORT void CopyValuesFrom(const ArrayHandle &source)
+  {
+    DAX_ASSERT_CONT(!this->Internals->SharedSource);
+    const dax::Id numberOfValues = source.GetNumberOfValues();
+    this->ReleaseResourcesExecution();
+    this->Internals->UserPortalValid = false;
+    this->Internals->ControlArray.Allocate(numberOfValues);
+    if (numberOfValues > 0)
+      {
+      CopyValuesInto(
+            source,
+            this->Internals->ControlArray,
+            typename detail::ArrayIteratorIsWritable<
+              typename PortalControl::IteratorType>::type());
+      }
+    this->Internals->ControlArrayValid = true;
+  }
+
+  DAX_CONT_EXPORT static void CopyValuesInto(
+      const ArrayHandle &source,
+      ArrayContainerControlType &controlArray,
+      boost::true_type)
+  {
+    PortalConstControl portal = source.GetPortalConstControl();
+    std::copy(portal.GetIteratorBegin(),
+              portal.GetIteratorEnd(),
+              controlArray.GetPortal().GetIteratorBegin());
+  }
+
+  DAX_CONT_EXPORT static void CopyValuesInto(const ArrayHandle &,
+                                             ArrayContainerControlType &,
+                                             boost::false_type)
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cannot copy values into a read-only ArrayHandle.");
+  }
+
   /// Synchronizes the control array with the execution array. If either the
   /// user array or control array is already valid, this method does nothing
   /// (because the data is already available in the control environment).
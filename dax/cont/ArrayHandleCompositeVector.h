@@ -0,0 +1,493 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleCompositeVector_h
+#define __dax_cont_ArrayHandleCompositeVector_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlInternal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+/// \brief An array portal that combines the values of NUM_COMPONENTS portals
+/// into tuples.
+///
+/// Component \c c of value \c i is value \c i of portal \c c.
+///
+template<class PortalT, int NUM_COMPONENTS>
+class ArrayPortalCompositeVector
+{
+public:
+  typedef PortalT ComponentPortalType;
+  typedef typename ComponentPortalType::ValueType ComponentType;
+  typedef dax::Tuple<ComponentType,NUM_COMPONENTS> ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompositeVector() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompositeVector(const ComponentPortalType *componentPortals)
+  {
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentPortals[component] = componentPortals[component];
+      }
+  }
+
+  /// Copy constructor for any other ArrayPortalCompositeVector with a
+  /// component portal type that can be copied to this type. This allows us
+  /// to do any type casting the portals do (like the non-const to const
+  /// cast).
+  ///
+  template<class OtherPortalT>
+  DAX_CONT_EXPORT
+  ArrayPortalCompositeVector(
+      const ArrayPortalCompositeVector<OtherPortalT,NUM_COMPONENTS> &src)
+  {
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentPortals[component] = src.GetComponentPortal(component);
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->ComponentPortals[0].GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    ValueType value;
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      value[component] = this->ComponentPortals[component].Get(index);
+      }
+    return value;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentPortals[component].Set(index, value[component]);
+      }
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalCompositeVector<ComponentPortalType,NUM_COMPONENTS> >
+      IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const ComponentPortalType &GetComponentPortal(int component) const {
+    return this->ComponentPortals[component];
+  }
+
+private:
+  ComponentPortalType ComponentPortals[NUM_COMPONENTS];
+};
+
+template<class ComponentArrayHandleType, int NUM_COMPONENTS>
+struct ArrayContainerControlTagCompositeVector { };
+
+/// An ArrayContainerControl that combines NUM_COMPONENTS arrays, each holding
+/// one component, into an array of tuples. The values stay in the component
+/// arrays.
+///
+template<class ComponentArrayHandleType, int NUM_COMPONENTS>
+class ArrayContainerControl<
+    dax::Tuple<typename ComponentArrayHandleType::ValueType,NUM_COMPONENTS>,
+    ArrayContainerControlTagCompositeVector<
+        ComponentArrayHandleType,NUM_COMPONENTS> >
+{
+public:
+  typedef dax::Tuple<typename ComponentArrayHandleType::ValueType,
+                     NUM_COMPONENTS> ValueType;
+
+  typedef ArrayPortalCompositeVector<
+      typename ComponentArrayHandleType::PortalControl,NUM_COMPONENTS>
+      PortalType;
+  typedef ArrayPortalCompositeVector<
+      typename ComponentArrayHandleType::PortalConstControl,NUM_COMPONENTS>
+      PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const ComponentArrayHandleType *componentArrays)
+    : Valid(true)
+  {
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component] = componentArrays[component];
+      DAX_ASSERT_CONT(this->ComponentArrays[component].GetNumberOfValues()
+                      == this->ComponentArrays[0].GetNumberOfValues());
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    DAX_ASSERT_CONT(this->Valid);
+    typename ComponentArrayHandleType::PortalControl portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] = this->ComponentArrays[component].GetPortalControl();
+      }
+    return PortalType(portals);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    DAX_ASSERT_CONT(this->Valid);
+    typename ComponentArrayHandleType::PortalConstControl
+        portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] =
+          this->ComponentArrays[component].GetPortalConstControl();
+      }
+    return PortalConstType(portals);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return this->ComponentArrays[0].GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlInternal(
+          "The allocate method for the composite vector control array "
+          "container should never have been called. The allocate is "
+          "generally only called by the execution array manager, and the "
+          "array transfer for the composite vector container should prevent "
+          "the execution array manager from being directly used.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->Valid);
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component].Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    DAX_ASSERT_CONT(this->Valid);
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component].ReleaseResources();
+      }
+  }
+
+private:
+  ComponentArrayHandleType ComponentArrays[NUM_COMPONENTS];
+  bool Valid;
+};
+
+template<typename T,
+         class ComponentArrayHandleType,
+         int NUM_COMPONENTS,
+         class DeviceAdapter>
+class ArrayTransfer<
+    T,
+    ArrayContainerControlTagCompositeVector<
+        ComponentArrayHandleType,NUM_COMPONENTS>,
+    DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+/// Moves a composite vector array to the execution environment by moving
+/// each component array, so the components are never interleaved into a
+/// separate array.
+///
+template<class ComponentArrayHandleType, int NUM_COMPONENTS, class DeviceAdapter>
+class ArrayTransfer<
+    dax::Tuple<typename ComponentArrayHandleType::ValueType,NUM_COMPONENTS>,
+    ArrayContainerControlTagCompositeVector<
+        ComponentArrayHandleType,NUM_COMPONENTS>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControl<
+      dax::Tuple<typename ComponentArrayHandleType::ValueType,NUM_COMPONENTS>,
+      ArrayContainerControlTagCompositeVector<
+          ComponentArrayHandleType,NUM_COMPONENTS> > ContainerType;
+
+public:
+  typedef typename ContainerType::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalCompositeVector<
+      typename ComponentArrayHandleType::PortalExecution,NUM_COMPONENTS>
+      PortalExecution;
+  typedef ArrayPortalCompositeVector<
+      typename ComponentArrayHandleType::PortalConstExecution,NUM_COMPONENTS>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer()
+    : ArraysValid(false),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayTransfer(const ComponentArrayHandleType *componentArrays)
+    : ArraysValid(true),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false)
+  {
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component] = componentArrays[component];
+      }
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    return this->ComponentArrays[0].GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl daxNotUsed(portal)) {
+    // Assumes the portal comes from a container combining the same arrays.
+    DAX_ASSERT_CONT(this->ArraysValid);
+    typename ComponentArrayHandleType::PortalConstExecution
+        portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] = this->ComponentArrays[component].PrepareForInput();
+      }
+    this->ExecutionPortalConst = PortalConstExecution(portals);
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl daxNotUsed(portal)) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    typename ComponentArrayHandleType::PortalExecution portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] =
+          this->ComponentArrays[component].PrepareForInPlace();
+      }
+    this->ExecutionPortal = PortalExecution(portals);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &daxNotUsed(controlArray),
+                              dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    typename ComponentArrayHandleType::PortalExecution portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] =
+          this->ComponentArrays[component].PrepareForOutput(numberOfValues);
+      }
+    this->ExecutionPortal = PortalExecution(portals);
+    this->ExecutionPortalValid = true;
+    this->ExecutionPortalConstValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData(ContainerType &daxNotUsed(controlArray)) const {
+    // The component array handles retrieve their own output data as
+    // necessary.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    typename ComponentArrayHandleType::PortalConstControl
+        portals[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      portals[component] =
+          this->ComponentArrays[component].GetPortalConstControl();
+      }
+    PortalConstControl portal(portals);
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component].Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      this->ComponentArrays[component].ReleaseResourcesExecution();
+      }
+    this->ExecutionPortalValid = false;
+    this->ExecutionPortalConstValid = false;
+  }
+
+private:
+  ComponentArrayHandleType ComponentArrays[NUM_COMPONENTS];
+  bool ArraysValid;
+  PortalConstExecution ExecutionPortalConst;
+  bool ExecutionPortalConstValid;
+  PortalExecution ExecutionPortal;
+  bool ExecutionPortalValid;
+};
+
+} // namespace internal
+
+/// \brief An ArrayHandle of tuples whose components are stored in separate
+/// arrays.
+///
+/// ArrayHandleCompositeVector presents NUM_COMPONENTS arrays of the same type,
+/// such as separate x, y and z coordinate arrays, as one array of
+/// dax::Tuple (a dax::Vector3 for three dax::Scalar arrays). Reading and
+/// writing the composite array reads and writes the component arrays, so the
+/// components never have to be interleaved into a new array. All component
+/// arrays must have the same length.
+///
+template<class ComponentArrayHandleType, int NUM_COMPONENTS>
+class ArrayHandleCompositeVector
+    : public ArrayHandle<
+        dax::Tuple<typename ComponentArrayHandleType::ValueType,NUM_COMPONENTS>,
+        dax::cont::internal::ArrayContainerControlTagCompositeVector<
+            ComponentArrayHandleType,NUM_COMPONENTS>,
+        typename ComponentArrayHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::Tuple<typename ComponentArrayHandleType::ValueType,
+                     NUM_COMPONENTS> ValueType;
+  typedef dax::cont::internal::ArrayContainerControlTagCompositeVector<
+      ComponentArrayHandleType,NUM_COMPONENTS> ArrayContainerControlTag;
+  typedef typename ComponentArrayHandleType::DeviceAdapterTag DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> Superclass;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControl<
+      ValueType, ArrayContainerControlTag> ArrayContainerControlType;
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleCompositeVector() {  }
+
+  /// Creates the composite array from an array of NUM_COMPONENTS component
+  /// arrays.
+  ///
+  ArrayHandleCompositeVector(const ComponentArrayHandleType *componentArrays)
+    : Superclass(ArrayContainerControlType(componentArrays),
+                 true,
+                 ArrayTransferType(componentArrays),
+                 false)
+  {  }
+};
+
+/// Convenience functions to create an ArrayHandleCompositeVector from two,
+/// three or four component arrays.
+///
+template<class ComponentArrayHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,2>
+make_ArrayHandleCompositeVector(const ComponentArrayHandleType &component0,
+                                const ComponentArrayHandleType &component1)
+{
+  ComponentArrayHandleType components[2] = { component0, component1 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,2>(
+        components);
+}
+template<class ComponentArrayHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,3>
+make_ArrayHandleCompositeVector(const ComponentArrayHandleType &component0,
+                                const ComponentArrayHandleType &component1,
+                                const ComponentArrayHandleType &component2)
+{
+  ComponentArrayHandleType components[3] =
+    { component0, component1, component2 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,3>(
+        components);
+}
+template<class ComponentArrayHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,4>
+make_ArrayHandleCompositeVector(const ComponentArrayHandleType &component0,
+                                const ComponentArrayHandleType &component1,
+                                const ComponentArrayHandleType &component2,
+                                const ComponentArrayHandleType &component3)
+{
+  ComponentArrayHandleType components[4] =
+    { component0, component1, component2, component3 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentArrayHandleType,4>(
+        components);
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayHandleCompositeVector_h
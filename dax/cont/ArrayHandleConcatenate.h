@@ -0,0 +1,446 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleConcatenate_h
+#define __dax_cont_ArrayHandleConcatenate_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlInternal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+/// \brief An array portal that presents the values of one portal followed by
+/// the values of another.
+///
+template<class P1, class P2>
+class ArrayPortalConcatenate
+{
+public:
+  typedef P1 FirstPortalType;
+  typedef P2 SecondPortalType;
+  typedef typename FirstPortalType::ValueType ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalConcatenate() : FirstPortal(), SecondPortal() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalConcatenate(const FirstPortalType &firstPortal,
+                         const SecondPortalType &secondPortal)
+    : FirstPortal(firstPortal), SecondPortal(secondPortal) {  }
+
+  /// Copy constructor for any other ArrayPortalConcatenate with portal types
+  /// that can be copied to these portal types. This allows us to do any type
+  /// casting that the portals do (like the non-const to const cast).
+  ///
+  template<class OtherP1, class OtherP2>
+  DAX_CONT_EXPORT
+  ArrayPortalConcatenate(const ArrayPortalConcatenate<OtherP1,OtherP2> &src)
+    : FirstPortal(src.GetFirstPortal()),
+      SecondPortal(src.GetSecondPortal())
+  {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->FirstPortal.GetNumberOfValues()
+        + this->SecondPortal.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    const dax::Id firstSize = this->FirstPortal.GetNumberOfValues();
+    if (index < firstSize)
+      {
+      return this->FirstPortal.Get(index);
+      }
+    else
+      {
+      return this->SecondPortal.Get(index - firstSize);
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    const dax::Id firstSize = this->FirstPortal.GetNumberOfValues();
+    if (index < firstSize)
+      {
+      this->FirstPortal.Set(index, value);
+      }
+    else
+      {
+      this->SecondPortal.Set(index - firstSize, value);
+      }
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConcatenate<FirstPortalType,SecondPortalType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const FirstPortalType &GetFirstPortal() const { return this->FirstPortal; }
+  DAX_EXEC_CONT_EXPORT
+  const SecondPortalType &GetSecondPortal() const { return this->SecondPortal; }
+
+private:
+  FirstPortalType FirstPortal;
+  SecondPortalType SecondPortal;
+};
+
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+struct ArrayContainerControlTagConcatenate { };
+
+/// An ArrayContainerControl that presents two arrays as one. The values stay
+/// in the two arrays.
+///
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+class ArrayContainerControl<
+    typename FirstArrayHandleType::ValueType,
+    ArrayContainerControlTagConcatenate<
+        FirstArrayHandleType,SecondArrayHandleType> >
+{
+public:
+  typedef typename FirstArrayHandleType::ValueType ValueType;
+
+  typedef ArrayPortalConcatenate<
+      typename FirstArrayHandleType::PortalControl,
+      typename SecondArrayHandleType::PortalControl> PortalType;
+  typedef ArrayPortalConcatenate<
+      typename FirstArrayHandleType::PortalConstControl,
+      typename SecondArrayHandleType::PortalConstControl> PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const FirstArrayHandleType &firstArray,
+                        const SecondArrayHandleType &secondArray)
+    : FirstArray(firstArray), SecondArray(secondArray), Valid(true) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalType(this->FirstArray.GetPortalControl(),
+                      this->SecondArray.GetPortalControl());
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->FirstArray.GetPortalConstControl(),
+                           this->SecondArray.GetPortalConstControl());
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return this->FirstArray.GetNumberOfValues()
+        + this->SecondArray.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlInternal(
+          "The allocate method for the concatenate control array container "
+          "should never have been called. The allocate is generally only "
+          "called by the execution array manager, and the array transfer for "
+          "the concatenate container should prevent the execution array "
+          "manager from being directly used.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->Valid);
+    ShrinkArrays(this->FirstArray, this->SecondArray, numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    DAX_ASSERT_CONT(this->Valid);
+    this->FirstArray.ReleaseResources();
+    this->SecondArray.ReleaseResources();
+  }
+
+  /// Shrinks the second array first and only shrinks the first array once
+  /// the second is empty.
+  ///
+  DAX_CONT_EXPORT
+  static void ShrinkArrays(FirstArrayHandleType &firstArray,
+                           SecondArrayHandleType &secondArray,
+                           dax::Id numberOfValues)
+  {
+    const dax::Id firstSize = firstArray.GetNumberOfValues();
+    if (numberOfValues < firstSize)
+      {
+      firstArray.Shrink(numberOfValues);
+      secondArray.Shrink(0);
+      }
+    else
+      {
+      secondArray.Shrink(numberOfValues - firstSize);
+      }
+  }
+
+private:
+  FirstArrayHandleType FirstArray;
+  SecondArrayHandleType SecondArray;
+  bool Valid;
+};
+
+template<typename T,
+         class FirstArrayHandleType,
+         class SecondArrayHandleType,
+         class DeviceAdapter>
+class ArrayTransfer<
+    T,
+    ArrayContainerControlTagConcatenate<
+        FirstArrayHandleType,SecondArrayHandleType>,
+    DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+/// Moves a concatenated array to the execution environment by moving each of
+/// the two arrays, so their values are never copied into one array.
+///
+template<class FirstArrayHandleType,
+         class SecondArrayHandleType,
+         class DeviceAdapter>
+class ArrayTransfer<
+    typename FirstArrayHandleType::ValueType,
+    ArrayContainerControlTagConcatenate<
+        FirstArrayHandleType,SecondArrayHandleType>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControl<
+      typename FirstArrayHandleType::ValueType,
+      ArrayContainerControlTagConcatenate<
+          FirstArrayHandleType,SecondArrayHandleType> > ContainerType;
+
+public:
+  typedef typename FirstArrayHandleType::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalConcatenate<
+      typename FirstArrayHandleType::PortalExecution,
+      typename SecondArrayHandleType::PortalExecution> PortalExecution;
+  typedef ArrayPortalConcatenate<
+      typename FirstArrayHandleType::PortalConstExecution,
+      typename SecondArrayHandleType::PortalConstExecution>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer()
+    : ArraysValid(false),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayTransfer(const FirstArrayHandleType &firstArray,
+                const SecondArrayHandleType &secondArray)
+    : FirstArray(firstArray),
+      SecondArray(secondArray),
+      ArraysValid(true),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    return this->FirstArray.GetNumberOfValues()
+        + this->SecondArray.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl daxNotUsed(portal)) {
+    // Assumes the portal comes from a container joining the same arrays.
+    DAX_ASSERT_CONT(this->ArraysValid);
+    this->ExecutionPortalConst =
+        PortalConstExecution(this->FirstArray.PrepareForInput(),
+                             this->SecondArray.PrepareForInput());
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl daxNotUsed(portal)) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    this->ExecutionPortal =
+        PortalExecution(this->FirstArray.PrepareForInPlace(),
+                        this->SecondArray.PrepareForInPlace());
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  /// The first array keeps its length (or is shrunk if fewer values are
+  /// requested) and the second array is allocated for the rest of the
+  /// values.
+  ///
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &daxNotUsed(controlArray),
+                              dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    const dax::Id firstSize =
+        std::min(this->FirstArray.GetNumberOfValues(), numberOfValues);
+    this->ExecutionPortal =
+        PortalExecution(
+          this->FirstArray.PrepareForOutput(firstSize),
+          this->SecondArray.PrepareForOutput(numberOfValues - firstSize));
+    this->ExecutionPortalValid = true;
+    this->ExecutionPortalConstValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData(ContainerType &daxNotUsed(controlArray)) const {
+    // The two array handles retrieve their own output data as necessary.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    PortalConstControl portal(this->FirstArray.GetPortalConstControl(),
+                              this->SecondArray.GetPortalConstControl());
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    ContainerType::ShrinkArrays(this->FirstArray,
+                                this->SecondArray,
+                                numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    this->FirstArray.ReleaseResourcesExecution();
+    this->SecondArray.ReleaseResourcesExecution();
+    this->ExecutionPortalValid = false;
+    this->ExecutionPortalConstValid = false;
+  }
+
+private:
+  FirstArrayHandleType FirstArray;
+  SecondArrayHandleType SecondArray;
+  bool ArraysValid;
+  PortalConstExecution ExecutionPortalConst;
+  bool ExecutionPortalConstValid;
+  PortalExecution ExecutionPortal;
+  bool ExecutionPortalValid;
+};
+
+} // namespace internal
+
+/// \brief An ArrayHandle that presents two arrays as one contiguous array.
+///
+/// The values of ArrayHandleConcatenate are the values of the first array
+/// followed by the values of the second. Both arrays must hold the same value
+/// type. Reading and writing go to the two arrays directly, so chunks that
+/// arrive separately (for example from different ranks) can be processed
+/// together without first copying them into one array. When used as an
+/// output, the first array keeps its length and the second array gets the
+/// remaining values.
+///
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+class ArrayHandleConcatenate
+    : public ArrayHandle<
+        typename FirstArrayHandleType::ValueType,
+        dax::cont::internal::ArrayContainerControlTagConcatenate<
+            FirstArrayHandleType,SecondArrayHandleType>,
+        typename FirstArrayHandleType::DeviceAdapterTag>
+{
+public:
+  typedef typename FirstArrayHandleType::ValueType ValueType;
+  typedef dax::cont::internal::ArrayContainerControlTagConcatenate<
+      FirstArrayHandleType,SecondArrayHandleType> ArrayContainerControlTag;
+  typedef typename FirstArrayHandleType::DeviceAdapterTag DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> Superclass;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControl<
+      ValueType, ArrayContainerControlTag> ArrayContainerControlType;
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleConcatenate() {  }
+
+  ArrayHandleConcatenate(const FirstArrayHandleType &firstArray,
+                         const SecondArrayHandleType &secondArray)
+    : Superclass(ArrayContainerControlType(firstArray, secondArray),
+                 true,
+                 ArrayTransferType(firstArray, secondArray),
+                 false)
+  {  }
+};
+
+/// A convenience function for creating an ArrayHandleConcatenate of the two
+/// given arrays.
+///
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleConcatenate<FirstArrayHandleType,SecondArrayHandleType>
+make_ArrayHandleConcatenate(const FirstArrayHandleType &firstArray,
+                            const SecondArrayHandleType &secondArray)
+{
+  return dax::cont::ArrayHandleConcatenate<
+      FirstArrayHandleType,SecondArrayHandleType>(firstArray, secondArray);
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayHandleConcatenate_h
@@ -0,0 +1,344 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleTransform_h
+#define __dax_cont_ArrayHandleTransform_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+/// \brief An array portal that applies a functor to the values of another
+/// portal when they are read.
+///
+template<typename ValueT, class PortalT, class FunctorT>
+class ArrayPortalTransform
+{
+public:
+  typedef ValueT ValueType;
+  typedef PortalT DelegatePortalType;
+  typedef FunctorT FunctorType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalTransform() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalTransform(const DelegatePortalType &delegatePortal,
+                       const FunctorType &functor)
+    : DelegatePortal(delegatePortal), Functor(functor) {  }
+
+  /// Copy constructor for any other ArrayPortalTransform with a delegate type
+  /// that can be copied to this type. This allows us to do any type casting
+  /// the delegates can do (like the non-const to const cast).
+  ///
+  template<class OtherPortalT>
+  DAX_CONT_EXPORT
+  ArrayPortalTransform(
+      const ArrayPortalTransform<ValueType,OtherPortalT,FunctorType> &src)
+    : DelegatePortal(src.GetDelegatePortal()), Functor(src.GetFunctor()) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->DelegatePortal.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->Functor(this->DelegatePortal.Get(index));
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalTransform<ValueType,DelegatePortalType,FunctorType> >
+      IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const DelegatePortalType &GetDelegatePortal() const {
+    return this->DelegatePortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const FunctorType &GetFunctor() const { return this->Functor; }
+
+private:
+  DelegatePortalType DelegatePortal;
+  FunctorType Functor;
+};
+
+template<typename ValueType, class ArrayHandleType, class FunctorType>
+struct ArrayContainerControlTagTransform { };
+
+/// A read-only ArrayContainerControl that computes its values from another
+/// ArrayHandle. It holds no memory of its own.
+///
+template<typename T, class ArrayHandleType, class FunctorType>
+class ArrayContainerControl<
+    T, ArrayContainerControlTagTransform<T, ArrayHandleType, FunctorType> >
+{
+public:
+  typedef T ValueType;
+
+  typedef ArrayPortalTransform<
+      ValueType, typename ArrayHandleType::PortalConstControl, FunctorType>
+      PortalConstType;
+
+  // This is meant to be invalid. Because transformed arrays are read only,
+  // you should only be able to use the const version.
+  struct PortalType {
+    typedef void *ValueType;
+    typedef void *IteratorType;
+  };
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const ArrayHandleType &delegateArray,
+                        const FunctorType &functor)
+    : DelegateArray(delegateArray), Functor(functor), Valid(true) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    throw dax::cont::ErrorControlBadValue("Transformed arrays are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->DelegateArray.GetPortalConstControl(),
+                           this->Functor);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return this->DelegateArray.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue("Transformed arrays are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue("Transformed arrays are read-only.");
+  }
+
+  // We don't own the memory, the delegate array does, so don't deallocate
+  // underneath of it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() {  }
+
+private:
+  ArrayHandleType DelegateArray;
+  FunctorType Functor;
+  bool Valid;
+};
+
+/// Moves a transformed array to the execution environment by preparing the
+/// delegate array for input. The functor is applied as the values are read,
+/// so no array of transformed values is ever allocated.
+///
+template<typename T,
+         class ArrayHandleType,
+         class FunctorType,
+         class DeviceAdapterTag>
+class ArrayTransfer<
+    T,
+    ArrayContainerControlTagTransform<T, ArrayHandleType, FunctorType>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControl<
+      T, ArrayContainerControlTagTransform<T, ArrayHandleType, FunctorType> >
+      ContainerType;
+
+public:
+  typedef T ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef PortalControl PortalExecution;
+  typedef ArrayPortalTransform<
+      ValueType, typename ArrayHandleType::PortalConstExecution, FunctorType>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() : PortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayTransfer(const ArrayHandleType &delegateArray,
+                const FunctorType &functor)
+    : DelegateArray(delegateArray), Functor(functor), PortalValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    return this->DelegateArray.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl daxNotUsed(portal))
+  {
+    // Assumes the portal comes from a container transforming the same array.
+    this->Portal = PortalConstExecution(this->DelegateArray.PrepareForInput(),
+                                        this->Functor);
+    this->PortalValid = true;
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(PortalControl daxNotUsed(portal))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output or in place.");
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(
+      ContainerType &daxNotUsed(controlArray),
+      dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output.");
+  }
+
+  DAX_CONT_EXPORT void RetrieveOutputData(
+      ContainerType &daxNotUsed(controlArray)) const
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output.");
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    PortalConstControl portal(this->DelegateArray.GetPortalConstControl(),
+                              this->Functor);
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be resized.");
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Transformed arrays are read-only.  (Get the const portal.)");
+  }
+
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->PortalValid);
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources() { this->PortalValid = false; }
+
+private:
+  ArrayHandleType DelegateArray;
+  FunctorType Functor;
+  PortalConstExecution Portal;
+  bool PortalValid;
+};
+
+} // namespace internal
+
+/// \brief A read-only ArrayHandle whose values are computed from another
+/// ArrayHandle on the fly.
+///
+/// Each value of an ArrayHandleTransform is the result of calling \c
+/// FunctorType on the corresponding value of the delegate array. The functor
+/// is called whenever a value is read, in the control or the execution
+/// environment, so its operator() has to be declared DAX_EXEC_CONT_EXPORT and
+/// return something convertible to \c ValueType. This makes cheap derived
+/// fields (a magnitude, a component, a unit conversion) usable as worklet
+/// inputs without allocating or filling an array for them.
+///
+template <typename ValueType_,
+          class ArrayHandleType,
+          class FunctorType,
+          class DeviceAdapterTag_ = typename ArrayHandleType::DeviceAdapterTag>
+class ArrayHandleTransform
+    : public ArrayHandle<
+        ValueType_,
+        dax::cont::internal::ArrayContainerControlTagTransform<
+            ValueType_, ArrayHandleType, FunctorType>,
+        DeviceAdapterTag_>
+{
+public:
+  typedef ValueType_ ValueType;
+  typedef dax::cont::internal::ArrayContainerControlTagTransform<
+      ValueType, ArrayHandleType, FunctorType> ArrayContainerControlTag;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> Superclass;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControl<
+      ValueType, ArrayContainerControlTag> ArrayContainerControlType;
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleTransform() {  }
+
+  ArrayHandleTransform(const ArrayHandleType &delegateArray,
+                       const FunctorType &functor = FunctorType())
+    : Superclass(ArrayContainerControlType(delegateArray, functor),
+                 true,
+                 ArrayTransferType(delegateArray, functor),
+                 false)
+  {  }
+};
+
+/// make_ArrayHandleTransform is a convenience function to generate an
+/// ArrayHandleTransform. The value type of the transformed array has to be
+/// given as a template argument, for example
+/// <tt>make_ArrayHandleTransform<dax::Scalar>(coordinates, Magnitude())</tt>.
+///
+template <typename ValueType, class ArrayHandleType, class FunctorType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleTransform<ValueType, ArrayHandleType, FunctorType>
+make_ArrayHandleTransform(const ArrayHandleType &array,
+                          const FunctorType &functor)
+{
+  return dax::cont::ArrayHandleTransform<
+      ValueType, ArrayHandleType, FunctorType>(array, functor);
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayHandleTransform_h
@@ -0,0 +1,107 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleView_h
+#define __dax_cont_ArrayHandleView_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/ArrayContainerControlView.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief A view of a contiguous range of the values of another ArrayHandle.
+///
+/// ArrayHandleView refers to the values in <tt>[offset, offset+length)</tt>
+/// of a delegate array without copying them, in both the control and the
+/// execution environments. Writing to the view (including using it as the
+/// output of an algorithm) writes into the delegate array. The view cannot
+/// be grown past its original length.
+///
+template <typename ArrayHandleType,
+          class DeviceAdapterTag_ = typename ArrayHandleType::DeviceAdapterTag>
+class ArrayHandleView
+    : public ArrayHandle<
+        typename ArrayHandleType::ValueType,
+        dax::cont::internal::ArrayContainerControlTagView<ArrayHandleType>,
+        DeviceAdapterTag_>
+{
+public:
+  typedef typename ArrayHandleType::ValueType ValueType;
+  typedef dax::cont::internal::ArrayContainerControlTagView<ArrayHandleType>
+      ArrayContainerControlTag;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> Superclass;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControl<
+      ValueType, ArrayContainerControlTag> ArrayContainerControlType;
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleView() {  }
+
+  ArrayHandleView(const ArrayHandleType &delegateArray,
+                  dax::Id offset,
+                  dax::Id length)
+    : Superclass(ArrayContainerControlType(delegateArray,
+                                           CheckOffset(delegateArray,
+                                                       offset,
+                                                       length),
+                                           length),
+                 true,
+                 ArrayTransferType(delegateArray, offset, length),
+                 false)
+  {  }
+
+private:
+  static dax::Id CheckOffset(const ArrayHandleType &delegateArray,
+                             dax::Id offset,
+                             dax::Id length)
+  {
+    if ((offset < 0) || (length < 0)
+        || (offset + length > delegateArray.GetNumberOfValues()))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Array view extends past the end of the array.");
+      }
+    return offset;
+  }
+};
+
+/// make_ArrayHandleView is a convenience function to generate an
+/// ArrayHandleView of the \p length values of \p array starting at index \p
+/// offset.
+///
+template <typename ArrayHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleView<ArrayHandleType>
+make_ArrayHandleView(const ArrayHandleType &array,
+                     dax::Id offset,
+                     dax::Id length)
+{
+  return dax::cont::ArrayHandleView<ArrayHandleType>(array, offset, length);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleView_h
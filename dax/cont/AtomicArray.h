@@ -0,0 +1,99 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_AtomicArray_h
+#define __dax_cont_AtomicArray_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/arg/ExecutionObject.h>
+
+#include <dax/exec/AtomicArray.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Gives worklets atomic access to an ArrayHandle.
+///
+/// Wraps an ArrayHandle of dax::Id or dax::Scalar values so that worklets
+/// can update any of its values with atomic Add, CompareAndSwap, Min and Max
+/// operations (see dax::exec::AtomicArray). Pass the object returned by
+/// PrepareForExecution to the worklet as an \c ExecObject:
+///
+/// \code{.cpp}
+/// dax::cont::AtomicArray<dax::Id> counts(countsHandle);
+/// scheduler.Invoke(CountWorklet(), input, counts.PrepareForExecution());
+/// \endcode
+///
+/// The values are updated in place, so the array has to be filled (for
+/// example with zeros) beforehand. Atomics need the execution array in
+/// memory shared by all threads, so this works with the serial, OpenMP and
+/// TBB device adapters.
+///
+template<typename T, class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class AtomicArray
+{
+public:
+  typedef T ValueType;
+  typedef dax::cont::ArrayHandle<
+      ValueType, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      ArrayHandleType;
+  typedef dax::exec::AtomicArray<ValueType, DeviceAdapterTag> ExecutionType;
+
+  DAX_CONT_EXPORT
+  AtomicArray(const ArrayHandleType &handle) : Handle(handle) {  }
+
+  /// Creates an array of \p numberOfValues values set to \p initialValue.
+  ///
+  DAX_CONT_EXPORT
+  AtomicArray(dax::Id numberOfValues, const ValueType &initialValue)
+  {
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+          dax::cont::make_ArrayHandleConstant(initialValue,
+                                              numberOfValues,
+                                              DeviceAdapterTag()),
+          this->Handle);
+  }
+
+  DAX_CONT_EXPORT
+  const ArrayHandleType &GetHandle() const { return this->Handle; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->Handle.GetNumberOfValues(); }
+
+  /// Moves the array to the execution environment for in place updates and
+  /// returns an object that can be passed to a worklet as an \c ExecObject.
+  ///
+  DAX_CONT_EXPORT
+  ExecutionType PrepareForExecution()
+  {
+    typename ArrayHandleType::PortalExecution portal =
+        this->Handle.PrepareForInPlace();
+    return ExecutionType(&*portal.GetIteratorBegin(),
+                         portal.GetNumberOfValues());
+  }
+
+private:
+  ArrayHandleType Handle;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_AtomicArray_h
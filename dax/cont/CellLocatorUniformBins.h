@@ -0,0 +1,257 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_CellLocatorUniformBins_h
+#define __dax_cont_CellLocatorUniformBins_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/ExecutionObject.h>
+
+#include <dax/exec/CellLocatorUniformBins.h>
+#include <dax/exec/internal/kernel/CellLocatorWorklets.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Spatial index for finding the cell that contains a point.
+///
+/// CellLocatorUniformBins overlays an axis-aligned grid of bins on a region of
+/// space and records, for each bin, the cells of \c GridType whose bounding
+/// boxes overlap it. The index is built in parallel on the device the first
+/// time it is needed (or when Build is called) and is passed to worklets as an
+/// \c ExecObject through PrepareForInput. See dax::worklet::ProbeLocate for an
+/// example of its use.
+///
+/// Only cells overlapping the binned region are indexed, so when resampling
+/// onto a uniform grid the bins are typically chosen to cover that grid.
+///
+template<class GridType,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class CellLocatorUniformBins
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandleType;
+
+  typedef typename GridType::TopologyStructConstExecution TopologyType;
+  typedef typename GridType::PointCoordinatesType::PortalConstExecution
+      CoordinatesPortalType;
+
+  typedef dax::exec::CellLocatorUniformBins<
+      TopologyType,
+      CoordinatesPortalType,
+      typename IdArrayHandleType::PortalConstExecution> ExecutionType;
+
+  /// The execution object type returned from PrepareFieldForInput.
+  ///
+  template<typename T, class Container>
+  struct PointFieldExecution
+  {
+    typedef dax::exec::PointFieldInterpolator<
+        TopologyType,
+        typename dax::cont::ArrayHandle<T,Container,DeviceAdapterTag>
+            ::PortalConstExecution> type;
+  };
+
+  /// Creates a locator for \p grid with \p numberOfBins bins along each axis
+  /// spanning the box from \p minCorner to \p maxCorner.
+  ///
+  DAX_CONT_EXPORT
+  CellLocatorUniformBins(const GridType &grid,
+                         const dax::Vector3 &minCorner,
+                         const dax::Vector3 &maxCorner,
+                         const dax::Id3 &numberOfBins)
+    : Grid(grid),
+      BinOffsets(),
+      BinCellIds(),
+      LocatorValid(false)
+  {
+    this->SetBins(minCorner, maxCorner, numberOfBins);
+  }
+
+  /// Creates a locator for \p grid whose bins cover the bounds of the given
+  /// uniform grid, which is usually the target of a resample.
+  ///
+  DAX_CONT_EXPORT
+  CellLocatorUniformBins(const GridType &grid,
+                         const dax::cont::UniformGrid<DeviceAdapterTag> &region,
+                         const dax::Id3 &numberOfBins)
+    : Grid(grid),
+      BinOffsets(),
+      BinCellIds(),
+      LocatorValid(false)
+  {
+    const dax::Extent3 &extent = region.GetExtent();
+    this->SetBins(region.ComputePointCoordinates(extent.Min),
+                  region.ComputePointCoordinates(extent.Max),
+                  numberOfBins);
+  }
+
+  DAX_CONT_EXPORT
+  const GridType &GetGrid() const { return this->Grid; }
+
+  DAX_CONT_EXPORT
+  const dax::exec::internal::UniformBinning &GetBins() const
+  {
+    return this->Bins;
+  }
+
+  /// Builds the bin structure. Does nothing if it is already built.
+  ///
+  DAX_CONT_EXPORT
+  void Build()
+  {
+    if (this->LocatorValid) { return; } // Nothing to do.
+
+    const dax::Id numCells = this->Grid.GetNumberOfCells();
+    TopologyType topology = this->Grid.PrepareForInput();
+    CoordinatesPortalType coordinates =
+        this->Grid.GetPointCoordinates().PrepareForInput();
+
+    // Count how many bins each cell overlaps and find where each cell's list
+    // of bins starts.
+    IdArrayHandleType binCounts;
+    typedef dax::exec::internal::kernel::CellLocatorCountBins<
+        TopologyType,
+        CoordinatesPortalType,
+        typename IdArrayHandleType::PortalExecution> CountKernelType;
+    Algorithm::Schedule(CountKernelType(topology,
+                                        coordinates,
+                                        this->Bins,
+                                        binCounts.PrepareForOutput(numCells)),
+                        numCells);
+
+    IdArrayHandleType cellOffsets;
+    const dax::Id numEntries = Algorithm::ScanExclusive(binCounts, cellOffsets);
+    binCounts.ReleaseResources();
+
+    // Write a (bin, cell) pair for every overlap and then group the pairs by
+    // bin.
+    IdArrayHandleType binIds;
+    typedef dax::exec::internal::kernel::CellLocatorFillBins<
+        TopologyType,
+        CoordinatesPortalType,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution> FillKernelType;
+    Algorithm::Schedule(
+          FillKernelType(topology,
+                         coordinates,
+                         this->Bins,
+                         cellOffsets.PrepareForInput(),
+                         binIds.PrepareForOutput(numEntries),
+                         this->BinCellIds.PrepareForOutput(numEntries)),
+          numCells);
+    cellOffsets.ReleaseResources();
+
+    Algorithm::SortByKey(binIds, this->BinCellIds);
+
+    // There is one more offset than bins so that the last bin knows where it
+    // ends.
+    Algorithm::LowerBounds(
+          binIds,
+          dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                              this->Bins.GetNumberOfBins()+1,
+                                              DeviceAdapterTag()),
+          this->BinOffsets);
+
+    this->LocatorValid = true;
+  }
+
+  /// Builds the locator (if necessary) and returns an object that can be
+  /// passed to a worklet as an \c ExecObject.
+  ///
+  DAX_CONT_EXPORT
+  ExecutionType PrepareForInput()
+  {
+    this->Build();
+    return ExecutionType(this->Grid.PrepareForInput(),
+                         this->Grid.GetPointCoordinates().PrepareForInput(),
+                         this->Bins,
+                         this->BinOffsets.PrepareForInput(),
+                         this->BinCellIds.PrepareForInput());
+  }
+
+  /// Returns an object that can be passed to a worklet as an \c ExecObject to
+  /// interpolate the point field \p field of the located grid at a cell and
+  /// parametric coordinates returned from the locator.
+  ///
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  typename PointFieldExecution<T,Container>::type
+  PrepareFieldForInput(
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field) const
+  {
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == this->Grid.GetNumberOfPoints());
+    return typename PointFieldExecution<T,Container>::type(
+          this->Grid.PrepareForInput(), field.PrepareForInput());
+  }
+
+  /// The offset of each bin's entries in the bin cell id array. There is an
+  /// extra entry at the end giving the total number of entries.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayHandleType GetBinOffsets()
+  {
+    this->Build();
+    return this->BinOffsets;
+  }
+
+  /// The concatenated lists of cells overlapping each bin.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayHandleType GetBinCellIds()
+  {
+    this->Build();
+    return this->BinCellIds;
+  }
+
+private:
+  DAX_CONT_EXPORT
+  void SetBins(const dax::Vector3 &minCorner,
+               const dax::Vector3 &maxCorner,
+               const dax::Id3 &numberOfBins)
+  {
+    this->Bins.Origin = minCorner;
+    this->Bins.NumberOfBins = numberOfBins;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      DAX_ASSERT_CONT(numberOfBins[dimension] > 0);
+      const dax::Scalar width = maxCorner[dimension] - minCorner[dimension];
+      // A flat region gets a single layer of bins that everything falls in.
+      this->Bins.InverseBinSize[dimension] =
+          (width > 0) ? numberOfBins[dimension]/width : dax::Scalar(0);
+      }
+  }
+
+  GridType Grid;
+  dax::exec::internal::UniformBinning Bins;
+  IdArrayHandleType BinOffsets;
+  IdArrayHandleType BinCellIds;
+  bool LocatorValid;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_CellLocatorUniformBins_h
@@ -0,0 +1,261 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_FieldStatistics_h
+#define __dax_cont_FieldStatistics_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/exec/internal/kernel/FieldStatisticsWorklets.h>
+
+#include <math.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Computes the range, moments and histogram of a scalar field.
+///
+/// Run finds the minimum, maximum, mean, variance and skewness of a field in
+/// a single pass over its values. The field is split into at most
+/// MaximumNumberOfBlocks contiguous blocks, each block is reduced by one
+/// instance of a scheduled kernel, and the few per block results are merged
+/// in the control environment.
+///
+/// RunHistogram counts the values in evenly spaced bins the same way: every
+/// block counts into its own private copy of the bins, so there are no
+/// atomic operations or write conflicts, and the copies are added together
+/// at the end. The memory for the private bins is MaximumNumberOfBlocks times
+/// the number of bins.
+///
+/// The variance and skewness are the population (not sample) statistics.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class FieldStatistics
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef dax::exec::internal::kernel::FieldStatisticsPartial PartialType;
+  typedef dax::cont::ArrayHandle<PartialType,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> PartialArrayHandleType;
+
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandleType;
+
+  DAX_CONT_EXPORT
+  FieldStatistics()
+    : MaximumNumberOfBlocks(256), MinimumBlockSize(4096)
+  {
+    this->Statistics.Count = 0;
+    this->Statistics.Minimum = 0;
+    this->Statistics.Maximum = 0;
+    this->Statistics.Mean = 0;
+    this->Statistics.M2 = 0;
+    this->Statistics.M3 = 0;
+  }
+
+  /// The largest number of blocks a field is split into. It should be a few
+  /// times the number of threads of the device so that the load balances.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetMaximumNumberOfBlocks() const
+  {
+    return this->MaximumNumberOfBlocks;
+  }
+  DAX_CONT_EXPORT
+  void SetMaximumNumberOfBlocks(dax::Id numberOfBlocks)
+  {
+    DAX_ASSERT_CONT(numberOfBlocks > 0);
+    this->MaximumNumberOfBlocks = numberOfBlocks;
+  }
+
+  /// Fields are not split into blocks smaller than this.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetMinimumBlockSize() const { return this->MinimumBlockSize; }
+  DAX_CONT_EXPORT
+  void SetMinimumBlockSize(dax::Id blockSize)
+  {
+    DAX_ASSERT_CONT(blockSize > 0);
+    this->MinimumBlockSize = blockSize;
+  }
+
+  /// Computes the statistics of \p field, which can be any array handle of
+  /// values convertible to double.
+  ///
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void Run(const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field)
+  {
+    const dax::Id numValues = field.GetNumberOfValues();
+    PartialType statistics;
+    statistics.Count = 0;
+    statistics.Minimum = statistics.Maximum = 0;
+    statistics.Mean = statistics.M2 = statistics.M3 = 0;
+
+    if (numValues > 0)
+      {
+      const dax::Id blockSize = this->GetBlockSize(numValues);
+      const dax::Id numBlocks = (numValues + blockSize - 1)/blockSize;
+
+      typedef dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> FieldType;
+      typedef dax::exec::internal::kernel::FieldStatisticsBlocks<
+          typename FieldType::PortalConstExecution,
+          typename PartialArrayHandleType::PortalExecution> KernelType;
+      PartialArrayHandleType partials;
+      Algorithm::Schedule(KernelType(field.PrepareForInput(),
+                                     numValues,
+                                     blockSize,
+                                     partials.PrepareForOutput(numBlocks)),
+                          numBlocks);
+
+      typename PartialArrayHandleType::PortalConstControl partialsPortal =
+          partials.GetPortalConstControl();
+      for (dax::Id blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+        {
+        statistics = dax::exec::internal::kernel::FieldStatisticsMerge(
+              statistics, partialsPortal.Get(blockIndex));
+        }
+      }
+
+    this->Statistics = statistics;
+  }
+
+  /// Counts the values of \p field in \p numberOfBins evenly spaced bins
+  /// spanning \p minimum to \p maximum and places the counts in \p histogram.
+  /// Values outside of the range are not counted.
+  ///
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void RunHistogram(
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field,
+      dax::Id numberOfBins,
+      double minimum,
+      double maximum,
+      IdArrayHandleType &histogram) const
+  {
+    DAX_ASSERT_CONT(numberOfBins > 0);
+    DAX_ASSERT_CONT(minimum <= maximum);
+
+    const dax::Id numValues = field.GetNumberOfValues();
+    const dax::Id blockSize = this->GetBlockSize(numValues);
+    const dax::Id numBlocks = (numValues + blockSize - 1)/blockSize;
+
+    typedef dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> FieldType;
+    typedef dax::exec::internal::kernel::FieldHistogramBlocks<
+        typename FieldType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution> CountKernelType;
+    IdArrayHandleType blockCounts;
+    Algorithm::Schedule(
+          CountKernelType(field.PrepareForInput(),
+                          numValues,
+                          blockSize,
+                          numberOfBins,
+                          minimum,
+                          maximum,
+                          blockCounts.PrepareForOutput(numBlocks*numberOfBins)),
+          numBlocks);
+
+    typedef dax::exec::internal::kernel::FieldHistogramMerge<
+        typename IdArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution> MergeKernelType;
+    Algorithm::Schedule(
+          MergeKernelType(blockCounts.PrepareForInput(),
+                          numBlocks,
+                          numberOfBins,
+                          histogram.PrepareForOutput(numberOfBins)),
+          numberOfBins);
+  }
+
+  /// Counts the values of \p field in \p numberOfBins evenly spaced bins
+  /// spanning the range found by the last call to Run.
+  ///
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void RunHistogram(
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field,
+      dax::Id numberOfBins,
+      IdArrayHandleType &histogram) const
+  {
+    this->RunHistogram(field,
+                       numberOfBins,
+                       this->Statistics.Minimum,
+                       this->Statistics.Maximum,
+                       histogram);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->Statistics.Count; }
+
+  DAX_CONT_EXPORT
+  double GetMinimum() const { return this->Statistics.Minimum; }
+
+  DAX_CONT_EXPORT
+  double GetMaximum() const { return this->Statistics.Maximum; }
+
+  DAX_CONT_EXPORT
+  double GetMean() const { return this->Statistics.Mean; }
+
+  DAX_CONT_EXPORT
+  double GetVariance() const
+  {
+    if (this->Statistics.Count == 0) { return 0; }
+    return this->Statistics.M2/this->Statistics.Count;
+  }
+
+  DAX_CONT_EXPORT
+  double GetStandardDeviation() const
+  {
+    return sqrt(this->GetVariance());
+  }
+
+  /// The skewness is zero for a field with no variance.
+  ///
+  DAX_CONT_EXPORT
+  double GetSkewness() const
+  {
+    if (this->Statistics.M2 <= 0) { return 0; }
+    return sqrt(static_cast<double>(this->Statistics.Count))
+        * this->Statistics.M3/pow(this->Statistics.M2, 1.5);
+  }
+
+private:
+  DAX_CONT_EXPORT
+  dax::Id GetBlockSize(dax::Id numValues) const
+  {
+    const dax::Id maxBlocks = this->MaximumNumberOfBlocks;
+    dax::Id blockSize = (numValues + maxBlocks - 1)/maxBlocks;
+    if (blockSize < this->MinimumBlockSize)
+      {
+      blockSize = this->MinimumBlockSize;
+      }
+    return blockSize;
+  }
+
+  dax::Id MaximumNumberOfBlocks;
+  dax::Id MinimumBlockSize;
+  PartialType Statistics;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_FieldStatistics_h
@@ -0,0 +1,208 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ParticleAdvection_h
+#define __dax_cont_ParticleAdvection_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/ExecutionObject.h>
+
+#include <dax/exec/FieldEvaluatorUniformGrid.h>
+#include <dax/exec/ParticleAdvectionResult.h>
+
+#include <dax/worklet/ParticleAdvection.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Traces particles through a point-centered vector field on a
+/// uniform grid.
+///
+/// Particles are advected with a fourth order Runge-Kutta integrator in
+/// rounds. Each round schedules one work item per particle still inside the
+/// grid and takes a fixed number of steps. Particles that leave the grid are
+/// removed with StreamCompact before the next round, so the cost of later
+/// rounds is proportional to the number of live particles.
+///
+/// After Run, GetEndPoints holds the final position of every seed. If
+/// polylines are recorded, GetPolylinePoints holds the path of every seed with
+/// a stride of GetPointsPerPolyline, of which the first GetPolylineLengths
+/// entries are valid.
+///
+template<class VelocityContainerTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ParticleAdvection
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> GridType;
+  typedef dax::cont::ArrayHandle<dax::Vector3,
+                                 VelocityContainerTag,
+                                 DeviceAdapterTag> VelocityType;
+  typedef dax::cont::ArrayHandle<dax::Vector3,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> PointArrayType;
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayType;
+
+  DAX_CONT_EXPORT
+  ParticleAdvection(const GridType &grid,
+                    const VelocityType &velocity,
+                    dax::Scalar stepSize,
+                    dax::Id stepsPerRound)
+    : Grid(grid),
+      Velocity(velocity),
+      StepSize(stepSize),
+      StepsPerRound(stepsPerRound),
+      RecordPolylines(false),
+      PointsPerPolyline(0),
+      NumberOfActiveParticles(0)
+  {
+    DAX_ASSERT_CONT(velocity.GetNumberOfValues() == grid.GetNumberOfPoints());
+    DAX_ASSERT_CONT(stepsPerRound > 0);
+  }
+
+  DAX_CONT_EXPORT
+  void SetRecordPolylines(bool flag) { this->RecordPolylines = flag; }
+  DAX_CONT_EXPORT
+  bool GetRecordPolylines() const { return this->RecordPolylines; }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetStepSize() const { return this->StepSize; }
+  DAX_CONT_EXPORT
+  dax::Id GetStepsPerRound() const { return this->StepsPerRound; }
+
+  /// Advects \p seeds for up to \p numberOfRounds rounds. Stops early if every
+  /// particle has left the grid.
+  ///
+  template<class SeedContainerTag>
+  DAX_CONT_EXPORT
+  void Run(const dax::cont::ArrayHandle<dax::Vector3,
+                                        SeedContainerTag,
+                                        DeviceAdapterTag> &seeds,
+           dax::Id numberOfRounds)
+  {
+    typedef dax::exec::FieldEvaluatorUniformGrid<
+        typename VelocityType::PortalConstExecution> EvaluatorType;
+    typedef dax::exec::ParticleAdvectionResult<
+        typename PointArrayType::PortalExecution,
+        typename IdArrayType::PortalExecution> ResultType;
+
+    const dax::Id numberOfSeeds = seeds.GetNumberOfValues();
+
+    // Seeds that never take a step end where they started.
+    Algorithm::Copy(seeds, this->EndPoints);
+
+    this->PointsPerPolyline = numberOfRounds*this->StepsPerRound + 1;
+    typename PointArrayType::PortalExecution polylinePoints;
+    typename IdArrayType::PortalExecution polylineLengths;
+    if (this->RecordPolylines)
+      {
+      polylinePoints = this->PolylinePoints.PrepareForOutput(
+            numberOfSeeds*this->PointsPerPolyline);
+      polylineLengths = this->PolylineLengths.PrepareForOutput(numberOfSeeds);
+      }
+
+    PointArrayType positions;
+    Algorithm::Copy(seeds, positions);
+    IdArrayType particleIds;
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                        numberOfSeeds,
+                                                        DeviceAdapterTag()),
+                    particleIds);
+
+    EvaluatorType evaluator(this->Grid.PrepareForInput(),
+                            this->Velocity.PrepareForInput());
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    dax::worklet::ParticleAdvectionRK4 worklet(this->StepSize,
+                                               this->StepsPerRound);
+
+    this->NumberOfActiveParticles = numberOfSeeds;
+    for (dax::Id round = 0;
+         (round < numberOfRounds) && (this->NumberOfActiveParticles > 0);
+         round++)
+      {
+      ResultType result(this->EndPoints.PrepareForInPlace(),
+                        this->RecordPolylines,
+                        polylinePoints,
+                        polylineLengths,
+                        this->PointsPerPolyline,
+                        round*this->StepsPerRound);
+
+      PointArrayType newPositions;
+      IdArrayType status;
+      scheduler.Invoke(worklet,
+                       positions,
+                       particleIds,
+                       evaluator,
+                       result,
+                       newPositions,
+                       status);
+
+      // Remove the particles that left the grid.
+      Algorithm::StreamCompact(newPositions, status, positions);
+      IdArrayType activeIds;
+      Algorithm::StreamCompact(particleIds, status, activeIds);
+      particleIds = activeIds;
+      this->NumberOfActiveParticles = positions.GetNumberOfValues();
+      }
+  }
+
+  /// The final position of each seed.
+  ///
+  DAX_CONT_EXPORT
+  PointArrayType GetEndPoints() const { return this->EndPoints; }
+
+  /// The number of particles still inside the grid after the last round.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfActiveParticles() const
+  {
+    return this->NumberOfActiveParticles;
+  }
+
+  DAX_CONT_EXPORT
+  PointArrayType GetPolylinePoints() const { return this->PolylinePoints; }
+  DAX_CONT_EXPORT
+  IdArrayType GetPolylineLengths() const { return this->PolylineLengths; }
+  DAX_CONT_EXPORT
+  dax::Id GetPointsPerPolyline() const { return this->PointsPerPolyline; }
+
+private:
+  GridType Grid;
+  VelocityType Velocity;
+  dax::Scalar StepSize;
+  dax::Id StepsPerRound;
+  bool RecordPolylines;
+  dax::Id PointsPerPolyline;
+  dax::Id NumberOfActiveParticles;
+  PointArrayType EndPoints;
+  PointArrayType PolylinePoints;
+  IdArrayType PolylineLengths;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ParticleAdvection_h
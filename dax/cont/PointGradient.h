@@ -0,0 +1,284 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_PointGradient_h
+#define __dax_cont_PointGradient_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/ExecutionObject.h>
+
+#include <dax/exec/PointGradient.h>
+#include <dax/exec/internal/kernel/PointGradientWorklets.h>
+
+#include <dax/worklet/PointGradient.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Computes gradients of point fields at the points of a grid.
+///
+/// For unstructured grids, the gradient at a point is the average of the
+/// gradients at the centers of the cells using the point, weighted by the
+/// measure (volume, area or length) of each cell. The lists of cells using
+/// each point are built with one sort the first time they are needed (or when
+/// Build is called) and are reused for every field computed afterward, so a
+/// mesh that does not change pays for the sort once. This replaces running
+/// CellGradient followed by CellDataToPointData, which sorts the cell values
+/// for every field.
+///
+/// For grids of polygons (such as the triangles from marching cubes),
+/// RunNormals computes unit vertex normals as the area-weighted average of
+/// the polygon normals.
+///
+/// There is a specialization for dax::cont::UniformGrid that uses central
+/// differences of the neighboring points instead.
+///
+template<class GridType,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class PointGradient
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandleType;
+  typedef dax::cont::ArrayHandle<dax::Scalar,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> ScalarArrayHandleType;
+  typedef dax::cont::ArrayHandle<dax::Vector3,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> VectorArrayHandleType;
+
+  DAX_CONT_EXPORT
+  PointGradient(const GridType &grid)
+    : Grid(grid), IncidenceValid(false) {  }
+
+  DAX_CONT_EXPORT
+  const GridType &GetGrid() const { return this->Grid; }
+
+  /// Builds the lists of cells incident to each point. Does nothing if they
+  /// are already built.
+  ///
+  DAX_CONT_EXPORT
+  void Build()
+  {
+    if (this->IncidenceValid) { return; } // Nothing to do.
+
+    typedef typename GridType::TopologyStructConstExecution TopologyType;
+    const dax::Id numCells = this->Grid.GetNumberOfCells();
+    const dax::Id numEntries =
+        numCells * dax::CellTraits<typename GridType::CellTag>::NUM_VERTICES;
+
+    // Write a (point, cell) pair for every cell vertex and then group the
+    // pairs by point.
+    IdArrayHandleType pointIds;
+    typedef dax::exec::internal::kernel::PointIncidenceFill<
+        TopologyType,
+        typename IdArrayHandleType::PortalExecution> FillKernelType;
+    Algorithm::Schedule(
+          FillKernelType(this->Grid.PrepareForInput(),
+                         pointIds.PrepareForOutput(numEntries),
+                         this->IncidentCellIds.PrepareForOutput(numEntries)),
+          numCells);
+
+    Algorithm::SortByKey(pointIds, this->IncidentCellIds);
+
+    // There is one more offset than points so that the last point knows where
+    // its list ends.
+    Algorithm::LowerBounds(
+          pointIds,
+          dax::cont::make_ArrayHandleCounting(
+            dax::Id(0), this->Grid.GetNumberOfPoints()+1, DeviceAdapterTag()),
+          this->PointOffsets);
+
+    this->IncidenceValid = true;
+  }
+
+  /// Computes the gradient of \p field at each point into \p gradient.
+  ///
+  template<class Container>
+  DAX_CONT_EXPORT
+  void Run(const dax::cont::ArrayHandle<dax::Scalar,
+                                        Container,
+                                        DeviceAdapterTag> &field,
+           VectorArrayHandleType &gradient)
+  {
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == this->Grid.GetNumberOfPoints());
+    this->Build();
+
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    VectorArrayHandleType weightedGradients;
+    ScalarArrayHandleType weights;
+    scheduler.Invoke(dax::worklet::PointGradientCellContribution(),
+                     this->Grid,
+                     this->Grid.GetPointCoordinates(),
+                     field,
+                     weightedGradients,
+                     weights);
+
+    scheduler.Invoke(dax::worklet::PointGradientAverage(),
+                     this->GetPointIndices(),
+                     this->PrepareSumForInput(weightedGradients),
+                     this->PrepareSumForInput(weights),
+                     gradient);
+  }
+
+  /// Computes unit normals at each point of a grid of triangles or
+  /// quadrilaterals into \p normals. The normals follow the winding of the
+  /// polygons.
+  ///
+  DAX_CONT_EXPORT
+  void RunNormals(VectorArrayHandleType &normals)
+  {
+    this->Build();
+
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    VectorArrayHandleType polygonNormals;
+    scheduler.Invoke(dax::worklet::PointNormalCellContribution(),
+                     this->Grid,
+                     this->Grid.GetPointCoordinates(),
+                     polygonNormals);
+
+    scheduler.Invoke(dax::worklet::PointNormalAverage(),
+                     this->GetPointIndices(),
+                     this->PrepareSumForInput(polygonNormals),
+                     normals);
+  }
+
+  /// The offset of each point's entries in the incident cell id array. There
+  /// is an extra entry at the end giving the total number of entries.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayHandleType GetPointOffsets()
+  {
+    this->Build();
+    return this->PointOffsets;
+  }
+
+  /// The concatenated lists of cells using each point.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayHandleType GetIncidentCellIds()
+  {
+    this->Build();
+    return this->IncidentCellIds;
+  }
+
+private:
+  DAX_CONT_EXPORT
+  dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>
+  GetPointIndices() const
+  {
+    return dax::cont::make_ArrayHandleCounting(
+          dax::Id(0), this->Grid.GetNumberOfPoints(), DeviceAdapterTag());
+  }
+
+  template<typename T>
+  DAX_CONT_EXPORT
+  dax::exec::PointIncidentCellSum<
+      typename IdArrayHandleType::PortalConstExecution,
+      typename dax::cont::ArrayHandle<T,
+                                      dax::cont::ArrayContainerControlTagBasic,
+                                      DeviceAdapterTag>::PortalConstExecution>
+  PrepareSumForInput(
+      const dax::cont::ArrayHandle<T,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> &cellValues)
+  {
+    typedef dax::exec::PointIncidentCellSum<
+        typename IdArrayHandleType::PortalConstExecution,
+        typename dax::cont::ArrayHandle<
+          T,
+          dax::cont::ArrayContainerControlTagBasic,
+          DeviceAdapterTag>::PortalConstExecution> SumType;
+    return SumType(this->PointOffsets.PrepareForInput(),
+                   this->IncidentCellIds.PrepareForInput(),
+                   cellValues.PrepareForInput());
+  }
+
+  GridType Grid;
+  IdArrayHandleType PointOffsets;
+  IdArrayHandleType IncidentCellIds;
+  bool IncidenceValid;
+};
+
+/// Point gradients on a uniform grid use central differences of the
+/// neighboring points (one-sided on the boundary). No incidence lists are
+/// needed.
+///
+template<class DeviceAdapterTag>
+class PointGradient<dax::cont::UniformGrid<DeviceAdapterTag>, DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> GridType;
+  typedef dax::cont::ArrayHandle<dax::Vector3,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> VectorArrayHandleType;
+
+  DAX_CONT_EXPORT
+  PointGradient(const GridType &grid) : Grid(grid) {  }
+
+  DAX_CONT_EXPORT
+  const GridType &GetGrid() const { return this->Grid; }
+
+  /// Does nothing. Present for symmetry with the unstructured version.
+  ///
+  DAX_CONT_EXPORT
+  void Build() {  }
+
+  /// Computes the gradient of \p field at each point into \p gradient.
+  ///
+  template<class Container>
+  DAX_CONT_EXPORT
+  void Run(const dax::cont::ArrayHandle<dax::Scalar,
+                                        Container,
+                                        DeviceAdapterTag> &field,
+           VectorArrayHandleType &gradient)
+  {
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == this->Grid.GetNumberOfPoints());
+
+    typedef dax::exec::PointGradientUniformGrid<
+        typename dax::cont::ArrayHandle<dax::Scalar,
+                                        Container,
+                                        DeviceAdapterTag>::PortalConstExecution>
+        GradientType;
+
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    scheduler.Invoke(dax::worklet::PointGradientUniform(),
+                     dax::cont::make_ArrayHandleCounting(
+                       dax::Id(0),
+                       this->Grid.GetNumberOfPoints(),
+                       DeviceAdapterTag()),
+                     GradientType(this->Grid.PrepareForInput(),
+                                  field.PrepareForInput()),
+                     gradient);
+  }
+
+private:
+  GridType Grid;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_PointGradient_h
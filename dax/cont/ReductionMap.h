@@ -0,0 +1,528 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#ifndef __dax_cont_ReductionMap_h
+#define __dax_cont_ReductionMap_h
+
+#include <dax/Types.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+template< typename IndexArrayType >
+struct Offset2CountFunctor : dax::exec::internal::WorkletBase
+{
+  typename IndexArrayType::PortalConstExecution OffsetsPortal;
+  typename IndexArrayType::PortalExecution CountsPortal;
+  dax::Id MaxId;
+  dax::Id OffsetEnd;
+
+  Offset2CountFunctor(
+      typename IndexArrayType::PortalConstExecution offsetsPortal,
+      typename IndexArrayType::PortalExecution countsPortal,
+      dax::Id maxId,
+      dax::Id offsetEnd)
+    : OffsetsPortal(offsetsPortal),
+      CountsPortal(countsPortal),
+      MaxId(maxId),
+      OffsetEnd(offsetEnd) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    dax::Id thisOffset = this->OffsetsPortal.Get(index);
+    dax::Id nextOffset;
+    if (index == this->MaxId)
+      {
+      nextOffset = this->OffsetEnd;
+      }
+    else
+      {
+      nextOffset = this->OffsetsPortal.Get(index+1);
+      }
+    this->CountsPortal.Set(index, nextOffset - thisOffset);
+  }
+};
+
+/// Counts the keys in one contiguous block of the input. Each block owns the
+/// row of the histogram at BlockIndex*NumberOfKeys, so blocks can run in
+/// parallel without atomics.
+template< typename KeysPortalType, typename HistogramPortalType >
+struct KeyBlockHistogramFunctor : dax::exec::internal::WorkletBase
+{
+  KeysPortalType KeysPortal;
+  HistogramPortalType HistogramPortal;
+  dax::Id NumberOfKeys;
+  dax::Id BlockSize;
+
+  KeyBlockHistogramFunctor(KeysPortalType keysPortal,
+                           HistogramPortalType histogramPortal,
+                           dax::Id numberOfKeys,
+                           dax::Id blockSize)
+    : KeysPortal(keysPortal),
+      HistogramPortal(histogramPortal),
+      NumberOfKeys(numberOfKeys),
+      BlockSize(blockSize) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id block) const {
+    const dax::Id rowStart = block*this->NumberOfKeys;
+    for (dax::Id key = 0; key < this->NumberOfKeys; key++)
+      {
+      this->HistogramPortal.Set(rowStart + key, 0);
+      }
+
+    const dax::Id begin = block*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->KeysPortal.GetNumberOfValues())
+      {
+      end = this->KeysPortal.GetNumberOfValues();
+      }
+    for (dax::Id index = begin; index < end; index++)
+      {
+      const dax::Id key = this->KeysPortal.Get(index);
+      if ((key < 0) || (key >= this->NumberOfKeys))
+        {
+        this->RaiseError("Key is outside of the declared key range.");
+        return;
+        }
+      const dax::Id entry = rowStart + key;
+      this->HistogramPortal.Set(entry, this->HistogramPortal.Get(entry) + 1);
+      }
+  }
+};
+
+/// For one key, replaces the per-block counts with the offset of each block's
+/// group within the key's group, and stores the total count for the key.
+template< typename HistogramPortalType, typename CountsPortalType >
+struct KeyBlockOffsetFunctor : dax::exec::internal::WorkletBase
+{
+  HistogramPortalType HistogramPortal;
+  CountsPortalType CountsPortal;
+  dax::Id NumberOfKeys;
+  dax::Id NumberOfBlocks;
+
+  KeyBlockOffsetFunctor(HistogramPortalType histogramPortal,
+                        CountsPortalType countsPortal,
+                        dax::Id numberOfKeys,
+                        dax::Id numberOfBlocks)
+    : HistogramPortal(histogramPortal),
+      CountsPortal(countsPortal),
+      NumberOfKeys(numberOfKeys),
+      NumberOfBlocks(numberOfBlocks) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id key) const {
+    dax::Id total = 0;
+    for (dax::Id block = 0; block < this->NumberOfBlocks; block++)
+      {
+      const dax::Id entry = block*this->NumberOfKeys + key;
+      const dax::Id count = this->HistogramPortal.Get(entry);
+      this->HistogramPortal.Set(entry, total);
+      total += count;
+      }
+    this->CountsPortal.Set(key, total);
+  }
+};
+
+/// Writes the input indices of one block into their key groups. Indices keep
+/// their input order within each group.
+template< typename KeysPortalType,
+          typename HistogramPortalType,
+          typename OffsetsPortalType,
+          typename IndicesPortalType >
+struct KeyBlockScatterFunctor : dax::exec::internal::WorkletBase
+{
+  KeysPortalType KeysPortal;
+  HistogramPortalType HistogramPortal;
+  OffsetsPortalType OffsetsPortal;
+  IndicesPortalType IndicesPortal;
+  dax::Id NumberOfKeys;
+  dax::Id BlockSize;
+
+  KeyBlockScatterFunctor(KeysPortalType keysPortal,
+                         HistogramPortalType histogramPortal,
+                         OffsetsPortalType offsetsPortal,
+                         IndicesPortalType indicesPortal,
+                         dax::Id numberOfKeys,
+                         dax::Id blockSize)
+    : KeysPortal(keysPortal),
+      HistogramPortal(histogramPortal),
+      OffsetsPortal(offsetsPortal),
+      IndicesPortal(indicesPortal),
+      NumberOfKeys(numberOfKeys),
+      BlockSize(blockSize) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id block) const {
+    const dax::Id rowStart = block*this->NumberOfKeys;
+    const dax::Id begin = block*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->KeysPortal.GetNumberOfValues())
+      {
+      end = this->KeysPortal.GetNumberOfValues();
+      }
+    for (dax::Id index = begin; index < end; index++)
+      {
+      const dax::Id key = this->KeysPortal.Get(index);
+      const dax::Id entry = rowStart + key;
+      const dax::Id position = this->HistogramPortal.Get(entry);
+      this->HistogramPortal.Set(entry, position + 1);
+      this->IndicesPortal.Set(this->OffsetsPortal.Get(key) + position, index);
+      }
+  }
+};
+}
+}
+}
+}
+
+namespace dax {
+namespace cont {
+
+/// \brief Groups the indices of an array of keys by key.
+///
+/// A ReductionMap describes, for each unique key, how many input values have
+/// that key and at which input indices they are. It depends only on the keys,
+/// so it can be built once and given to any number of ReduceKeysValues
+/// invocations, with different value arrays and worklets, as long as the keys
+/// do not change (for example the point ids of a static topology).
+///
+/// Copies of a ReductionMap share the same arrays, like ArrayHandle. Building
+/// through any copy builds it for all of them.
+///
+template<class KeysHandleType = dax::cont::ArrayHandle< dax::Id > >
+class ReductionMap
+{
+public:
+  typedef KeysHandleType KeysType;
+  typedef typename KeysHandleType::DeviceAdapterTag DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IndexArrayType;
+
+  /// Creates an empty map with no keys.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMap() : Internals(new InternalStruct) {  }
+
+  /// Creates a map for \p keys. The map is built the first time it is used.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMap(const KeysType &keys) : Internals(new InternalStruct)
+  {
+    this->Internals->Keys = keys;
+  }
+
+  /// Creates an already built map from its arrays, for example ones read back
+  /// with dax::cont::io::ReadRaw. The original keys are not needed.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMap(const IndexArrayType &counts,
+               const IndexArrayType &offsets,
+               const IndexArrayType &indices,
+               const KeysType &reductionKeys)
+    : Internals(new InternalStruct)
+  {
+    this->Internals->ReductionCounts = counts;
+    this->Internals->ReductionOffsets = offsets;
+    this->Internals->ReductionIndices = indices;
+    this->Internals->ReductionKeys = reductionKeys;
+    this->Internals->Valid = true;
+  }
+
+  DAX_CONT_EXPORT
+  KeysType GetKeys() const { return this->Internals->Keys; }
+
+  /// Declares that every key is in the range [0, numberOfKeys). When set
+  /// (and the keys are dax::Id), the map is built with a counting sort, which
+  /// is linear in the number of values, instead of a full sort. This is the
+  /// case for point ids generated from cells. A value of 0 (the default)
+  /// means the range is unknown.
+  ///
+  DAX_CONT_EXPORT
+  void SetKeyRange(dax::Id numberOfKeys)
+  {
+    if (numberOfKeys != this->Internals->KeyRange)
+      {
+      this->Internals->KeyRange = numberOfKeys;
+      this->Internals->Valid = !this->HasKeys() && this->Internals->Valid;
+      }
+  }
+  DAX_CONT_EXPORT
+  dax::Id GetKeyRange() const { return this->Internals->KeyRange; }
+
+  /// Returns true if the map has been built (or was given its arrays).
+  ///
+  DAX_CONT_EXPORT
+  bool IsValid() const { return this->Internals->Valid; }
+
+  /// Builds the map from the keys. Does nothing if it is already built.
+  ///
+  DAX_CONT_EXPORT
+  void Build()
+  {
+    if (this->Internals->Valid) { return; } // Nothing to do.
+
+    if (this->Internals->KeyRange > 0)
+      {
+      this->BuildReductionMapCounting(typename KeysType::ValueType());
+      }
+    else
+      {
+      this->BuildReductionMapSorted();
+      }
+    this->Internals->Valid = true;
+  }
+
+  /// \brief Stores the number of values to reduce for each key.
+  ///
+  /// Each index in this array cooresponds to an output value, and the entry
+  /// gives the number of values combined using the reduction operation.
+  ///
+  DAX_CONT_EXPORT
+  IndexArrayType GetReductionCounts() {
+    this->Build();
+    return this->Internals->ReductionCounts;
+  }
+
+  /// \brief Stores offsets into the ReductionIndices array.
+  ///
+  /// The ReductionIndices array contains groups of input values that should be
+  /// reduced.  This ReductionOffsets array gives, for each output index, the
+  /// offset into ReductionIndices where the group for the associated index
+  /// begins.
+  ///
+  DAX_CONT_EXPORT
+  IndexArrayType GetReductionOffsets() {
+    this->Build();
+    return this->Internals->ReductionOffsets;
+  }
+
+  /// \brief Stores the indices of groups to be reduced.
+  ///
+  /// The ReductionIndices array contains groups of input values that should be
+  /// reduced.  Given an index i for the output array, the input values to be
+  /// reduced together for this output value are given by the indices in
+  /// ReductionIndices from ReductionOffsets[i] to
+  /// ReductionOffsets[i]+ReductionCounts[i]-1.
+  ///
+  DAX_CONT_EXPORT
+  IndexArrayType GetReductionIndices() {
+    this->Build();
+    return this->Internals->ReductionIndices;
+  }
+
+  /// \brief Stores the unique key for each group
+  ///
+  /// The ReductionKeys array contains the key for each input group to be reduced
+  ///
+  DAX_CONT_EXPORT
+  KeysType GetReductionKeys() {
+    this->Build();
+    return this->Internals->ReductionKeys;
+  }
+
+  /// Releases the execution copies of the keys.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseKeysExecution() {
+    this->Internals->Keys.ReleaseResourcesExecution();
+  }
+
+  /// Releases the execution copies of the map. If the map has keys to rebuild
+  /// from, it is marked as not built.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseResourcesExecution() {
+    this->Internals->ReductionCounts.ReleaseResourcesExecution();
+    this->Internals->ReductionOffsets.ReleaseResourcesExecution();
+    this->Internals->ReductionIndices.ReleaseResourcesExecution();
+    this->Internals->Valid = !this->HasKeys() && this->Internals->Valid;
+  }
+
+private:
+  DAX_CONT_EXPORT
+  bool HasKeys() const
+  {
+    return this->Internals->Keys.GetNumberOfValues() > 0;
+  }
+
+  DAX_CONT_EXPORT
+  void BuildReductionMapSorted()
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithms;
+
+    // Make a copy of the keys.  (Our first step is sort, which is in place.)
+    dax::cont::ArrayHandle<
+        typename KeysType::ValueType,
+        dax::cont::ArrayContainerControlTagBasic,
+        DeviceAdapterTag> sortedKeys;
+    Algorithms::Copy(this->Internals->Keys, sortedKeys);
+
+    // Initialize the indices using a counting array. After they are sorted as
+    // values, they will point to the original index. Using a counting array
+    // handle to initialize. You could also use a simple functor and a
+    // schedule, but this is fewer lines and is probably about the same
+    // runtime.
+    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
+        countingArray(0, this->Internals->Keys.GetNumberOfValues());
+    Algorithms::Copy(countingArray, this->Internals->ReductionIndices);
+
+    Algorithms::SortByKey(sortedKeys, this->Internals->ReductionIndices);
+
+    // Unique keys represents the output entries.
+    Algorithms::Copy(sortedKeys, this->Internals->ReductionKeys);
+    Algorithms::Unique(this->Internals->ReductionKeys);
+
+    // Find the index of each unique key in the sorted list to get the offsets
+    // into the ReductionIndices array.
+    Algorithms::LowerBounds(sortedKeys,
+                            this->Internals->ReductionKeys,
+                            this->Internals->ReductionOffsets);
+
+    //Find the number of values corresponding to each unique key.
+    dax::Id numUniqueKeys = this->Internals->ReductionKeys.GetNumberOfValues();
+
+    typedef dax::exec::internal::kernel::Offset2CountFunctor<
+                        IndexArrayType> OffsetFunctorType;
+    OffsetFunctorType offset2Count(
+          this->Internals->ReductionOffsets.PrepareForInput(),
+          this->Internals->ReductionCounts.PrepareForOutput(numUniqueKeys),
+          numUniqueKeys-1,
+          this->Internals->ReductionIndices.GetNumberOfValues());
+    Algorithms::Schedule(offset2Count, numUniqueKeys);
+
+  }
+
+  // Counting sort for keys in [0, KeyRange). The input is split into blocks
+  // that each build their own row of a histogram, so no two blocks write the
+  // same entry. The rows are turned into per-block offsets for each key, the
+  // key totals are scanned into the group offsets, and each block scatters
+  // its indices into place.
+  DAX_CONT_EXPORT
+  void BuildReductionMapCounting(dax::Id)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithms;
+
+    const dax::Id numKeys = this->Internals->KeyRange;
+    const dax::Id numValues = this->Internals->Keys.GetNumberOfValues();
+
+    // Use enough blocks to keep the device busy while keeping the histogram
+    // within a small multiple of the input size.
+    dax::Id numBlocks = (2*numValues)/numKeys;
+    if (numBlocks > 256) { numBlocks = 256; }
+    if (numBlocks > numValues) { numBlocks = numValues; }
+    if (numBlocks < 1) { numBlocks = 1; }
+    const dax::Id blockSize = (numValues + numBlocks - 1)/numBlocks;
+
+    typedef typename KeysType::PortalConstExecution KeysPortalType;
+    typedef typename IndexArrayType::PortalExecution PortalType;
+    typedef typename IndexArrayType::PortalConstExecution PortalConstType;
+
+    KeysPortalType keysPortal = this->Internals->Keys.PrepareForInput();
+
+    IndexArrayType histogram;
+    PortalType histogramPortal =
+        histogram.PrepareForOutput(numBlocks*numKeys);
+    Algorithms::Schedule(
+          dax::exec::internal::kernel::KeyBlockHistogramFunctor<
+              KeysPortalType,PortalType>(keysPortal,
+                                         histogramPortal,
+                                         numKeys,
+                                         blockSize),
+          numBlocks);
+
+    IndexArrayType counts;
+    Algorithms::Schedule(
+          dax::exec::internal::kernel::KeyBlockOffsetFunctor<
+              PortalType,PortalType>(histogram.PrepareForInPlace(),
+                                     counts.PrepareForOutput(numKeys),
+                                     numKeys,
+                                     numBlocks),
+          numKeys);
+
+    IndexArrayType offsets;
+    Algorithms::ScanExclusive(counts, offsets);
+
+    Algorithms::Schedule(
+          dax::exec::internal::kernel::KeyBlockScatterFunctor<
+              KeysPortalType,PortalType,PortalConstType,PortalType>(
+                keysPortal,
+                histogram.PrepareForInPlace(),
+                offsets.PrepareForInput(),
+                this->Internals->ReductionIndices.PrepareForOutput(numValues),
+                numKeys,
+                blockSize),
+          numBlocks);
+
+    // Keys that never appear do not get an output entry.
+    Algorithms::StreamCompact(counts, this->Internals->ReductionKeys);
+    if (this->Internals->ReductionKeys.GetNumberOfValues() == numKeys)
+      {
+      this->Internals->ReductionCounts = counts;
+      this->Internals->ReductionOffsets = offsets;
+      }
+    else
+      {
+      Algorithms::StreamCompact(counts, counts, this->Internals->ReductionCounts);
+      Algorithms::StreamCompact(offsets, counts, this->Internals->ReductionOffsets);
+      }
+  }
+
+  // Only dax::Id keys can be counted into bins.
+  template<typename T>
+  DAX_CONT_EXPORT
+  void BuildReductionMapCounting(T)
+  {
+    this->BuildReductionMapSorted();
+  }
+
+  struct InternalStruct
+  {
+    InternalStruct() : KeyRange(0), Valid(false) {  }
+
+    KeysType Keys;
+    IndexArrayType ReductionCounts;
+    IndexArrayType ReductionOffsets;
+    IndexArrayType ReductionIndices;
+    KeysType ReductionKeys;
+    dax::Id KeyRange;
+    bool Valid;
+  };
+
+  boost::shared_ptr<InternalStruct> Internals;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ReductionMap_h
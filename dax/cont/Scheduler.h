@@ -28,6 +28,7 @@
 #include <dax/cont/scheduling/SchedulerGenerateInterpolatedCells.h>
 #include <dax/cont/scheduling/SchedulerGenerateKeysValues.h>
 #include <dax/cont/scheduling/SchedulerGenerateTopology.h>
+#include <dax/cont/scheduling/SchedulerMapFieldPacket.h>
 #include <dax/cont/scheduling/SchedulerReduceKeysValues.h>
 #include <dax/cont/PermutationContainer.h>
 
@@ -0,0 +1,437 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_StreamUniformGrid_h
+#define __dax_cont_StreamUniformGrid_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayContainerControlUserMemory.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <boost/cstdint.hpp>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace dax {
+namespace cont {
+
+/// \brief Reads point field values for StreamUniformGrid from a raw file.
+///
+/// The file holds the values of the whole grid in the native byte order and
+/// in the order of the point indices (x fastest), starting \c offset bytes
+/// into the file. Prefetch asks the operating system to start reading a
+/// range of values in the background (posix_fadvise), so the read of the
+/// next slab overlaps the computation on the current one.
+///
+template<typename T>
+class StreamReaderRawFile
+{
+public:
+  typedef T ValueType;
+
+  DAX_CONT_EXPORT
+  StreamReaderRawFile(const std::string &filename, boost::int64_t offset = 0)
+    : Filename(filename), Offset(offset)
+  {
+#ifndef _WIN32
+    this->FileDescriptor = open(filename.c_str(), O_RDONLY);
+    if (this->FileDescriptor < 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Could not open " + filename + ": " + strerror(errno));
+      }
+#else
+    this->File.open(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!this->File)
+      {
+      throw dax::cont::ErrorControlBadValue("Could not open " + filename);
+      }
+#endif
+  }
+
+  DAX_CONT_EXPORT
+  ~StreamReaderRawFile()
+  {
+#ifndef _WIN32
+    close(this->FileDescriptor);
+#endif
+  }
+
+  /// Starts reading the given values into the page cache without waiting
+  /// for them. This is only a hint, so failures are ignored.
+  ///
+  DAX_CONT_EXPORT
+  void Prefetch(dax::Id firstValue, dax::Id numberOfValues)
+  {
+#if !defined(_WIN32) && defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(this->FileDescriptor,
+                  static_cast<off_t>(this->GetByteOffset(firstValue)),
+                  static_cast<off_t>(numberOfValues*sizeof(ValueType)),
+                  POSIX_FADV_WILLNEED);
+#else
+    (void)firstValue;
+    (void)numberOfValues;
+#endif
+  }
+
+  /// Reads the given values into \p values.
+  ///
+  DAX_CONT_EXPORT
+  void Read(dax::Id firstValue, dax::Id numberOfValues, ValueType *values)
+  {
+    const boost::int64_t numberOfBytes =
+        static_cast<boost::int64_t>(numberOfValues)*sizeof(ValueType);
+#ifndef _WIN32
+    char *buffer = reinterpret_cast<char *>(values);
+    boost::int64_t bytesRead = 0;
+    while (bytesRead < numberOfBytes)
+      {
+      ssize_t result =
+          pread(this->FileDescriptor,
+                buffer + bytesRead,
+                static_cast<size_t>(numberOfBytes - bytesRead),
+                static_cast<off_t>(this->GetByteOffset(firstValue)+bytesRead));
+      if (result < 0)
+        {
+        if (errno == EINTR) { continue; }
+        throw dax::cont::ErrorControlBadValue(
+              "Could not read " + this->Filename + ": " + strerror(errno));
+        }
+      if (result == 0)
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "Unexpected end of file reading " + this->Filename);
+        }
+      bytesRead += result;
+      }
+#else
+    this->File.seekg(this->GetByteOffset(firstValue), std::ios::beg);
+    this->File.read(reinterpret_cast<char *>(values), numberOfBytes);
+    if (!this->File)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Could not read " + this->Filename);
+      }
+#endif
+  }
+
+private:
+  // Not implemented.
+  StreamReaderRawFile(const StreamReaderRawFile &);
+  void operator=(const StreamReaderRawFile &);
+
+  DAX_CONT_EXPORT
+  boost::int64_t GetByteOffset(dax::Id value) const
+  {
+    return this->Offset + static_cast<boost::int64_t>(value)*sizeof(ValueType);
+  }
+
+  std::string Filename;
+  boost::int64_t Offset;
+#ifndef _WIN32
+  int FileDescriptor;
+#else
+  std::ifstream File;
+#endif
+};
+
+/// \brief Reads point field values for StreamUniformGrid from an array
+/// portal.
+///
+/// Useful when the values are already reachable through a portal, for
+/// example that of an array from make_ArrayHandleMMap. Prefetch does nothing.
+///
+template<class PortalType>
+class StreamReaderPortal
+{
+public:
+  typedef typename PortalType::ValueType ValueType;
+
+  DAX_CONT_EXPORT
+  StreamReaderPortal(const PortalType &portal) : Portal(portal) {  }
+
+  DAX_CONT_EXPORT
+  void Prefetch(dax::Id daxNotUsed(firstValue),
+                dax::Id daxNotUsed(numberOfValues)) {  }
+
+  DAX_CONT_EXPORT
+  void Read(dax::Id firstValue, dax::Id numberOfValues, ValueType *values)
+  {
+    DAX_ASSERT_CONT(firstValue + numberOfValues
+                    <= this->Portal.GetNumberOfValues());
+    std::copy(this->Portal.GetIteratorBegin() + firstValue,
+              this->Portal.GetIteratorBegin() + firstValue + numberOfValues,
+              values);
+  }
+
+private:
+  PortalType Portal;
+};
+
+/// \brief Runs a pipeline over a UniformGrid one z-slab at a time.
+///
+/// StreamUniformGrid is for grids whose point fields do not fit in memory.
+/// It splits the extent of the grid into slabs of at most \c cellsPerSlab
+/// cell layers in z. Every cell belongs to exactly one slab, and each slab
+/// also holds the point layer it shares with the next slab (a one cell
+/// overlap), so per-cell pipelines such as marching cubes and threshold
+/// produce the same cells, in the same order, as a run over the whole grid.
+///
+/// Run loads the point field of each slab with a reader (such as
+/// StreamReaderRawFile) and calls the pipeline with a UniformGrid covering
+/// the slab (with the extent of the slab inside the whole grid, so point
+/// coordinates are unchanged) and an ArrayHandle of the slab's values. The
+/// slab values live in one buffer reused for every slab, so the pipeline
+/// must not keep the field array after it returns. Before running the
+/// pipeline on a slab, the reader is asked to prefetch the next slab so
+/// that its I/O happens during the computation.
+///
+/// Use UnstructuredGridAppender to combine the outputs of the slabs.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class StreamUniformGrid
+{
+public:
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> UniformGridType;
+
+  DAX_CONT_EXPORT
+  StreamUniformGrid(const UniformGridType &grid, dax::Id cellsPerSlab)
+    : Grid(grid), CellsPerSlab(cellsPerSlab)
+  {
+    if (cellsPerSlab < 1)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "A slab must have at least one layer of cells.");
+      }
+  }
+
+  DAX_CONT_EXPORT
+  const UniformGridType &GetGrid() const { return this->Grid; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetCellsPerSlab() const { return this->CellsPerSlab; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfSlabs() const
+  {
+    const dax::Id cellLayers =
+        dax::extentCellDimensions(this->Grid.GetExtent())[2];
+    return std::max(dax::Id(1),
+                    (cellLayers + this->CellsPerSlab - 1)/this->CellsPerSlab);
+  }
+
+  /// Returns a grid with the extent of the given slab.
+  ///
+  DAX_CONT_EXPORT
+  UniformGridType GetSlabGrid(dax::Id slab) const
+  {
+    DAX_ASSERT_CONT((slab >= 0) && (slab < this->GetNumberOfSlabs()));
+    const dax::Extent3 &extent = this->Grid.GetExtent();
+    dax::Id3 slabMin = extent.Min;
+    dax::Id3 slabMax = extent.Max;
+    slabMin[2] = extent.Min[2] + slab*this->CellsPerSlab;
+    slabMax[2] = std::min(extent.Max[2], slabMin[2] + this->CellsPerSlab);
+
+    UniformGridType slabGrid;
+    slabGrid.SetOrigin(this->Grid.GetOrigin());
+    slabGrid.SetSpacing(this->Grid.GetSpacing());
+    slabGrid.SetExtent(slabMin, slabMax);
+    return slabGrid;
+  }
+
+  /// Returns the index in the whole grid of the first point of the slab.
+  /// The points of a slab are contiguous in the whole grid.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetSlabFirstPoint(dax::Id slab) const
+  {
+    return this->Grid.ComputePointIndex(this->GetSlabGrid(slab).GetExtent().Min);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetSlabNumberOfPoints(dax::Id slab) const
+  {
+    return this->GetSlabGrid(slab).GetNumberOfPoints();
+  }
+
+  /// Runs \p pipeline on every slab in order. \p reader has to have the
+  /// methods <tt>Prefetch(firstValue, numberOfValues)</tt> and
+  /// <tt>Read(firstValue, numberOfValues, values)</tt>, which take the
+  /// indices of the values in the whole grid. \p pipeline is called as
+  /// <tt>pipeline(slabGrid, slabField, slab)</tt>.
+  ///
+  template<class ReaderType, class PipelineType>
+  DAX_CONT_EXPORT
+  void Run(ReaderType &reader, PipelineType &pipeline) const
+  {
+    typedef typename ReaderType::ValueType ValueType;
+
+    const dax::Id numberOfSlabs = this->GetNumberOfSlabs();
+    dax::Id bufferSize = 0;
+    for (dax::Id slab = 0; slab < numberOfSlabs; slab++)
+      {
+      bufferSize = std::max(bufferSize, this->GetSlabNumberOfPoints(slab));
+      }
+    std::vector<ValueType> buffer(bufferSize);
+
+    reader.Read(this->GetSlabFirstPoint(0),
+                this->GetSlabNumberOfPoints(0),
+                &buffer[0]);
+    for (dax::Id slab = 0; slab < numberOfSlabs; slab++)
+      {
+      if (slab+1 < numberOfSlabs)
+        {
+        reader.Prefetch(this->GetSlabFirstPoint(slab+1),
+                        this->GetSlabNumberOfPoints(slab+1));
+        }
+
+      // The array writes straight into the buffer, so it is not copied on
+      // devices that share memory with the control environment.
+      pipeline(this->GetSlabGrid(slab),
+               dax::cont::make_ArrayHandleUserMemory(
+                 &buffer[0],
+                 this->GetSlabNumberOfPoints(slab),
+                 dax::cont::UserMemoryNoRelease(),
+                 DeviceAdapterTag()),
+               slab);
+
+      if (slab+1 < numberOfSlabs)
+        {
+        reader.Read(this->GetSlabFirstPoint(slab+1),
+                    this->GetSlabNumberOfPoints(slab+1),
+                    &buffer[0]);
+        }
+      }
+  }
+
+private:
+  UniformGridType Grid;
+  dax::Id CellsPerSlab;
+};
+
+/// \brief Combines unstructured grids, such as the outputs of the slabs of
+/// StreamUniformGrid, into one grid.
+///
+/// The grids are gathered in the control environment, so only the combined
+/// output (not the input of the pipeline) has to fit in memory. Points are
+/// not merged, so points on the boundary between two slabs appear once for
+/// each slab.
+///
+template<class GridType>
+class UnstructuredGridAppender
+{
+public:
+  typedef typename GridType::CellTag CellTag;
+  typedef typename GridType::CellConnectionsType CellConnectionsType;
+  typedef typename GridType::PointCoordinatesType PointCoordinatesType;
+
+  /// Appends the cells and points of \p grid.
+  ///
+  DAX_CONT_EXPORT
+  void Append(const GridType &grid)
+  {
+    typedef typename CellConnectionsType::PortalConstControl ConnectionsPortal;
+    typedef typename PointCoordinatesType::PortalConstControl PointsPortal;
+
+    // Filters leave the arrays of an empty output unallocated.
+    if (grid.GetNumberOfCells() == 0) { return; }
+
+    const dax::Id pointOffset =
+        static_cast<dax::Id>(this->PointCoordinates.size());
+
+    ConnectionsPortal connections =
+        grid.GetCellConnections().GetPortalConstControl();
+    const dax::Id numberOfConnections = connections.GetNumberOfValues();
+    this->CellConnections.reserve(
+          this->CellConnections.size() + numberOfConnections);
+    for (dax::Id index = 0; index < numberOfConnections; index++)
+      {
+      this->CellConnections.push_back(connections.Get(index) + pointOffset);
+      }
+
+    PointsPortal points = grid.GetPointCoordinates().GetPortalConstControl();
+    this->PointCoordinates.insert(this->PointCoordinates.end(),
+                                  points.GetIteratorBegin(),
+                                  points.GetIteratorEnd());
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return static_cast<dax::Id>(this->CellConnections.size())
+        / dax::CellTraits<CellTag>::NUM_VERTICES;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return static_cast<dax::Id>(this->PointCoordinates.size());
+  }
+
+  /// Returns a grid with all the cells and points appended so far.
+  ///
+  DAX_CONT_EXPORT
+  GridType GetGrid() const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<
+        typename CellConnectionsType::DeviceAdapterTag> Algorithm;
+
+    CellConnectionsType cellConnections;
+    PointCoordinatesType pointCoordinates;
+    if (!this->CellConnections.empty())
+      {
+      Algorithm::Copy(dax::cont::make_ArrayHandle(
+                        this->CellConnections,
+                        typename CellConnectionsType::ArrayContainerControlTag(),
+                        typename CellConnectionsType::DeviceAdapterTag()),
+                      cellConnections);
+      Algorithm::Copy(dax::cont::make_ArrayHandle(
+                        this->PointCoordinates,
+                        typename PointCoordinatesType::ArrayContainerControlTag(),
+                        typename PointCoordinatesType::DeviceAdapterTag()),
+                      pointCoordinates);
+      }
+    return GridType(cellConnections, pointCoordinates);
+  }
+
+private:
+  std::vector<dax::Id> CellConnections;
+  std::vector<dax::Vector3> PointCoordinates;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_StreamUniformGrid_h
@@ -0,0 +1,62 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_FieldArrayHandleCompositeVector_h
+#define __dax_cont_arg_FieldArrayHandleCompositeVector_h
+
+#include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/ArrayHandleCompositeVector.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile FieldArrayHandle.h dax/cont/arg/FieldArrayHandle.h
+/// \brief Map composite vector array handle to \c Field worklet parameters.
+template <typename Tags, typename Component, int N>
+class ConceptMap< Field(Tags),
+                  dax::cont::ArrayHandleCompositeVector<Component, N> > :
+  public ConceptMap< Field(Tags),
+    typename dax::cont::ArrayHandleCompositeVector<Component,N>::Superclass >
+{
+  typedef ConceptMap< Field(Tags),
+    typename dax::cont::ArrayHandleCompositeVector<Component,N>::Superclass >
+      superclass;
+  typedef dax::cont::ArrayHandleCompositeVector<Component,N> HandleType;
+public:
+  ConceptMap(HandleType handle):
+    superclass(handle)
+    {}
+};
+
+/// \headerfile FieldArrayHandle.h dax/cont/arg/FieldArrayHandle.h
+/// \brief Map composite vector array handle to \c Field worklet parameters.
+template <typename Tags, typename Component, int N>
+class ConceptMap< Field(Tags),
+                  const dax::cont::ArrayHandleCompositeVector<Component, N> > :
+  public ConceptMap< Field(Tags), const
+    typename dax::cont::ArrayHandleCompositeVector<Component,N>::Superclass >
+{
+  typedef ConceptMap< Field(Tags), const
+    typename dax::cont::ArrayHandleCompositeVector<Component,N>::Superclass >
+      superclass;
+  typedef dax::cont::ArrayHandleCompositeVector<Component,N> HandleType;
+public:
+  ConceptMap(HandleType handle):
+    superclass(handle)
+    {}
+};
+
+} } } //namespace dax::cont::arg
+
+#endif //__dax_cont_arg_FieldArrayHandleCompositeVector_h
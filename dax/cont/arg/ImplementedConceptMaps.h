@@ -21,9 +21,13 @@
 //Add all concept maps to this header so that schedulers can find them.
 #include <dax/cont/arg/ConceptMap.h>
 #include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/arg/FieldArrayHandleCompositeVector.h>
+#include <dax/cont/arg/FieldArrayHandleConcatenate.h>
 #include <dax/cont/arg/FieldArrayHandleConstant.h>
 #include <dax/cont/arg/FieldArrayHandleCounting.h>
 #include <dax/cont/arg/FieldArrayHandlePermutation.h>
+#include <dax/cont/arg/FieldArrayHandleTransform.h>
+#include <dax/cont/arg/FieldArrayHandleView.h>
 #include <dax/cont/arg/FieldConstant.h>
 #include <dax/cont/arg/FieldMap.h>
 #include <dax/cont/arg/GeometryUniformGrid.h>
@@ -0,0 +1,372 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ArrayContainerControlView_h
+#define __dax_cont_internal_ArrayContainerControlView_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief An array portal to a contiguous range of another array portal.
+///
+/// Index \c i of this portal is index <tt>i + offset</tt> of the delegate
+/// portal.
+///
+template<class PortalT>
+class ArrayPortalView
+{
+public:
+  typedef PortalT DelegatePortalType;
+
+  typedef typename DelegatePortalType::ValueType ValueType;
+  typedef typename DelegatePortalType::IteratorType IteratorType;
+
+  DAX_EXEC_CONT_EXPORT ArrayPortalView() : Offset(0), NumberOfValues(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView(const DelegatePortalType &delegatePortal,
+                  dax::Id offset,
+                  dax::Id numberOfValues)
+    : DelegatePortal(delegatePortal),
+      Offset(offset),
+      NumberOfValues(numberOfValues)
+  {  }
+
+  /// Copy constructor for any other ArrayPortalView with a delegate type
+  /// that can be copied to this type. This allows us to do any type casting
+  /// the delegates can do (like the non-const to const cast).
+  ///
+  template<class OtherDelegateType>
+  DAX_CONT_EXPORT
+  ArrayPortalView(const ArrayPortalView<OtherDelegateType> &src)
+    : DelegatePortal(src.GetDelegatePortal()),
+      Offset(src.GetOffset()),
+      NumberOfValues(src.GetNumberOfValues())
+  {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->DelegatePortal.Get(index + this->Offset);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    this->DelegatePortal.Set(index + this->Offset, value);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    IteratorType iterator = this->DelegatePortal.GetIteratorBegin();
+    std::advance(iterator, this->Offset);
+    return iterator;
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    IteratorType iterator = this->GetIteratorBegin();
+    std::advance(iterator, this->NumberOfValues);
+    return iterator;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const DelegatePortalType &GetDelegatePortal() const {
+    return this->DelegatePortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetOffset() const { return this->Offset; }
+
+private:
+  DelegatePortalType DelegatePortal;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+};
+
+template<class ArrayHandleType>
+struct ArrayContainerControlTagView { };
+
+/// An ArrayContainerControl that refers to a range of the values in another
+/// ArrayHandle. It holds no memory of its own. Shrinking the view shortens
+/// the view, not the delegate array.
+///
+template<class ArrayHandleType>
+class ArrayContainerControl<
+    typename ArrayHandleType::ValueType,
+    ArrayContainerControlTagView<ArrayHandleType> >
+{
+public:
+  typedef typename ArrayHandleType::ValueType ValueType;
+
+  typedef ArrayPortalView<typename ArrayHandleType::PortalControl> PortalType;
+  typedef ArrayPortalView<typename ArrayHandleType::PortalConstControl>
+      PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Offset(0), NumberOfValues(0), Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const ArrayHandleType &delegateArray,
+                        dax::Id offset,
+                        dax::Id numberOfValues)
+    : DelegateArray(delegateArray),
+      Offset(offset),
+      NumberOfValues(numberOfValues),
+      Valid(true)
+  {
+    DAX_ASSERT_CONT(offset >= 0);
+    DAX_ASSERT_CONT(numberOfValues >= 0);
+    DAX_ASSERT_CONT(offset+numberOfValues <= delegateArray.GetNumberOfValues());
+  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalType(this->DelegateArray.GetPortalControl(),
+                      this->Offset,
+                      this->NumberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->DelegateArray.GetPortalConstControl(),
+                           this->Offset,
+                           this->NumberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id numberOfValues) {
+    // A view cannot reallocate the delegate array, but it can be used as an
+    // output for at most as many values as it covers.
+    DAX_ASSERT_CONT(this->Valid);
+    if (numberOfValues > this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "An array view cannot be allocated past its end.");
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    if (numberOfValues > this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shrink method cannot be used to grow array.");
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
+  // We don't own the memory, the delegate array does, so don't deallocate
+  // underneath of it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() {  }
+
+  DAX_CONT_EXPORT
+  const ArrayHandleType &GetDelegateArray() const {
+    return this->DelegateArray;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetOffset() const { return this->Offset; }
+
+private:
+  ArrayHandleType DelegateArray;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+  bool Valid;
+};
+
+template<typename T, class ArrayHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    T, ArrayContainerControlTagView<ArrayHandleType>, DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+/// Moves a view to the execution environment by preparing the delegate array
+/// and offsetting into its execution portal, so no values are copied beyond
+/// what the delegate array itself transfers.
+///
+template<class ArrayHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    typename ArrayHandleType::ValueType,
+    ArrayContainerControlTagView<ArrayHandleType>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControl<
+      typename ArrayHandleType::ValueType,
+      ArrayContainerControlTagView<ArrayHandleType> > ContainerType;
+
+public:
+  typedef typename ArrayHandleType::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalView<typename ArrayHandleType::PortalExecution>
+      PortalExecution;
+  typedef ArrayPortalView<typename ArrayHandleType::PortalConstExecution>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer()
+    : Offset(0),
+      NumberOfValues(0),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayTransfer(const ArrayHandleType &delegateArray,
+                dax::Id offset,
+                dax::Id numberOfValues)
+    : DelegateArray(delegateArray),
+      Offset(offset),
+      NumberOfValues(numberOfValues),
+      ExecutionPortalConstValid(false),
+      ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl portal) {
+    // Assumes the portal comes from a container viewing the same array.
+    this->NumberOfValues = portal.GetNumberOfValues();
+    this->ExecutionPortalConst =
+        PortalConstExecution(this->DelegateArray.PrepareForInput(),
+                             this->Offset,
+                             this->NumberOfValues);
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl portal) {
+    this->NumberOfValues = portal.GetNumberOfValues();
+    this->ExecutionPortal =
+        PortalExecution(this->DelegateArray.PrepareForInPlace(),
+                        this->Offset,
+                        this->NumberOfValues);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &controlArray,
+                              dax::Id numberOfValues) {
+    // Writing into a view overwrites that part of the delegate array, so the
+    // rest of the delegate array has to be kept.
+    controlArray.Allocate(numberOfValues);
+    this->NumberOfValues = numberOfValues;
+    this->ExecutionPortal =
+        PortalExecution(this->DelegateArray.PrepareForInPlace(),
+                        this->Offset,
+                        this->NumberOfValues);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData(ContainerType &controlArray) const {
+    // The delegate array holds the values. Just make sure the view has the
+    // same length.
+    controlArray.Shrink(this->NumberOfValues);
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    PortalConstControl portal(this->DelegateArray.GetPortalConstControl(),
+                              this->Offset,
+                              this->NumberOfValues);
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->NumberOfValues);
+    this->NumberOfValues = numberOfValues;
+    this->ExecutionPortal = PortalExecution(
+          this->ExecutionPortal.GetDelegatePortal(), this->Offset, numberOfValues);
+    this->ExecutionPortalConst = PortalConstExecution(
+          this->ExecutionPortalConst.GetDelegatePortal(),
+          this->Offset,
+          numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  // We don't own the memory, the delegate array does, so don't deallocate
+  // underneath of it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    this->ExecutionPortalConstValid = false;
+    this->ExecutionPortalValid = false;
+  }
+
+private:
+  ArrayHandleType DelegateArray;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+  PortalConstExecution ExecutionPortalConst;
+  bool ExecutionPortalConstValid;
+  PortalExecution ExecutionPortal;
+  bool ExecutionPortalValid;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ArrayContainerControlView_h
@@ -129,6 +129,48 @@ struct DeviceAdapterAlgorithm
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
       dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output);
 
+  /// \brief Compute an inclusive scan with a custom operator.
+  ///
+  /// Same as ScanInclusive except that \c binaryOperator, a functor taking
+  /// two values and returning their combination, is used instead of addition.
+  /// The operator must be associative but need not be commutative; it is
+  /// always called with the earlier value first. dax::Maximum, for example,
+  /// gives a running maximum.
+  ///
+  /// \return The last value of the scan.
+  ///
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output,
+      BinaryFunctor binaryOperator);
+
+  /// \brief Compute a segmented inclusive prefix sum.
+  ///
+  /// Each run of adjacent equal values in \c keys forms a segment, and the
+  /// \c values in each segment are scanned independently of the others. The
+  /// keys need not be sorted; only adjacent keys are compared. \c keys and
+  /// \c values must be the same size. \c output may be the same array as
+  /// \c values.
+  ///
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanInclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output);
+
+  /// \brief Compute a segmented exclusive prefix sum.
+  ///
+  /// Same as ScanInclusiveByKey except that each output value is the sum of
+  /// the values before it in its segment, so the first value of every
+  /// segment is 0.
+  ///
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanExclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output);
+
   /// \brief Schedule many instances of a function to run on concurrent threads.
   ///
   /// Calls the \c functor on several threads. This is the function used in the
@@ -17,12 +17,15 @@
 #define __dax_cont_internal_DeviceAdapterAlgorithmGeneral_h
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompositeVector.h>
+#include <dax/cont/ArrayHandleConcatenate.h>
 #include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/internal/ArrayHandleZip.h>
 
 #include <dax/Functional.h>
+#include <dax/Pair.h>
 
 #include <dax/exec/Assert.h>
 #include <dax/exec/internal/ErrorMessageBuffer.h>
@@ -166,6 +169,87 @@ public:
     DerivedAlgorithm::Schedule(kernel, arraySize);
   }
 
+  /// Copies a concatenated array one half at a time into the matching range
+  /// of the output, so the copy never has to check which half an index is in.
+  ///
+  template<typename T,
+           class FirstArrayHandleType,
+           class SecondArrayHandleType,
+           class COut>
+  DAX_CONT_EXPORT static void Copy(
+      const dax::cont::ArrayHandle<
+        T,
+        dax::cont::internal::ArrayContainerControlTagConcatenate<
+          FirstArrayHandleType,SecondArrayHandleType>,
+        DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T, COut, DeviceAdapterTag> &output)
+  {
+    typedef typename dax::cont::ArrayHandle<
+        T,
+        dax::cont::internal::ArrayContainerControlTagConcatenate<
+          FirstArrayHandleType,SecondArrayHandleType>,
+        DeviceAdapterTag>::PortalConstExecution InputPortalType;
+    typedef typename dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>
+        ::PortalExecution OutputPortalType;
+
+    dax::Id arraySize = input.GetNumberOfValues();
+
+    InputPortalType inputPortal = input.PrepareForInput();
+    OutputPortalType outputPortal = output.PrepareForOutput(arraySize);
+
+    dax::Id firstSize = inputPortal.GetFirstPortal().GetNumberOfValues();
+
+    CopyKernel<typename InputPortalType::FirstPortalType, OutputPortalType>
+        firstKernel(inputPortal.GetFirstPortal(), outputPortal);
+    DerivedAlgorithm::Schedule(firstKernel, firstSize);
+
+    CopyKernel<typename InputPortalType::SecondPortalType, OutputPortalType>
+        secondKernel(inputPortal.GetSecondPortal(), outputPortal, 0, firstSize);
+    DerivedAlgorithm::Schedule(secondKernel, arraySize - firstSize);
+  }
+
+  /// Copies one composite vector array into another one component array at a
+  /// time, so the components are never interleaved.
+  ///
+  template<typename T,
+           int NUM_COMPONENTS,
+           class InputComponentArrayHandleType,
+           class OutputComponentArrayHandleType>
+  DAX_CONT_EXPORT static void Copy(
+      const dax::cont::ArrayHandle<
+        dax::Tuple<T,NUM_COMPONENTS>,
+        dax::cont::internal::ArrayContainerControlTagCompositeVector<
+          InputComponentArrayHandleType,NUM_COMPONENTS>,
+        DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<
+        dax::Tuple<T,NUM_COMPONENTS>,
+        dax::cont::internal::ArrayContainerControlTagCompositeVector<
+          OutputComponentArrayHandleType,NUM_COMPONENTS>,
+        DeviceAdapterTag> &output)
+  {
+    typedef typename InputComponentArrayHandleType::PortalConstExecution
+        InputComponentPortalType;
+    typedef typename OutputComponentArrayHandleType::PortalExecution
+        OutputComponentPortalType;
+
+    dax::Id arraySize = input.GetNumberOfValues();
+
+    dax::cont::internal::ArrayPortalCompositeVector<
+        InputComponentPortalType,NUM_COMPONENTS> inputPortal =
+          input.PrepareForInput();
+    dax::cont::internal::ArrayPortalCompositeVector<
+        OutputComponentPortalType,NUM_COMPONENTS> outputPortal =
+          output.PrepareForOutput(arraySize);
+
+    for (int component = 0; component < NUM_COMPONENTS; component++)
+      {
+      CopyKernel<InputComponentPortalType, OutputComponentPortalType>
+          kernel(inputPortal.GetComponentPortal(component),
+                 outputPortal.GetComponentPortal(component));
+      DerivedAlgorithm::Schedule(kernel, arraySize);
+      }
+  }
+
   //--------------------------------------------------------------------------
   // Lower Bounds
 private:
@@ -373,17 +457,22 @@ public:
   //--------------------------------------------------------------------------
   // Scan Inclusive
 private:
-  template<typename PortalType>
+  template<typename PortalType, typename BinaryFunctor>
   struct ScanKernel : dax::exec::internal::WorkletBase
   {
     PortalType Portal;
+    BinaryFunctor BinaryOperator;
     dax::Id Stride;
     dax::Id Offset;
     dax::Id Distance;
 
     DAX_CONT_EXPORT
-    ScanKernel(const PortalType &portal, dax::Id stride, dax::Id offset)
+    ScanKernel(const PortalType &portal,
+               BinaryFunctor binaryOperator,
+               dax::Id stride,
+               dax::Id offset)
       : Portal(portal),
+        BinaryOperator(binaryOperator),
         Stride(stride),
         Offset(offset),
         Distance(stride/2)
@@ -403,7 +492,8 @@ private:
         {
         ValueType leftValue = this->Portal.Get(leftIndex);
         ValueType rightValue = this->Portal.Get(rightIndex);
-        this->Portal.Set(rightIndex, leftValue+rightValue);
+        this->Portal.Set(rightIndex,
+                         this->BinaryOperator(leftValue, rightValue));
         }
     }
   };
@@ -413,6 +503,15 @@ public:
   DAX_CONT_EXPORT static T ScanInclusive(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
       dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output)
+  {
+    return DerivedAlgorithm::ScanInclusive(input, output, dax::Add());
+  }
+
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output,
+      BinaryFunctor binaryOperator)
   {
     typedef typename
         dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>::PortalExecution
@@ -423,7 +522,7 @@ public:
     dax::Id numValues = output.GetNumberOfValues();
     if (numValues < 1)
       {
-      return 0;
+      return T();
       }
 
     PortalType portal = output.PrepareForInPlace();
@@ -431,20 +530,168 @@ public:
     dax::Id stride;
     for (stride = 2; stride-1 < numValues; stride *= 2)
       {
-      ScanKernel<PortalType> kernel(portal, stride, stride/2 - 1);
+      ScanKernel<PortalType,BinaryFunctor>
+          kernel(portal, binaryOperator, stride, stride/2 - 1);
       DerivedAlgorithm::Schedule(kernel, numValues/stride);
       }
 
     // Do reverse operation on odd indices. Start at stride we were just at.
     for (stride /= 2; stride > 1; stride /= 2)
       {
-      ScanKernel<PortalType> kernel(portal, stride, stride - 1);
+      ScanKernel<PortalType,BinaryFunctor>
+          kernel(portal, binaryOperator, stride, stride - 1);
       DerivedAlgorithm::Schedule(kernel, numValues/stride);
       }
 
     return GetExecutionValue(output, numValues-1);
   }
 
+  //--------------------------------------------------------------------------
+  // Scan By Key
+private:
+  // A segmented sum is an ordinary scan over (segment start flag, value)
+  // pairs with this operator, which restarts the sum at every flagged value.
+  struct SegmentedAddFunctor
+  {
+    template<typename T>
+    DAX_EXEC_EXPORT
+    dax::Pair<dax::Id,T> operator()(const dax::Pair<dax::Id,T> &left,
+                                    const dax::Pair<dax::Id,T> &right) const
+    {
+      if (right.first)
+        {
+        return right;
+        }
+      return dax::make_Pair(left.first, T(left.second + right.second));
+    }
+  };
+
+  template<class KeysPortalType, class ValuesPortalType, class PairPortalType>
+  struct FlagSegmentsKernel : dax::exec::internal::WorkletBase
+  {
+    KeysPortalType KeysPortal;
+    ValuesPortalType ValuesPortal;
+    PairPortalType PairPortal;
+
+    DAX_CONT_EXPORT
+    FlagSegmentsKernel(const KeysPortalType &keysPortal,
+                       const ValuesPortalType &valuesPortal,
+                       const PairPortalType &pairPortal)
+      : KeysPortal(keysPortal),
+        ValuesPortal(valuesPortal),
+        PairPortal(pairPortal) {  }
+
+    DAX_EXEC_EXPORT
+    void operator()(dax::Id index) const {
+      const bool segmentStart = (index == 0) ||
+          !(this->KeysPortal.Get(index-1) == this->KeysPortal.Get(index));
+      this->PairPortal.Set(index,
+                           dax::make_Pair(dax::Id(segmentStart ? 1 : 0),
+                                          this->ValuesPortal.Get(index)));
+    }
+  };
+
+  // The flags are or-ed together by the scan, so segment starts are found
+  // from the keys again.
+  template<class KeysPortalType, class PairPortalType, class OutputPortalType>
+  struct UnflagSegmentsKernel : dax::exec::internal::WorkletBase
+  {
+    KeysPortalType KeysPortal;
+    PairPortalType PairPortal;
+    OutputPortalType OutputPortal;
+    bool Exclusive;
+
+    DAX_CONT_EXPORT
+    UnflagSegmentsKernel(const KeysPortalType &keysPortal,
+                         const PairPortalType &pairPortal,
+                         const OutputPortalType &outputPortal,
+                         bool exclusive)
+      : KeysPortal(keysPortal),
+        PairPortal(pairPortal),
+        OutputPortal(outputPortal),
+        Exclusive(exclusive) {  }
+
+    DAX_EXEC_EXPORT
+    void operator()(dax::Id index) const {
+      typedef typename OutputPortalType::ValueType ValueType;
+      if (!this->Exclusive)
+        {
+        this->OutputPortal.Set(index, this->PairPortal.Get(index).second);
+        }
+      else if ((index == 0) ||
+               !(this->KeysPortal.Get(index-1) == this->KeysPortal.Get(index)))
+        {
+        this->OutputPortal.Set(index, ValueType(0));
+        }
+      else
+        {
+        this->OutputPortal.Set(index, this->PairPortal.Get(index-1).second);
+        }
+    }
+  };
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanByKeyGeneral(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output,
+      bool exclusive)
+  {
+    typedef dax::cont::ArrayHandle<dax::Pair<dax::Id,U>,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> PairArrayType;
+    typedef typename dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag>
+        ::PortalConstExecution KeysPortalType;
+    typedef typename dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag>
+        ::PortalConstExecution ValuesPortalType;
+    typedef typename dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag>
+        ::PortalExecution OutputPortalType;
+
+    const dax::Id numValues = values.GetNumberOfValues();
+    DAX_ASSERT_CONT(keys.GetNumberOfValues() == numValues);
+
+    PairArrayType pairs;
+    DerivedAlgorithm::Schedule(
+          FlagSegmentsKernel<KeysPortalType,
+                             ValuesPortalType,
+                             typename PairArrayType::PortalExecution>(
+            keys.PrepareForInput(),
+            values.PrepareForInput(),
+            pairs.PrepareForOutput(numValues)),
+          numValues);
+
+    DerivedAlgorithm::ScanInclusive(pairs, pairs, SegmentedAddFunctor());
+
+    DerivedAlgorithm::Schedule(
+          UnflagSegmentsKernel<KeysPortalType,
+                               typename PairArrayType::PortalConstExecution,
+                               OutputPortalType>(
+            keys.PrepareForInput(),
+            pairs.PrepareForInput(),
+            output.PrepareForOutput(numValues),
+            exclusive),
+          numValues);
+  }
+
+public:
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanInclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output)
+  {
+    ScanByKeyGeneral(keys, values, output, false);
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanExclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output)
+  {
+    ScanByKeyGeneral(keys, values, output, true);
+  }
+
   //--------------------------------------------------------------------------
   // Sort
 private:
@@ -761,12 +1008,6 @@ public:
       const dax::cont::ArrayHandle<T,CStencil,DeviceAdapterTag> &stencil,
       dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &output)
   {
-    DerivedAlgorithm::StreamCompact(
-          dax::cont::make_ArrayHandleCounting(dax::Id(0),
-                                              stencil.GetNumberOfValues(),
-                                              DeviceAdapterTag()),
-          stencil,
-          output);
     typedef dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>
         CountingHandleType;
 
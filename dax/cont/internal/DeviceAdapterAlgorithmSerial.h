@@ -17,6 +17,7 @@
 #define __dax_cont_internal_DeviceAdapterAlgorithmSerial_h
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
 #include <dax/cont/ErrorExecution.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithm.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithmGeneral.h>
@@ -98,6 +99,95 @@ public:
     return fullSum;
   }
 
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTagSerial>& output,
+      BinaryFunctor binaryOperator)
+  {
+    typedef typename dax::cont::ArrayHandle<T,COut,DeviceAdapterTagSerial>
+        ::PortalExecution PortalOut;
+    typedef typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>
+        ::PortalConstExecution PortalIn;
+
+    dax::Id numberOfValues = input.GetNumberOfValues();
+
+    PortalIn inputPortal = input.PrepareForInput();
+    PortalOut outputPortal = output.PrepareForOutput(numberOfValues);
+
+    if (numberOfValues <= 0) { return T(); }
+
+    std::partial_sum(inputPortal.GetIteratorBegin(),
+                     inputPortal.GetIteratorEnd(),
+                     outputPortal.GetIteratorBegin(),
+                     binaryOperator);
+
+    return outputPortal.Get(numberOfValues - 1);
+  }
+
+private:
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanByKeySerial(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTagSerial> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTagSerial> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTagSerial> &output,
+      bool exclusive)
+  {
+    typedef typename dax::cont::ArrayHandle<T,KIn,DeviceAdapterTagSerial>
+        ::PortalConstExecution KeysPortalType;
+    typedef typename dax::cont::ArrayHandle<U,VIn,DeviceAdapterTagSerial>
+        ::PortalConstExecution ValuesPortalType;
+    typedef typename dax::cont::ArrayHandle<U,VOut,DeviceAdapterTagSerial>
+        ::PortalExecution OutputPortalType;
+
+    const dax::Id numberOfValues = values.GetNumberOfValues();
+    DAX_ASSERT_CONT(keys.GetNumberOfValues() == numberOfValues);
+
+    KeysPortalType keysPortal = keys.PrepareForInput();
+    ValuesPortalType valuesPortal = values.PrepareForInput();
+    OutputPortalType outputPortal = output.PrepareForOutput(numberOfValues);
+
+    U sum = U(0);
+    for (dax::Id index = 0; index < numberOfValues; index++)
+      {
+      if ((index > 0) && !(keysPortal.Get(index-1) == keysPortal.Get(index)))
+        {
+        sum = U(0);
+        }
+      // The output may be the same array as the values.
+      const U value = valuesPortal.Get(index);
+      if (exclusive)
+        {
+        outputPortal.Set(index, sum);
+        sum = sum + value;
+        }
+      else
+        {
+        sum = sum + value;
+        outputPortal.Set(index, sum);
+        }
+      }
+  }
+
+public:
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanInclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTagSerial> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTagSerial> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTagSerial> &output)
+  {
+    ScanByKeySerial(keys, values, output, false);
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanExclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTagSerial> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTagSerial> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTagSerial> &output)
+  {
+    ScanByKeySerial(keys, values, output, true);
+  }
+
 private:
   // This runs in the execution environment.
   template<class FunctorType>
@@ -0,0 +1,264 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_io_LegacyVTKWriter_h
+#define __dax_cont_io_LegacyVTKWriter_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/io/internal/ArrayWriter.h>
+
+#include <ostream>
+#include <string>
+
+namespace dax {
+namespace cont {
+namespace io {
+
+namespace internal {
+
+template<class CellTag> struct VTKCellType;
+template<> struct VTKCellType<dax::CellTagVertex>        { enum { Id = 1 }; };
+template<> struct VTKCellType<dax::CellTagLine>          { enum { Id = 3 }; };
+template<> struct VTKCellType<dax::CellTagTriangle>      { enum { Id = 5 }; };
+template<> struct VTKCellType<dax::CellTagQuadrilateral> { enum { Id = 9 }; };
+template<> struct VTKCellType<dax::CellTagTetrahedron>   { enum { Id = 10 }; };
+template<> struct VTKCellType<dax::CellTagVoxel>         { enum { Id = 11 }; };
+template<> struct VTKCellType<dax::CellTagHexahedron>    { enum { Id = 12 }; };
+template<> struct VTKCellType<dax::CellTagWedge>         { enum { Id = 13 }; };
+
+template<typename T> struct VTKDataTypeName;
+#define DAX_VTK_DATA_TYPE_NAME(type, name) \
+  template<> struct VTKDataTypeName<type> { \
+    static const char *Get() { return name; } \
+  }
+DAX_VTK_DATA_TYPE_NAME(float, "float");
+DAX_VTK_DATA_TYPE_NAME(double, "double");
+DAX_VTK_DATA_TYPE_NAME(char, "char");
+DAX_VTK_DATA_TYPE_NAME(unsigned char, "unsigned_char");
+DAX_VTK_DATA_TYPE_NAME(short, "short");
+DAX_VTK_DATA_TYPE_NAME(unsigned short, "unsigned_short");
+DAX_VTK_DATA_TYPE_NAME(dax::internal::Int32Type, "int");
+DAX_VTK_DATA_TYPE_NAME(dax::internal::UInt32Type, "unsigned_int");
+DAX_VTK_DATA_TYPE_NAME(dax::internal::Int64Type, "vtktypeint64");
+DAX_VTK_DATA_TYPE_NAME(dax::internal::UInt64Type, "vtktypeuint64");
+#undef DAX_VTK_DATA_TYPE_NAME
+
+} // namespace internal
+
+/// \brief Writes grids and fields in the binary legacy VTK file format.
+///
+/// Write the grid first with \c WriteGrid, then any number of point and cell
+/// fields. Scalar fields are written as SCALARS, fields with three components
+/// as VECTORS. Unstructured grid connections are written as 32 bit ids, which
+/// is what the legacy format requires.
+///
+/// All binary data is converted to big-endian on the device in bounded chunks
+/// and written from the converted chunks with large writes. The stream must
+/// be opened in binary mode.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class LegacyVTKWriter
+{
+public:
+  DAX_CONT_EXPORT
+  LegacyVTKWriter(std::ostream &stream,
+                  const std::string &title = "dax output")
+    : Stream(&stream),
+      Title(title),
+      NumberOfPoints(0),
+      NumberOfCells(0),
+      CurrentSection(SECTION_NONE) {  }
+
+  DAX_CONT_EXPORT
+  void WriteGrid(const dax::cont::UniformGrid<DeviceAdapterTag> &grid)
+  {
+    this->WriteHeader("STRUCTURED_POINTS");
+
+    const dax::Id3 dimensions = dax::extentDimensions(grid.GetExtent());
+    const dax::Vector3 origin =
+        grid.ComputePointCoordinates(grid.GetExtent().Min);
+    const dax::Vector3 spacing = grid.GetSpacing();
+
+    std::ostream &stream = *this->Stream;
+    const std::streamsize oldPrecision = stream.precision(17);
+    stream << "DIMENSIONS " << dimensions[0] << " " << dimensions[1] << " "
+           << dimensions[2] << "\n";
+    stream << "ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2]
+           << "\n";
+    stream << "SPACING " << spacing[0] << " " << spacing[1] << " "
+           << spacing[2] << "\n";
+    stream.precision(oldPrecision);
+
+    this->NumberOfPoints = grid.GetNumberOfPoints();
+    this->NumberOfCells = grid.GetNumberOfCells();
+    dax::cont::io::internal::CheckStream(stream);
+  }
+
+  template<class CellTag, class CellContainerTag, class PointContainerTag>
+  DAX_CONT_EXPORT
+  void WriteGrid(const dax::cont::UnstructuredGrid<CellTag,
+                                                   CellContainerTag,
+                                                   PointContainerTag,
+                                                   DeviceAdapterTag> &grid)
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+
+    this->WriteHeader("UNSTRUCTURED_GRID");
+    std::ostream &stream = *this->Stream;
+
+    this->NumberOfPoints = grid.GetNumberOfPoints();
+    stream << "POINTS " << this->NumberOfPoints << " "
+           << internal::VTKDataTypeName<dax::Scalar>::Get() << "\n";
+    dax::cont::io::internal::WriteArrayBigEndian(stream,
+                                                 grid.GetPointCoordinates());
+    stream << "\n";
+
+    this->NumberOfCells = grid.GetNumberOfCells();
+    stream << "CELLS " << this->NumberOfCells << " "
+           << this->NumberOfCells*(NUM_VERTICES+1) << "\n";
+    dax::cont::io::internal::WriteVTKCellsBigEndian(stream,
+                                                    grid.GetCellConnections(),
+                                                    NUM_VERTICES);
+    stream << "\n";
+
+    stream << "CELL_TYPES " << this->NumberOfCells << "\n";
+    dax::cont::io::internal::WriteConstantBigEndian(
+          stream,
+          internal::VTKCellType<CellTag>::Id,
+          this->NumberOfCells);
+    stream << "\n";
+    dax::cont::io::internal::CheckStream(stream);
+  }
+
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void WritePointField(
+      const std::string &name,
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field)
+  {
+    this->WriteField(SECTION_POINT_DATA,
+                     "POINT_DATA",
+                     this->NumberOfPoints,
+                     name,
+                     field);
+  }
+
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void WriteCellField(
+      const std::string &name,
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field)
+  {
+    this->WriteField(SECTION_CELL_DATA,
+                     "CELL_DATA",
+                     this->NumberOfCells,
+                     name,
+                     field);
+  }
+
+private:
+  enum SectionType {
+    SECTION_NONE,
+    SECTION_GRID,
+    SECTION_POINT_DATA,
+    SECTION_CELL_DATA
+  };
+
+  DAX_CONT_EXPORT
+  void WriteHeader(const char *datasetType)
+  {
+    if (this->CurrentSection != SECTION_NONE)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "A legacy VTK file can only contain one grid.");
+      }
+    std::ostream &stream = *this->Stream;
+    stream << "# vtk DataFile Version 3.0\n";
+    stream << this->Title << "\n";
+    stream << "BINARY\n";
+    stream << "DATASET " << datasetType << "\n";
+    this->CurrentSection = SECTION_GRID;
+  }
+
+  template<typename T, class Container>
+  DAX_CONT_EXPORT
+  void WriteField(
+      SectionType section,
+      const char *sectionName,
+      dax::Id numberOfValues,
+      const std::string &name,
+      const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &field)
+  {
+    typedef dax::VectorTraits<T> Traits;
+    typedef typename Traits::ComponentType ComponentType;
+
+    if (this->CurrentSection == SECTION_NONE)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The grid must be written before any fields.");
+      }
+    if (field.GetNumberOfValues() != numberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Field size does not match the grid.");
+      }
+
+    std::ostream &stream = *this->Stream;
+    if (this->CurrentSection != section)
+      {
+      stream << sectionName << " " << numberOfValues << "\n";
+      this->CurrentSection = section;
+      }
+
+    if (Traits::NUM_COMPONENTS == 3)
+      {
+      stream << "VECTORS " << name << " "
+             << internal::VTKDataTypeName<ComponentType>::Get() << "\n";
+      }
+    else
+      {
+      stream << "SCALARS " << name << " "
+             << internal::VTKDataTypeName<ComponentType>::Get() << " "
+             << Traits::NUM_COMPONENTS << "\n";
+      stream << "LOOKUP_TABLE default\n";
+      }
+    dax::cont::io::internal::WriteArrayBigEndian(stream, field);
+    stream << "\n";
+    dax::cont::io::internal::CheckStream(stream);
+  }
+
+  std::ostream *Stream;
+  std::string Title;
+  dax::Id NumberOfPoints;
+  dax::Id NumberOfCells;
+  SectionType CurrentSection;
+};
+
+}
+}
+} // namespace dax::cont::io
+
+#endif //__dax_cont_io_LegacyVTKWriter_h
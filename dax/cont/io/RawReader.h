@@ -0,0 +1,97 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_io_RawReader_h
+#define __dax_cont_io_RawReader_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ReductionMap.h>
+
+#include <istream>
+#include <vector>
+
+namespace dax {
+namespace cont {
+namespace io {
+
+/// Reads \p numValues values written by WriteRaw (native byte order) from
+/// \p stream into \p handle. The stream should be opened in binary mode.
+///
+template<typename T, class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void ReadRaw(std::istream &stream,
+             dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &handle,
+             dax::Id numValues)
+{
+  std::vector<T> buffer(numValues);
+  if (numValues > 0)
+    {
+    stream.read(reinterpret_cast<char *>(&buffer[0]), numValues*sizeof(T));
+    }
+  if (!stream)
+    {
+    throw dax::cont::ErrorControlBadValue("Error reading from stream.");
+    }
+
+  // An array handle made from the buffer only points to it, so copy the
+  // values into the output before the buffer goes out of scope.
+  dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+        dax::cont::make_ArrayHandle(buffer,
+                                    dax::cont::ArrayContainerControlTagBasic(),
+                                    DeviceAdapterTag()),
+        handle);
+}
+
+/// Reads a reduction map written by WriteRaw. The returned map is already
+/// built and does not hold the original keys.
+///
+template<class KeysHandleType>
+DAX_CONT_EXPORT
+void ReadRaw(std::istream &stream,
+             dax::cont::ReductionMap<KeysHandleType> &map)
+{
+  typedef dax::cont::ReductionMap<KeysHandleType> MapType;
+
+  dax::Id sizes[2];
+  stream.read(reinterpret_cast<char *>(sizes), sizeof(sizes));
+  if (!stream || (sizes[0] < 0) || (sizes[1] < 0))
+    {
+    throw dax::cont::ErrorControlBadValue("Bad reduction map header.");
+    }
+  const dax::Id numGroups = sizes[0];
+  const dax::Id numValues = sizes[1];
+
+  KeysHandleType keys;
+  typename MapType::IndexArrayType counts;
+  typename MapType::IndexArrayType offsets;
+  typename MapType::IndexArrayType indices;
+  dax::cont::io::ReadRaw(stream, keys, numGroups);
+  dax::cont::io::ReadRaw(stream, counts, numGroups);
+  dax::cont::io::ReadRaw(stream, offsets, numGroups);
+  dax::cont::io::ReadRaw(stream, indices, numValues);
+
+  map = MapType(counts, offsets, indices, keys);
+}
+
+}
+}
+} // namespace dax::cont::io
+
+#endif //__dax_cont_io_RawReader_h
@@ -0,0 +1,114 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_io_RawWriter_h
+#define __dax_cont_io_RawWriter_h
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ReductionMap.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/io/internal/ArrayWriter.h>
+
+#include <ostream>
+
+namespace dax {
+namespace cont {
+namespace io {
+
+/// Writes the values of \p handle to \p stream as raw binary in the native
+/// byte order of the host. The values are written straight from the control
+/// portal. The stream should be opened in binary mode.
+///
+template<typename T, class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteRaw(std::ostream &stream,
+              const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &handle)
+{
+  dax::cont::io::internal::WritePortal(stream, handle.GetPortalConstControl());
+}
+
+/// Writes the values of \p handle to \p stream as raw binary with each
+/// component in big-endian byte order.
+///
+template<typename T, class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteRawBigEndian(
+    std::ostream &stream,
+    const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &handle)
+{
+  dax::cont::io::internal::WriteArrayBigEndian(stream, handle);
+}
+
+/// Writes the point coordinates of a uniform grid as raw binary in native
+/// byte order.
+///
+template<class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteRaw(std::ostream &stream,
+              const dax::cont::UniformGrid<DeviceAdapterTag> &grid)
+{
+  dax::cont::io::WriteRaw(stream, grid.GetPointCoordinates());
+}
+
+/// Writes the point coordinates followed by the cell connections of an
+/// unstructured grid as raw binary in native byte order.
+///
+template<class CellTag,
+         class CellContainerTag,
+         class PointContainerTag,
+         class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteRaw(std::ostream &stream,
+              const dax::cont::UnstructuredGrid<CellTag,
+                                                CellContainerTag,
+                                                PointContainerTag,
+                                                DeviceAdapterTag> &grid)
+{
+  dax::cont::io::WriteRaw(stream, grid.GetPointCoordinates());
+  dax::cont::io::WriteRaw(stream, grid.GetCellConnections());
+}
+
+/// Writes a reduction map as raw binary in native byte order: the number of
+/// groups and the number of values (as dax::Id), then the reduction keys,
+/// counts, offsets and indices. The map is built first if necessary. Read it
+/// back with dax::cont::io::ReadRaw.
+///
+template<class KeysHandleType>
+DAX_CONT_EXPORT
+void WriteRaw(std::ostream &stream,
+              const dax::cont::ReductionMap<KeysHandleType> &map)
+{
+  // Copies share the map, so building the copy builds the original.
+  dax::cont::ReductionMap<KeysHandleType> reductionMap = map;
+  const dax::Id sizes[2] = {
+    reductionMap.GetReductionCounts().GetNumberOfValues(),
+    reductionMap.GetReductionIndices().GetNumberOfValues()
+  };
+  stream.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+  dax::cont::io::internal::CheckStream(stream);
+
+  dax::cont::io::WriteRaw(stream, reductionMap.GetReductionKeys());
+  dax::cont::io::WriteRaw(stream, reductionMap.GetReductionCounts());
+  dax::cont::io::WriteRaw(stream, reductionMap.GetReductionOffsets());
+  dax::cont::io::WriteRaw(stream, reductionMap.GetReductionIndices());
+}
+
+}
+}
+} // namespace dax::cont::io
+
+#endif //__dax_cont_io_RawWriter_h
@@ -0,0 +1,232 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_io_internal_ArrayWriter_h
+#define __dax_cont_io_internal_ArrayWriter_h
+
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+
+#include <dax/exec/internal/kernel/ByteSwapWorklets.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace dax {
+namespace cont {
+namespace io {
+namespace internal {
+
+/// The number of values converted and written at a time. Big enough to keep
+/// writes large, small enough to keep the staging buffer bounded.
+///
+const dax::Id WriteChunkSize = 1 << 20;
+
+DAX_CONT_EXPORT
+bool IsHostBigEndian()
+{
+  const boost::uint16_t one = 1;
+  return *reinterpret_cast<const unsigned char *>(&one) == 0;
+}
+
+template<std::size_t Size> struct UnsignedWord;
+template<> struct UnsignedWord<1> { typedef boost::uint8_t type; };
+template<> struct UnsignedWord<2> { typedef boost::uint16_t type; };
+template<> struct UnsignedWord<4> { typedef boost::uint32_t type; };
+template<> struct UnsignedWord<8> { typedef boost::uint64_t type; };
+
+DAX_CONT_EXPORT
+void CheckStream(const std::ostream &stream)
+{
+  if (!stream)
+    {
+    throw dax::cont::ErrorControlBadValue("Error writing to stream.");
+    }
+}
+
+template<class PortalType>
+DAX_CONT_EXPORT
+void WritePortalValues(std::ostream &stream,
+                       const PortalType &portal,
+                       boost::true_type /*IsPointer*/)
+{
+  typedef typename PortalType::ValueType ValueType;
+  stream.write(reinterpret_cast<const char *>(portal.GetIteratorBegin()),
+               portal.GetNumberOfValues()*sizeof(ValueType));
+}
+
+template<class PortalType>
+DAX_CONT_EXPORT
+void WritePortalValues(std::ostream &stream,
+                       const PortalType &portal,
+                       boost::false_type /*IsPointer*/)
+{
+  // The portal does not point to memory (for example an implicit array), so
+  // stage the values one chunk at a time.
+  typedef typename PortalType::ValueType ValueType;
+  const dax::Id numValues = portal.GetNumberOfValues();
+  std::vector<ValueType> buffer(std::min(numValues, WriteChunkSize));
+  typename PortalType::IteratorType iter = portal.GetIteratorBegin();
+  for (dax::Id offset = 0; offset < numValues; offset += WriteChunkSize)
+    {
+    const dax::Id chunkSize = std::min(WriteChunkSize, numValues - offset);
+    std::copy(iter + offset, iter + offset + chunkSize, buffer.begin());
+    stream.write(reinterpret_cast<const char *>(&buffer[0]),
+                 chunkSize*sizeof(ValueType));
+    }
+}
+
+/// Writes the values of a control portal in native byte order. When the
+/// portal iterates over contiguous memory, the values are written with a
+/// single call straight from that memory.
+///
+template<class PortalType>
+DAX_CONT_EXPORT
+void WritePortal(std::ostream &stream, const PortalType &portal)
+{
+  typedef typename PortalType::ValueType ValueType;
+  typedef dax::VectorTraits<ValueType> Traits;
+  BOOST_STATIC_ASSERT(sizeof(ValueType) ==
+                      Traits::NUM_COMPONENTS*sizeof(typename Traits::ComponentType));
+
+  if (portal.GetNumberOfValues() < 1) { return; }
+  WritePortalValues(
+        stream,
+        portal,
+        typename boost::is_pointer<typename PortalType::IteratorType>::type());
+  CheckStream(stream);
+}
+
+/// Writes the values of an array handle with big-endian components.
+///
+/// On little-endian hosts the array is converted one chunk at a time with a
+/// scheduled kernel on the device, and each converted chunk is written with
+/// one call from its control portal.
+///
+template<typename T, class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteArrayBigEndian(
+    std::ostream &stream,
+    const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &handle)
+{
+  if (IsHostBigEndian())
+    {
+    WritePortal(stream, handle.GetPortalConstControl());
+    return;
+    }
+
+  typedef dax::VectorTraits<T> Traits;
+  typedef typename UnsignedWord<
+      sizeof(typename Traits::ComponentType)>::type WordType;
+  typedef dax::cont::ArrayHandle<WordType,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> BufferType;
+  typedef typename dax::cont::ArrayHandle<
+      T,Container,DeviceAdapterTag>::PortalConstExecution InPortalType;
+  typedef dax::exec::internal::kernel::ByteSwapValues<
+      InPortalType, typename BufferType::PortalExecution> KernelType;
+
+  const dax::Id numValues = handle.GetNumberOfValues();
+  if (numValues < 1) { return; }
+
+  InPortalType values = handle.PrepareForInput();
+  BufferType buffer;
+  for (dax::Id offset = 0; offset < numValues; offset += WriteChunkSize)
+    {
+    const dax::Id chunkSize = std::min(WriteChunkSize, numValues - offset);
+    KernelType kernel(values,
+                      buffer.PrepareForOutput(chunkSize*Traits::NUM_COMPONENTS),
+                      offset,
+                      true);
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(kernel,
+                                                                  chunkSize);
+    WritePortal(stream, buffer.GetPortalConstControl());
+    }
+}
+
+/// Writes cell connections as the body of a legacy VTK CELLS section (big
+/// endian 32 bit words with the vertex count in front of every cell).
+///
+template<class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void WriteVTKCellsBigEndian(
+    std::ostream &stream,
+    const dax::cont::ArrayHandle<dax::Id,Container,DeviceAdapterTag> &connections,
+    int numberOfVertices)
+{
+  typedef dax::cont::ArrayHandle<boost::uint32_t,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> BufferType;
+  typedef typename dax::cont::ArrayHandle<
+      dax::Id,Container,DeviceAdapterTag>::PortalConstExecution InPortalType;
+  typedef dax::exec::internal::kernel::ByteSwapVTKCells<
+      InPortalType, typename BufferType::PortalExecution> KernelType;
+
+  const dax::Id numCells = connections.GetNumberOfValues()/numberOfVertices;
+  if (numCells < 1) { return; }
+
+  InPortalType values = connections.PrepareForInput();
+  BufferType buffer;
+  for (dax::Id offset = 0; offset < numCells; offset += WriteChunkSize)
+    {
+    const dax::Id chunkSize = std::min(WriteChunkSize, numCells - offset);
+    KernelType kernel(values,
+                      buffer.PrepareForOutput(chunkSize*(numberOfVertices+1)),
+                      offset,
+                      numberOfVertices,
+                      !IsHostBigEndian());
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(kernel,
+                                                                  chunkSize);
+    WritePortal(stream, buffer.GetPortalConstControl());
+    }
+}
+
+/// Writes \p numberOfValues copies of a 32 bit big-endian word.
+///
+DAX_CONT_EXPORT
+void WriteConstantBigEndian(std::ostream &stream,
+                            boost::int32_t value,
+                            dax::Id numberOfValues)
+{
+  const boost::uint32_t word =
+      dax::exec::internal::kernel::ComponentToWord<boost::uint32_t>(
+        value, !IsHostBigEndian());
+  std::vector<boost::uint32_t> buffer(std::min(numberOfValues, WriteChunkSize),
+                                      word);
+  for (dax::Id offset = 0; offset < numberOfValues; offset += WriteChunkSize)
+    {
+    const dax::Id chunkSize = std::min(WriteChunkSize, numberOfValues - offset);
+    stream.write(reinterpret_cast<const char *>(&buffer[0]),
+                 chunkSize*sizeof(boost::uint32_t));
+    }
+  CheckStream(stream);
+}
+
+}
+}
+}
+} // namespace dax::cont::io::internal
+
+#endif //__dax_cont_io_internal_ArrayWriter_h
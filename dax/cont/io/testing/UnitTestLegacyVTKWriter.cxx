@@ -0,0 +1,192 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/io/LegacyVTKWriter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void CheckLine(std::istream &stream, const std::string &expected)
+{
+  std::string line;
+  std::getline(stream, line);
+  std::cout << line << std::endl;
+  DAX_TEST_ASSERT(line == expected, "Got unexpected line.");
+}
+
+template<typename T>
+T ReadBigEndian(std::istream &stream)
+{
+  char bytes[sizeof(T)];
+  stream.read(bytes, sizeof(T));
+  if (!dax::cont::io::internal::IsHostBigEndian())
+    {
+    std::reverse(bytes, bytes + sizeof(T));
+    }
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+void TestWriteUniformGrid()
+{
+  std::cout << "Writing uniform grid." << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(1, 0, 0), dax::make_Id3(3, 1, 1));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1, 2));
+
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (std::size_t index = 0; index < field.size(); index++)
+    {
+    field[index] = 0.25*index;
+    }
+
+  std::stringstream stream;
+  dax::cont::io::LegacyVTKWriter<> writer(stream, "uniform");
+  writer.WriteGrid(grid);
+  writer.WritePointField("field", dax::cont::make_ArrayHandle(field));
+
+  CheckLine(stream, "# vtk DataFile Version 3.0");
+  CheckLine(stream, "uniform");
+  CheckLine(stream, "BINARY");
+  CheckLine(stream, "DATASET STRUCTURED_POINTS");
+  CheckLine(stream, "DIMENSIONS 3 2 2");
+  CheckLine(stream, "ORIGIN 0.5 0 0");
+  CheckLine(stream, "SPACING 0.5 1 2");
+  CheckLine(stream, "POINT_DATA 12");
+  CheckLine(stream, "SCALARS field float 1");
+  CheckLine(stream, "LOOKUP_TABLE default");
+  for (std::size_t index = 0; index < field.size(); index++)
+    {
+    DAX_TEST_ASSERT(ReadBigEndian<dax::Scalar>(stream) == field[index],
+                    "Got bad field value.");
+    }
+  CheckLine(stream, "");
+  DAX_TEST_ASSERT(stream.peek() == std::char_traits<char>::eof(), "Extra data at end of file.");
+}
+
+void TestWriteUnstructuredGrid()
+{
+  std::cout << "Writing unstructured grid." << std::endl;
+  std::vector<dax::Vector3> points(5);
+  points[0] = dax::make_Vector3(0, 0, 0);
+  points[1] = dax::make_Vector3(1, 0, 0);
+  points[2] = dax::make_Vector3(0, 1, 0);
+  points[3] = dax::make_Vector3(0, 0, 1);
+  points[4] = dax::make_Vector3(1, 1, 1);
+  const dax::Id connectionsList[] = { 0, 1, 2, 3, 1, 2, 3, 4 };
+  std::vector<dax::Id> connections(connectionsList, connectionsList + 8);
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> grid(
+        dax::cont::make_ArrayHandle(connections),
+        dax::cont::make_ArrayHandle(points));
+
+  std::vector<dax::Vector3> cellField(2);
+  cellField[0] = dax::make_Vector3(1, 2, 3);
+  cellField[1] = dax::make_Vector3(4, 5, 6);
+
+  std::stringstream stream;
+  dax::cont::io::LegacyVTKWriter<> writer(stream);
+  writer.WriteGrid(grid);
+  writer.WriteCellField("vectors", dax::cont::make_ArrayHandle(cellField));
+
+  CheckLine(stream, "# vtk DataFile Version 3.0");
+  CheckLine(stream, "dax output");
+  CheckLine(stream, "BINARY");
+  CheckLine(stream, "DATASET UNSTRUCTURED_GRID");
+  CheckLine(stream, "POINTS 5 float");
+  for (std::size_t index = 0; index < points.size(); index++)
+    {
+    for (int component = 0; component < 3; component++)
+      {
+      DAX_TEST_ASSERT(ReadBigEndian<dax::Scalar>(stream)
+                      == points[index][component],
+                      "Got bad point coordinate.");
+      }
+    }
+  CheckLine(stream, "");
+  CheckLine(stream, "CELLS 2 10");
+  for (int cell = 0; cell < 2; cell++)
+    {
+    DAX_TEST_ASSERT(ReadBigEndian<boost::int32_t>(stream) == 4,
+                    "Bad number of cell vertices.");
+    for (int vertex = 0; vertex < 4; vertex++)
+      {
+      DAX_TEST_ASSERT(ReadBigEndian<boost::int32_t>(stream)
+                      == connections[4*cell + vertex],
+                      "Bad cell connection.");
+      }
+    }
+  CheckLine(stream, "");
+  CheckLine(stream, "CELL_TYPES 2");
+  for (int cell = 0; cell < 2; cell++)
+    {
+    DAX_TEST_ASSERT(ReadBigEndian<boost::int32_t>(stream) == 10,
+                    "Bad cell type.");
+    }
+  CheckLine(stream, "");
+  CheckLine(stream, "CELL_DATA 2");
+  CheckLine(stream, "VECTORS vectors float");
+  for (std::size_t index = 0; index < cellField.size(); index++)
+    {
+    for (int component = 0; component < 3; component++)
+      {
+      DAX_TEST_ASSERT(ReadBigEndian<dax::Scalar>(stream)
+                      == cellField[index][component],
+                      "Got bad cell field value.");
+      }
+    }
+  CheckLine(stream, "");
+  DAX_TEST_ASSERT(stream.peek() == std::char_traits<char>::eof(), "Extra data at end of file.");
+
+  std::cout << "Checking bad field size." << std::endl;
+  bool gotError = false;
+  try
+    {
+    writer.WritePointField("bad", dax::cont::make_ArrayHandle(cellField));
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Did not get error for bad field size.");
+}
+
+void TestLegacyVTKWriter()
+{
+  TestWriteUniformGrid();
+  TestWriteUnstructuredGrid();
+}
+
+} // anonymous namespace
+
+int UnitTestLegacyVTKWriter(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestLegacyVTKWriter);
+}
@@ -0,0 +1,111 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/io/RawReader.h>
+#include <dax/cont/io/RawWriter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ReductionMap.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <sstream>
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 10;
+
+template<class HandleType>
+std::vector<typename HandleType::ValueType> ToVector(const HandleType &handle)
+{
+  std::vector<typename HandleType::ValueType>
+      values(handle.GetNumberOfValues());
+  handle.CopyInto(values.begin());
+  return values;
+}
+
+void TestReadArray()
+{
+  std::cout << "Reading back an array." << std::endl;
+  std::vector<dax::Vector3> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = dax::make_Vector3(index, 0.5*index, -index);
+    }
+
+  std::stringstream stream;
+  dax::cont::io::WriteRaw(stream, dax::cont::make_ArrayHandle(values));
+
+  dax::cont::ArrayHandle<dax::Vector3> readHandle;
+  dax::cont::io::ReadRaw(stream, readHandle, ARRAY_SIZE);
+  DAX_TEST_ASSERT(ToVector(readHandle) == values, "Got bad values.");
+
+  std::cout << "Reading past the end of the stream." << std::endl;
+  try
+    {
+    dax::cont::io::ReadRaw(stream, readHandle, 1);
+    DAX_TEST_FAIL("Did not get an error reading past the end.");
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestReadReductionMap()
+{
+  std::cout << "Reading back a reduction map." << std::endl;
+  const dax::Id keyBuffer[ARRAY_SIZE] = { 3, 1, 3, 0, 7, 1, 3, 7, 0, 1 };
+  std::vector<dax::Id> keys(keyBuffer, keyBuffer+ARRAY_SIZE);
+
+  dax::cont::ReductionMap<> map(dax::cont::make_ArrayHandle(keys));
+
+  std::stringstream stream;
+  dax::cont::io::WriteRaw(stream, map);
+  DAX_TEST_ASSERT(map.IsValid(), "Writing did not build the map.");
+
+  dax::cont::ReductionMap<> readMap;
+  dax::cont::io::ReadRaw(stream, readMap);
+  DAX_TEST_ASSERT(readMap.IsValid(), "Read map not marked as built.");
+  DAX_TEST_ASSERT(ToVector(readMap.GetReductionKeys())
+                  == ToVector(map.GetReductionKeys()),
+                  "Got bad keys.");
+  DAX_TEST_ASSERT(ToVector(readMap.GetReductionCounts())
+                  == ToVector(map.GetReductionCounts()),
+                  "Got bad counts.");
+  DAX_TEST_ASSERT(ToVector(readMap.GetReductionOffsets())
+                  == ToVector(map.GetReductionOffsets()),
+                  "Got bad offsets.");
+  DAX_TEST_ASSERT(ToVector(readMap.GetReductionIndices())
+                  == ToVector(map.GetReductionIndices()),
+                  "Got bad indices.");
+}
+
+void TestRawReader()
+{
+  TestReadArray();
+  TestReadReductionMap();
+}
+
+} // anonymous namespace
+
+int UnitTestRawReader(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestRawReader);
+}
@@ -0,0 +1,158 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/io/RawWriter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 10;
+
+template<typename T>
+std::vector<T> ReadNative(const std::string &data, std::size_t offset, dax::Id size)
+{
+  DAX_TEST_ASSERT(data.size() >= offset + size*sizeof(T), "Not enough data.");
+  std::vector<T> values(size);
+  std::memcpy(&values[0], data.data() + offset, size*sizeof(T));
+  return values;
+}
+
+void TestWriteArray()
+{
+  std::cout << "Writing array in native byte order." << std::endl;
+  std::vector<dax::Vector3> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = dax::make_Vector3(index, 0.5*index, -index);
+    }
+
+  std::stringstream stream;
+  dax::cont::io::WriteRaw(stream, dax::cont::make_ArrayHandle(values));
+
+  const std::string data = stream.str();
+  DAX_TEST_ASSERT(data.size() == ARRAY_SIZE*sizeof(dax::Vector3),
+                  "Wrong number of bytes written.");
+  std::vector<dax::Vector3> readValues =
+      ReadNative<dax::Vector3>(data, 0, ARRAY_SIZE);
+  DAX_TEST_ASSERT(std::equal(values.begin(), values.end(), readValues.begin()),
+                  "Got bad values.");
+}
+
+void TestWriteBigEndian()
+{
+  std::cout << "Writing array in big-endian byte order." << std::endl;
+  // Use more than one chunk.
+  const dax::Id size = dax::cont::io::internal::WriteChunkSize + ARRAY_SIZE;
+
+  std::stringstream stream;
+  dax::cont::io::WriteRawBigEndian(
+        stream,
+        dax::cont::make_ArrayHandleCounting(dax::Id(0), size));
+
+  const std::string data = stream.str();
+  DAX_TEST_ASSERT(data.size() == size*sizeof(dax::Id),
+                  "Wrong number of bytes written.");
+  for (dax::Id index = 0; index < size; index++)
+    {
+    std::string bytes = data.substr(index*sizeof(dax::Id), sizeof(dax::Id));
+    if (!dax::cont::io::internal::IsHostBigEndian())
+      {
+      std::reverse(bytes.begin(), bytes.end());
+      }
+    dax::Id value;
+    std::memcpy(&value, bytes.data(), sizeof(dax::Id));
+    DAX_TEST_ASSERT(value == index, "Got bad value.");
+    }
+}
+
+void TestWriteGrids()
+{
+  std::cout << "Writing uniform grid." << std::endl;
+  dax::cont::UniformGrid<> uniform;
+  uniform.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(2, 1, 1));
+  uniform.SetOrigin(dax::make_Vector3(1, 2, 3));
+
+  std::stringstream uniformStream;
+  dax::cont::io::WriteRaw(uniformStream, uniform);
+  std::vector<dax::Vector3> coordinates =
+      ReadNative<dax::Vector3>(uniformStream.str(),
+                               0,
+                               uniform.GetNumberOfPoints());
+  DAX_TEST_ASSERT(uniformStream.str().size() ==
+                  uniform.GetNumberOfPoints()*sizeof(dax::Vector3),
+                  "Wrong number of bytes written.");
+  for (dax::Id index = 0; index < uniform.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(coordinates[index],
+                               uniform.ComputePointCoordinates(index)),
+                    "Got bad coordinates.");
+    }
+
+  std::cout << "Writing unstructured grid." << std::endl;
+  std::vector<dax::Vector3> points(4);
+  points[0] = dax::make_Vector3(0, 0, 0);
+  points[1] = dax::make_Vector3(1, 0, 0);
+  points[2] = dax::make_Vector3(0, 1, 0);
+  points[3] = dax::make_Vector3(0, 0, 1);
+  std::vector<dax::Id> connections(4);
+  for (dax::Id index = 0; index < 4; index++) { connections[index] = 3-index; }
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> unstructured(
+        dax::cont::make_ArrayHandle(connections),
+        dax::cont::make_ArrayHandle(points));
+
+  std::stringstream unstructuredStream;
+  dax::cont::io::WriteRaw(unstructuredStream, unstructured);
+  const std::string data = unstructuredStream.str();
+  DAX_TEST_ASSERT(data.size() == 4*sizeof(dax::Vector3) + 4*sizeof(dax::Id),
+                  "Wrong number of bytes written.");
+  std::vector<dax::Vector3> readPoints = ReadNative<dax::Vector3>(data, 0, 4);
+  std::vector<dax::Id> readConnections =
+      ReadNative<dax::Id>(data, 4*sizeof(dax::Vector3), 4);
+  DAX_TEST_ASSERT(std::equal(points.begin(), points.end(), readPoints.begin()),
+                  "Got bad points.");
+  DAX_TEST_ASSERT(std::equal(connections.begin(),
+                             connections.end(),
+                             readConnections.begin()),
+                  "Got bad connections.");
+}
+
+void TestRawWriter()
+{
+  TestWriteArray();
+  TestWriteBigEndian();
+  TestWriteGrids();
+}
+
+} // anonymous namespace
+
+int UnitTestRawWriter(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestRawWriter);
+}
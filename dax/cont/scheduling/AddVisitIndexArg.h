@@ -18,6 +18,7 @@
 
 #include <dax/Types.h>
 
+#include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/arg/Field.h>
 #include <dax/cont/sig/Arg.h>
 #include <dax/cont/sig/VisitIndex.h>
@@ -42,17 +43,20 @@ struct MakeVisitIndexControlType
   typedef HandleType Type;
 
   template<class Scheduler, typename OtherHandleType>
-  void operator()(Scheduler &scheduler,
+  void operator()(Scheduler &daxNotUsed(scheduler),
                   const OtherHandleType& inputCellIds, Type& visitIndices) const
   {
-    //To determine the number of times we have already visited
-    //the current input cell, we take the lower bounds of the
-    //input cell id array. The resulting number subtracted from the WorkId
-    //gives us the number of times we have visited that cell
-    visitIndices.PrepareForOutput(inputCellIds.GetNumberOfValues());
-    Algorithm::LowerBounds(inputCellIds, inputCellIds, visitIndices);
-    scheduler.Invoke(dax::exec::internal::kernel::ComputeVisitIndex(),
-                     visitIndices, visitIndices); //as input and output
+    //The input cell ids are sorted, so the number of times we have already
+    //visited the current input cell is an exclusive scan of ones segmented
+    //by input cell id. This is linear, unlike searching for the first
+    //occurrence of each id.
+    typedef typename Type::DeviceAdapterTag DeviceAdapterTag;
+    Algorithm::ScanExclusiveByKey(
+          inputCellIds,
+          dax::cont::make_ArrayHandleConstant(dax::Id(1),
+                                              inputCellIds.GetNumberOfValues(),
+                                              DeviceAdapterTag()),
+          visitIndices);
   }
 };
 
@@ -33,6 +33,7 @@
 #include <dax/cont/GenerateTopology.h>
 #include <dax/cont/ReduceKeysValues.h>
 #include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
 
 //include the scheduler implementation tags
 #include <dax/cont/scheduling/SchedulerTags.h>
@@ -110,6 +111,16 @@ namespace internal
     typedef dax::cont::scheduling::ScheduleCellsTag SchedulerTag;
   };
 
+  template<typename WorkType>
+  struct is_MapFieldPacket
+  {
+    //if worktype derives from WorkletMapFieldPacket
+    //the typedef 'type' will be true
+    typedef typename boost::is_base_of<
+                        dax::exec::internal::WorkletMapFieldPacketBase,
+                        WorkType >::type Valid;
+    typedef dax::cont::scheduling::ScheduleMapFieldPacketTag SchedulerTag;
+  };
 
   template<typename WorkType>
   struct is_DefaultType
@@ -127,6 +138,7 @@ template<class WorkType> class DetermineScheduler
   typedef internal::is_ReduceKeysValues<WorkType> IsReduceKeysValuesType;
   typedef internal::is_GenerateCells<WorkType> IsGenCoordsType;
   typedef internal::is_CellBased<WorkType> IsCellType;
+  typedef internal::is_MapFieldPacket<WorkType> IsMapFieldPacketType;
   typedef internal::is_DefaultType<WorkType> IsDefaultType;
 
 
@@ -144,6 +156,7 @@ template<class WorkType> class DetermineScheduler
                              IsReduceKeysValuesType,
                              IsGenCoordsType,
                              IsCellType,
+                             IsMapFieldPacketType,
                              IsDefaultType>
         PossibleSchedulers;
 
@@ -0,0 +1,51 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_scheduling_ExpandScannedCounts_h
+#define __dax_cont_scheduling_ExpandScannedCounts_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax { namespace cont { namespace scheduling {
+
+/// Given the inclusive scan of the number of outputs each input generates,
+/// fills \c inputIds with the input that generated each output value. Each
+/// input fills its own output range directly, so this is linear in the
+/// number of inputs and outputs rather than a binary search per output.
+///
+template<class Algorithm,
+         class ScannedCountsHandleType,
+         class IdArrayHandleType>
+DAX_CONT_EXPORT void ExpandScannedCounts(
+    const ScannedCountsHandleType &scannedCounts,
+    dax::Id numOutputValues,
+    IdArrayHandleType &inputIds)
+{
+  typedef typename ScannedCountsHandleType::PortalConstExecution
+      ScannedCountsPortalType;
+  typedef typename IdArrayHandleType::PortalExecution InputIdsPortalType;
+
+  dax::exec::internal::kernel::ExpandScannedCounts<
+      ScannedCountsPortalType,InputIdsPortalType>
+    expand(scannedCounts.PrepareForInput(),
+           inputIds.PrepareForOutput(numOutputValues));
+
+  Algorithm::Schedule(expand, scannedCounts.GetNumberOfValues());
+}
+
+} } } //dax::cont::scheduling
+
+#endif //__dax_cont_scheduling_ExpandScannedCounts_h
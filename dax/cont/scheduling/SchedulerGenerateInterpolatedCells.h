@@ -21,10 +21,10 @@
 #include <dax/Types.h>
 #include <dax/CellTraits.h>
 #include <dax/cont/arg/ConceptMap.h>
-#include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/Scheduler.h>
 #include <dax/cont/scheduling/AddVisitIndexArg.h>
+#include <dax/cont/scheduling/ExpandScannedCounts.h>
 #include <dax/cont/scheduling/SchedulerDefault.h>
 #include <dax/cont/scheduling/SchedulerTags.h>
 #include <dax/cont/scheduling/VerifyUserArgLength.h>
@@ -187,12 +187,11 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     newTopo.DoReleaseClassification();
     }
 
-  //now do the uppper bounds of the cell indices so that we figure out
-  //which original topology indexs match the new indices.
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType validCellRange;
-  Algorithm::UpperBounds(scannedNewCellCounts,
-                         dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                         validCellRange);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedNewCellCounts, numNewCells, validCellRange);
 
   // We are done with scannedNewCellCounts.
   scannedNewCellCounts.ReleaseResources();
@@ -304,12 +303,11 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     return;
     }
 
-  //now do the uppper bounds of the cell indices so that we figure out
-  //which original topology indexs match the new indices.
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType validCellRange;
-  Algorithm::UpperBounds(scannedNewCellCounts,
-                   dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                   validCellRange);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedNewCellCounts, numNewCells, validCellRange);
 
   // We are done with scannedNewCellCounts.
   scannedNewCellCounts.ReleaseResources();
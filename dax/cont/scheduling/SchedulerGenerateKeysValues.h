@@ -25,11 +25,11 @@
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/sig/VisitIndex.h>
 #include <dax/cont/Scheduler.h>
-#include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/scheduling/SchedulerTags.h>
 #include <dax/cont/scheduling/SchedulerDefault.h>
 #include <dax/cont/scheduling/VerifyUserArgLength.h>
 #include <dax/cont/scheduling/AddVisitIndexArg.h>
+#include <dax/cont/scheduling/ExpandScannedCounts.h>
 
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
 
@@ -107,11 +107,11 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
     workletWrapper.DoReleaseOutputCountArray();
     }
 
-  //now do the lower bounds of the cell indices so that we figure out
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType outputIndexRanges;
-  Algorithm::UpperBounds(scannedOutputCounts,
-                 dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewValues),
-                 outputIndexRanges);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedOutputCounts, numNewValues, outputIndexRanges);
 
   // We are done with scannedOutputCounts.
   scannedOutputCounts.ReleaseResources();
@@ -202,11 +202,11 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
     workletWrapper.DoReleaseOutputCountArray();
     }
 
-  //now do the lower bounds of the cell indices so that we figure out
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType outputIndexRanges;
-  Algorithm::UpperBounds(scannedOutputCounts,
-                         dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewValues),
-                         outputIndexRanges);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedOutputCounts, numNewValues, outputIndexRanges);
 
   // We are done with scannedOutputCounts.
   scannedOutputCounts.ReleaseResources();
@@ -25,11 +25,11 @@
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/sig/VisitIndex.h>
 #include <dax/cont/Scheduler.h>
-#include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/scheduling/SchedulerTags.h>
 #include <dax/cont/scheduling/SchedulerDefault.h>
 #include <dax/cont/scheduling/VerifyUserArgLength.h>
 #include <dax/cont/scheduling/AddVisitIndexArg.h>
+#include <dax/cont/scheduling/ExpandScannedCounts.h>
 
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
 
@@ -115,12 +115,11 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     return;
     }
 
-  //now do the lower bounds of the cell indices so that we figure out
-  //which original topology indexs match the new indices.
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType validCellRange;
-  Algorithm::UpperBounds(scannedNewCellCounts,
-                   dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                   validCellRange);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedNewCellCounts, numNewCells, validCellRange);
 
   // We are done with scannedNewCellCounts.
   scannedNewCellCounts.ReleaseResources();
@@ -281,12 +280,11 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     return;
     }
 
-  //now do the uppper bounds of the cell indices so that we figure out
-  //which original topology indexs match the new indices.
+  //expand the scanned counts so that we figure out which original
+  //topology index generated each new index.
   IdArrayHandleType validCellRange;
-  Algorithm::UpperBounds(scannedNewCellCounts,
-                         dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                         validCellRange);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(
+      scannedNewCellCounts, numNewCells, validCellRange);
 
   // We are done with scannedNewCellCounts.
   scannedNewCellCounts.ReleaseResources();
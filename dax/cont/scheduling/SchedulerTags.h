@@ -22,6 +22,9 @@ namespace dax { namespace cont { namespace scheduling {
 //tag to used to specify the default algorithm
 struct ScheduleDefaultTag{};
 
+//tag used to specify a field invocation in packets of values
+struct ScheduleMapFieldPacketTag{};
+
 //tag to used to specify a cell based invocation
 struct ScheduleCellsTag{};
 
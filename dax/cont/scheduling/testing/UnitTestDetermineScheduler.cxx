@@ -26,6 +26,7 @@
 #include <dax/cont/sig/Tag.h>
 #include <dax/exec/arg/FieldPortal.h>
 #include <dax/exec/WorkletMapField.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
 #include <dax/exec/WorkletMapCell.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
 #include <dax/exec/WorkletGenerateTopology.h>
@@ -35,6 +36,7 @@
 namespace{
 
 struct fieldWorklet : dax::exec::WorkletMapField {};
+struct packetWorklet : dax::exec::WorkletMapFieldPacket<4> {};
 struct cellWorklet : dax::exec::WorkletMapCell {};
 struct topoWorklet : dax::exec::WorkletGenerateTopology {};
 struct interpCellWorklet : dax::exec::WorkletInterpolatedCell {};
@@ -49,6 +51,9 @@ void DetermineScheduler()
   typedef dax::cont::scheduling::DetermineScheduler<fieldWorklet>
     DetermineFieldScheduler;
 
+  typedef dax::cont::scheduling::DetermineScheduler<packetWorklet>
+    DeterminePacketScheduler;
+
   typedef dax::cont::scheduling::DetermineScheduler<cellWorklet>
     DetermineCellScheduler;
 
@@ -70,6 +75,10 @@ void DetermineScheduler()
   BOOST_MPL_ASSERT((boost::is_same<FieldScheduler,
                    dax::cont::scheduling::ScheduleDefaultTag>));
 
+  //verify that packet field worklets map to the packet scheduler
+  typedef DeterminePacketScheduler::SchedulerTag PacketScheduler;
+  BOOST_MPL_ASSERT((boost::is_same<PacketScheduler,
+                   dax::cont::scheduling::ScheduleMapFieldPacketTag>));
 
   //verify that map cell worklets map to the default scheduler
   typedef DetermineCellScheduler::SchedulerTag CellScheduler;
@@ -0,0 +1,89 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/scheduling/ExpandScannedCounts.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace{
+
+void ExpandScannedCounts()
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<
+      dax::cont::DeviceAdapterTagSerial> Algorithm;
+  typedef dax::cont::ArrayHandle<dax::Id> IdHandleType;
+
+  //input 1 and 4 generate nothing, input 5 generates the most values
+  std::vector<dax::Id> counts(7);
+  counts[0]=2;
+  counts[1]=0;
+  counts[2]=1;
+  counts[3]=3;
+  counts[4]=0;
+  counts[5]=4;
+  counts[6]=1;
+
+  IdHandleType scannedCounts;
+  const dax::Id numOutputValues =
+      Algorithm::ScanInclusive(dax::cont::make_ArrayHandle(counts),
+                               scannedCounts);
+  DAX_TEST_ASSERT(numOutputValues == 11, "Bad number of output values.");
+
+  IdHandleType inputIds;
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(scannedCounts,
+                                                        numOutputValues,
+                                                        inputIds);
+  DAX_TEST_ASSERT(inputIds.GetNumberOfValues() == numOutputValues,
+                  "Wrong number of input ids.");
+
+  std::vector<dax::Id> result(numOutputValues);
+  inputIds.CopyInto(result.begin());
+
+  dax::Id outIndex = 0;
+  for(dax::Id inIndex = 0;
+      inIndex < static_cast<dax::Id>(counts.size());
+      ++inIndex)
+    {
+    for(dax::Id visit = 0; visit < counts[inIndex]; ++visit, ++outIndex)
+      {
+      DAX_TEST_ASSERT(result[outIndex] == inIndex, "Bad input id.");
+      }
+    }
+
+  //a classification that generates nothing should produce nothing
+  std::vector<dax::Id> noCounts(4, 0);
+  const dax::Id noOutputValues =
+      Algorithm::ScanInclusive(dax::cont::make_ArrayHandle(noCounts),
+                               scannedCounts);
+  dax::cont::scheduling::ExpandScannedCounts<Algorithm>(scannedCounts,
+                                                        noOutputValues,
+                                                        inputIds);
+  DAX_TEST_ASSERT(inputIds.GetNumberOfValues() == 0,
+                  "Empty expansion should have no values.");
+}
+
+}
+
+int UnitTestExpandScannedCounts(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(ExpandScannedCounts);
+}
@@ -0,0 +1,171 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/testing/Testing.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/Square.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Scalar A = 2.5;
+
+// Computes a*x + y and reports how many values each invocation processed,
+// which tells packet invocations apart from the scalar remainder.
+template<int Width>
+struct Axpy : public dax::exec::WorkletMapFieldPacket<Width>
+{
+  // The names inherited from the worklet base are dependent here.
+  typedef dax::cont::arg::Field Field;
+  typedef dax::cont::sig::In In;
+  typedef dax::cont::sig::Out Out;
+  typedef dax::cont::sig::placeholders::_1 _1;
+  typedef dax::cont::sig::placeholders::_2 _2;
+  typedef dax::cont::sig::placeholders::_3 _3;
+  typedef dax::cont::sig::placeholders::_4 _4;
+  typedef dax::cont::sig::placeholders::_5 _5;
+  typedef void ControlSignature(Field(In), Field(In), Field(In),
+                                Field(Out), Field(Out));
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5);
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Scalar x, dax::Scalar y, dax::Scalar a,
+                  dax::Scalar &result, dax::Id &lanes) const
+  {
+    result = a*x + y;
+    lanes = 1;
+  }
+
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Tuple<dax::Scalar,Width> &x,
+                  const dax::Tuple<dax::Scalar,Width> &y,
+                  dax::Scalar a,
+                  dax::Tuple<dax::Scalar,Width> &result,
+                  dax::Tuple<dax::Id,Width> &lanes) const
+  {
+    result = a*x + y;
+    lanes = dax::Tuple<dax::Id,Width>(Width);
+  }
+};
+
+dax::Scalar XValue(dax::Id index) { return static_cast<dax::Scalar>(index); }
+dax::Scalar YValue(dax::Id index) { return dax::Scalar(0.25)*index - 3; }
+
+template<int Width>
+void TestAxpy(dax::Id numValues)
+{
+  std::cout << "  Width " << Width << ", " << numValues << " values"
+            << std::endl;
+  std::vector<dax::Scalar> x(numValues);
+  std::vector<dax::Scalar> y(numValues);
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    x[index] = XValue(index);
+    y[index] = YValue(index);
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> resultHandle;
+  dax::cont::ArrayHandle<dax::Id> lanesHandle;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Axpy<Width>(),
+                   dax::cont::make_ArrayHandle(x),
+                   dax::cont::make_ArrayHandle(y),
+                   A,
+                   resultHandle,
+                   lanesHandle);
+
+  DAX_TEST_ASSERT(resultHandle.GetNumberOfValues() == numValues,
+                  "Wrong number of results.");
+  std::vector<dax::Scalar> result(numValues);
+  std::vector<dax::Id> lanes(numValues);
+  resultHandle.CopyInto(result.begin());
+  lanesHandle.CopyInto(lanes.begin());
+
+  const dax::Id numPacked = (numValues/Width)*Width;
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(result[index],
+                               A*XValue(index) + YValue(index)),
+                    "Bad result.");
+    DAX_TEST_ASSERT(lanes[index] == ((index < numPacked) ? Width : 1),
+                    "Value processed by the wrong path.");
+    }
+}
+
+template<int Width>
+void TestAxpyWidth()
+{
+  TestAxpy<Width>(1);
+  TestAxpy<Width>(Width);
+  TestAxpy<Width>(3*Width + 1);
+  TestAxpy<Width>(100);
+}
+
+void TestWorklets()
+{
+  std::cout << "Packet worklets" << std::endl;
+  const dax::Id numValues = 29;
+  std::vector<dax::Vector3> vectors(numValues);
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    vectors[index] = dax::make_Vector3(index, -0.5*index, 2);
+    }
+  dax::cont::ArrayHandle<dax::Vector3> vectorHandle =
+      dax::cont::make_ArrayHandle(vectors);
+
+  dax::cont::Scheduler<> scheduler;
+  dax::cont::ArrayHandle<dax::Vector3> squareHandle;
+  scheduler.Invoke(dax::worklet::Square(), vectorHandle, squareHandle);
+  dax::cont::ArrayHandle<dax::Scalar> magnitudeHandle;
+  scheduler.Invoke(dax::worklet::Magnitude(), vectorHandle, magnitudeHandle);
+
+  std::vector<dax::Vector3> square(numValues);
+  squareHandle.CopyInto(square.begin());
+  std::vector<dax::Scalar> magnitude(numValues);
+  magnitudeHandle.CopyInto(magnitude.begin());
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(square[index], vectors[index]*vectors[index]),
+                    "Bad square.");
+    DAX_TEST_ASSERT(test_equal(magnitude[index],
+                               dax::math::Magnitude(vectors[index])),
+                    "Bad magnitude.");
+    }
+}
+
+void TestSchedulerMapFieldPacket()
+{
+  std::cout << "Packet invocations" << std::endl;
+  TestAxpyWidth<4>();
+  TestAxpyWidth<8>();
+  TestAxpyWidth<16>();
+  TestWorklets();
+}
+
+} // anonymous namespace
+
+int UnitTestSchedulerMapFieldPacket(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestSchedulerMapFieldPacket);
+}
@@ -0,0 +1,176 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_testing_TestingAtomicArray_h
+#define __dax_cont_testing_TestingAtomicArray_h
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/AtomicArray.h>
+#include <dax/cont/Scheduler.h>
+
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/AtomicOperations.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <limits>
+
+#define ARRAY_SIZE 100000
+#define NUMBER_OF_BINS 7
+
+namespace dax {
+namespace cont {
+namespace testing {
+
+/// This class has a single static member, Run, that tests the atomic
+/// operations of dax::cont::AtomicArray with the templated DeviceAdapter.
+/// Many values update a few bins, so the operations are contended.
+///
+template<class DeviceAdapterTag>
+struct TestingAtomicArray
+{
+private:
+  typedef dax::cont::AtomicArray<dax::Id, DeviceAdapterTag> IdAtomicArray;
+  typedef dax::cont::AtomicArray<dax::Scalar, DeviceAdapterTag>
+      ScalarAtomicArray;
+
+public:
+  // Cuda kernels have to be public (in Cuda 4.0).
+
+  struct BinWorklet : public dax::exec::WorkletMapField
+  {
+    typedef void ControlSignature(Field(In),
+                                  ExecObject(),
+                                  ExecObject(),
+                                  ExecObject(),
+                                  ExecObject(),
+                                  ExecObject());
+    typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6);
+
+    template<class IdAtomicType, class ScalarAtomicType>
+    DAX_EXEC_EXPORT
+    void operator()(dax::Id value,
+                    const IdAtomicType &counts,
+                    const ScalarAtomicType &sums,
+                    const IdAtomicType &minimums,
+                    const ScalarAtomicType &maximums,
+                    const IdAtomicType &claims) const
+    {
+      const dax::Id bin = value % NUMBER_OF_BINS;
+      counts.Add(bin, 1);
+      sums.Add(bin, dax::Scalar(0.5));
+      minimums.Min(bin, value);
+      maximums.Max(bin, dax::Scalar(value));
+      claims.CompareAndSwap(bin, value, dax::Id(-1));
+    }
+  };
+
+private:
+  static DAX_CONT_EXPORT void TestBins()
+  {
+    std::cout << "Updating bins with atomic operations." << std::endl;
+    IdAtomicArray counts(NUMBER_OF_BINS, 0);
+    ScalarAtomicArray sums(NUMBER_OF_BINS, 0);
+    IdAtomicArray minimums(NUMBER_OF_BINS, ARRAY_SIZE);
+    ScalarAtomicArray maximums(NUMBER_OF_BINS, -1);
+    IdAtomicArray claims(NUMBER_OF_BINS, -1);
+
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    scheduler.Invoke(BinWorklet(),
+                     dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                         dax::Id(ARRAY_SIZE),
+                                                         DeviceAdapterTag()),
+                     counts.PrepareForExecution(),
+                     sums.PrepareForExecution(),
+                     minimums.PrepareForExecution(),
+                     maximums.PrepareForExecution(),
+                     claims.PrepareForExecution());
+
+    for (dax::Id bin = 0; bin < NUMBER_OF_BINS; bin++)
+      {
+      const dax::Id expectedCount =
+          (ARRAY_SIZE - bin + NUMBER_OF_BINS - 1)/NUMBER_OF_BINS;
+      const dax::Id lastValue = bin + (expectedCount-1)*NUMBER_OF_BINS;
+      DAX_TEST_ASSERT(counts.GetHandle().GetPortalConstControl().Get(bin)
+                      == expectedCount,
+                      "Atomic adds of ids lost updates.");
+      DAX_TEST_ASSERT(test_equal(
+                        sums.GetHandle().GetPortalConstControl().Get(bin),
+                        dax::Scalar(0.5*expectedCount)),
+                      "Atomic adds of scalars lost updates.");
+      DAX_TEST_ASSERT(minimums.GetHandle().GetPortalConstControl().Get(bin)
+                      == bin,
+                      "Bad atomic minimum.");
+      DAX_TEST_ASSERT(test_equal(
+                        maximums.GetHandle().GetPortalConstControl().Get(bin),
+                        dax::Scalar(lastValue)),
+                      "Bad atomic maximum.");
+      const dax::Id claim =
+          claims.GetHandle().GetPortalConstControl().Get(bin);
+      DAX_TEST_ASSERT((claim >= 0) && (claim % NUMBER_OF_BINS == bin),
+                      "Bad atomic compare and swap.");
+      }
+  }
+
+  static DAX_CONT_EXPORT void TestCompareAndSwapBits()
+  {
+    std::cout << "Comparing bits in compare and swap." << std::endl;
+    typedef dax::exec::internal::AtomicOperations<DeviceAdapterTag>
+        Operations;
+
+    const dax::Scalar nan = std::numeric_limits<dax::Scalar>::quiet_NaN();
+    dax::Scalar value = nan;
+    Operations::CompareAndSwap(&value, dax::Scalar(1), nan);
+    DAX_TEST_ASSERT(value == dax::Scalar(1),
+                    "Compare and swap did not match NaN.");
+
+    value = -dax::Scalar(0);
+    Operations::CompareAndSwap(&value, dax::Scalar(1), dax::Scalar(0));
+    DAX_TEST_ASSERT(value != dax::Scalar(1),
+                    "Compare and swap matched -0.0 with 0.0.");
+  }
+
+  struct TestAll
+  {
+    DAX_CONT_EXPORT void operator()() const
+    {
+      std::cout << "Doing AtomicArray tests" << std::endl;
+      TestCompareAndSwapBits();
+      TestBins();
+    }
+  };
+
+public:
+
+  /// Run a suite of tests to check that the atomic operations work with the
+  /// DeviceAdapter. Returns an error code that can be returned from the main
+  /// function of a test.
+  ///
+  static DAX_CONT_EXPORT int Run()
+  {
+    return dax::cont::testing::Testing::Run(TestAll());
+  }
+};
+
+}
+}
+} // namespace dax::cont::testing
+
+#undef ARRAY_SIZE
+#undef NUMBER_OF_BINS
+
+#endif //__dax_cont_testing_TestingAtomicArray_h
@@ -16,6 +16,8 @@
 #ifndef __dax_cont_testing_TestingDeviceAdapter_h
 #define __dax_cont_testing_TestingDeviceAdapter_h
 
+#include <dax/Functional.h>
+
 #include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/ErrorExecution.h>
@@ -38,6 +40,7 @@
 
 #include <dax/math/Compare.h>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -992,6 +995,94 @@ private:
       }
   }
 
+  static DAX_CONT_EXPORT void TestScanInclusiveWithOperator()
+  {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing Inclusive Scan with custom operator" << std::endl;
+
+    std::vector<dax::Id> testData(ARRAY_SIZE);
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      testData[i] = OFFSET + ((i*37) % 101);
+      }
+    IdArrayHandle input = MakeArrayHandle(testData);
+
+    IdArrayHandle maxima;
+    dax::Id maximum = Algorithm::ScanInclusive(input, maxima, dax::Maximum());
+    DAX_TEST_ASSERT(maxima.GetNumberOfValues() == ARRAY_SIZE,
+                    "Scan has wrong size.");
+
+    dax::Id expected = testData[0];
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      expected = std::max(expected, testData[i]);
+      DAX_TEST_ASSERT(maxima.GetPortalConstControl().Get(i) == expected,
+                      "Incorrect running maximum");
+      }
+    DAX_TEST_ASSERT(maximum == expected, "Got bad maximum from scan");
+
+    // The same scan done in place with addition matches the regular scan.
+    IdArrayHandle sums;
+    Algorithm::Copy(input, sums);
+    dax::Id sum = Algorithm::ScanInclusive(sums, sums, dax::Add());
+    IdArrayHandle reference;
+    dax::Id referenceSum = Algorithm::ScanInclusive(input, reference);
+    DAX_TEST_ASSERT(sum == referenceSum, "Got bad sum from scan");
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      DAX_TEST_ASSERT(sums.GetPortalConstControl().Get(i) ==
+                      reference.GetPortalConstControl().Get(i),
+                      "Incorrect partial sum");
+      }
+  }
+
+  static DAX_CONT_EXPORT void TestScanByKey()
+  {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing Scan By Key" << std::endl;
+
+    // Segments of varying length, including single values, and a key that
+    // repeats after a different key (which starts a new segment).
+    std::vector<dax::Id> keyData(ARRAY_SIZE);
+    std::vector<dax::Id> valueData(ARRAY_SIZE);
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      keyData[i] = (i/7 + i/13) % 3;
+      valueData[i] = i % 5 + 1;
+      }
+    IdArrayHandle keys = MakeArrayHandle(keyData);
+    IdArrayHandle values = MakeArrayHandle(valueData);
+
+    IdArrayHandle inclusive;
+    Algorithm::ScanInclusiveByKey(keys, values, inclusive);
+    IdArrayHandle exclusive;
+    Algorithm::ScanExclusiveByKey(keys, values, exclusive);
+    DAX_TEST_ASSERT(inclusive.GetNumberOfValues() == ARRAY_SIZE,
+                    "Inclusive scan by key has wrong size.");
+    DAX_TEST_ASSERT(exclusive.GetNumberOfValues() == ARRAY_SIZE,
+                    "Exclusive scan by key has wrong size.");
+
+    dax::Id sum = 0;
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      if ((i > 0) && (keyData[i] != keyData[i-1])) { sum = 0; }
+      DAX_TEST_ASSERT(exclusive.GetPortalConstControl().Get(i) == sum,
+                      "Incorrect exclusive scan by key");
+      sum += valueData[i];
+      DAX_TEST_ASSERT(inclusive.GetPortalConstControl().Get(i) == sum,
+                      "Incorrect inclusive scan by key");
+      }
+
+    std::cout << "Scan By Key in place" << std::endl;
+    Algorithm::ScanInclusiveByKey(keys, values, values);
+    for(dax::Id i=0; i < ARRAY_SIZE; ++i)
+      {
+      DAX_TEST_ASSERT(values.GetPortalConstControl().Get(i) ==
+                      inclusive.GetPortalConstControl().Get(i),
+                      "Incorrect in place scan by key");
+      }
+  }
+
   static DAX_CONT_EXPORT void TestErrorExecution()
   {
     std::cout << "-------------------------------------------" << std::endl;
@@ -1217,6 +1308,8 @@ private:
       TestErrorExecution();
       TestScanInclusive();
       TestScanExclusive();
+      TestScanInclusiveWithOperator();
+      TestScanByKey();
       TestSortWithComparisonObject();
       TestSortByKey();
       TestLowerBoundsWithComparisonObject();
@@ -0,0 +1,208 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayContainerControlAligned.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <boost/cstdint.hpp>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 1000;
+
+dax::Scalar TestValue(dax::Id index) { return 0.5*index + 1; }
+
+bool IsAligned(const void *pointer, std::size_t alignment)
+{
+  return (reinterpret_cast<boost::uintptr_t>(pointer) % alignment) == 0;
+}
+
+template<class ContainerType>
+void FillContainer(ContainerType &container)
+{
+  for (dax::Id index = 0; index < container.GetNumberOfValues(); index++)
+    {
+    container.GetPortal().Set(index, TestValue(index));
+    }
+}
+
+template<class ContainerType>
+void CheckContainer(const ContainerType &container)
+{
+  for (dax::Id index = 0; index < container.GetNumberOfValues(); index++)
+    {
+    DAX_TEST_ASSERT(container.GetPortalConst().Get(index) == TestValue(index),
+                    "Container did not keep values.");
+    }
+}
+
+template<int Alignment>
+void TestAlignment(std::size_t expectedAlignment)
+{
+  std::cout << "Checking alignment of " << expectedAlignment << std::endl;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::Scalar, dax::cont::ArrayContainerControlTagAligned<Alignment> >
+      ContainerType;
+
+  ContainerType container;
+  DAX_TEST_ASSERT(container.GetNumberOfValues() == 0,
+                  "New array container not zero sized.");
+
+  for (dax::Id size = 1; size <= ARRAY_SIZE; size *= 10)
+    {
+    container.Allocate(size);
+    DAX_TEST_ASSERT(container.GetNumberOfValues() == size,
+                    "Array not properly allocated.");
+    DAX_TEST_ASSERT(IsAligned(container.GetPortal().GetIteratorBegin(),
+                              expectedAlignment),
+                    "Array not aligned.");
+    FillContainer(container);
+    CheckContainer(container);
+    }
+
+  container.Shrink(ARRAY_SIZE/2);
+  DAX_TEST_ASSERT(container.GetNumberOfValues() == ARRAY_SIZE/2,
+                  "Array Shrink failed to resize.");
+  CheckContainer(container);
+
+  // Growing within the allocation keeps the memory.
+  const dax::Scalar *memory = container.GetPortalConst().GetIteratorBegin();
+  container.Allocate(ARRAY_SIZE);
+  DAX_TEST_ASSERT(container.GetPortalConst().GetIteratorBegin() == memory,
+                  "Allocation within capacity reallocated.");
+
+  container.ReleaseResources();
+  DAX_TEST_ASSERT(container.GetNumberOfValues() == 0,
+                  "Array not released correctly.");
+
+  try
+    {
+    container.Shrink(ARRAY_SIZE);
+    DAX_TEST_FAIL("Array shrink to a larger size was possible.");
+    }
+  catch (dax::cont::ErrorControlBadValue)
+    {
+    std::cout << "Got expected error." << std::endl;
+    }
+}
+
+template<dax::cont::HugePageMode HugePages>
+void TestHugePages()
+{
+  std::cout << "Checking huge page mode " << HugePages << std::endl;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::Scalar,
+      dax::cont::ArrayContainerControlTagAligned<
+          dax::cont::ALIGNMENT_CACHE_LINE, HugePages> >
+      ContainerType;
+
+  const std::size_t hugePageSize = dax::cont::internal::GetHugePageSize();
+
+  ContainerType container;
+  container.Allocate(ARRAY_SIZE);
+  DAX_TEST_ASSERT(container.GetHugePageMode() == dax::cont::HUGE_PAGES_NONE,
+                  "Small array should not use huge pages.");
+  DAX_TEST_ASSERT(IsAligned(container.GetPortal().GetIteratorBegin(), 64),
+                  "Array not aligned.");
+  FillContainer(container);
+  CheckContainer(container);
+
+  // An array bigger than two huge pages, but not a multiple of them.
+  const dax::Id largeSize =
+      static_cast<dax::Id>((5*hugePageSize/2)/sizeof(dax::Scalar));
+  container.Allocate(largeSize);
+  std::cout << "  Large array backed with mode "
+            << container.GetHugePageMode() << std::endl;
+  if (HugePages == dax::cont::HUGE_PAGES_TRANSPARENT)
+    {
+    DAX_TEST_ASSERT(
+          container.GetHugePageMode() != dax::cont::HUGE_PAGES_HUGETLB,
+          "Transparent huge pages should not map the huge page pool.");
+    }
+  if (container.GetHugePageMode() != dax::cont::HUGE_PAGES_NONE)
+    {
+    DAX_TEST_ASSERT(IsAligned(container.GetPortal().GetIteratorBegin(),
+                              hugePageSize),
+                    "Huge page array not aligned to huge page.");
+    }
+  FillContainer(container);
+  CheckContainer(container);
+
+  container.ReleaseResources();
+  DAX_TEST_ASSERT(container.GetHugePageMode() == dax::cont::HUGE_PAGES_NONE,
+                  "Huge pages not released.");
+}
+
+void TestArrayHandle()
+{
+  std::cout << "Checking array handle with aligned container." << std::endl;
+  typedef dax::cont::ArrayHandle<
+      dax::Scalar,
+      dax::cont::ArrayContainerControlTagAligned<
+          dax::cont::ALIGNMENT_PAGE, dax::cont::HUGE_PAGES_TRANSPARENT> >
+      HandleType;
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = TestValue(ARRAY_SIZE - index - 1);
+    }
+
+  HandleType handle;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(values), handle);
+  DAX_TEST_ASSERT(handle.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad array size.");
+  DAX_TEST_ASSERT(IsAligned(&*handle.PrepareForInput().GetIteratorBegin(),
+                            dax::cont::internal::GetPageSize()),
+                  "Execution array not aligned.");
+
+  Algorithm::Sort(handle);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(handle.GetPortalConstControl().Get(index)
+                    == TestValue(index),
+                    "Got bad value from sorted array.");
+    }
+}
+
+void TestArrayContainerControlAligned()
+{
+  TestAlignment<dax::cont::ALIGNMENT_CACHE_LINE>(64);
+  TestAlignment<256>(256);
+  TestAlignment<dax::cont::ALIGNMENT_PAGE>(dax::cont::internal::GetPageSize());
+
+  TestHugePages<dax::cont::HUGE_PAGES_NONE>();
+  TestHugePages<dax::cont::HUGE_PAGES_TRANSPARENT>();
+  TestHugePages<dax::cont::HUGE_PAGES_HUGETLB>();
+
+  TestArrayHandle();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayContainerControlAligned(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayContainerControlAligned);
+}
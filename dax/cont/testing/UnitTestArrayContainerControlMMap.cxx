@@ -0,0 +1,170 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayContainerControlMMap.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 1000;
+// Not a multiple of the page size, to check that unaligned offsets work.
+const dax::Id HEADER_SIZE = 13;
+const char FILENAME[] = "UnitTestArrayContainerControlMMap.raw";
+
+dax::Scalar TestValue(dax::Id index) { return 0.5*index + 1; }
+
+void WriteTestFile()
+{
+  std::ofstream file(FILENAME, std::ios::out | std::ios::binary);
+  const std::string header(HEADER_SIZE, 'h');
+  file.write(header.data(), HEADER_SIZE);
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = TestValue(index);
+    }
+  file.write(reinterpret_cast<const char *>(&values[0]),
+             ARRAY_SIZE*sizeof(dax::Scalar));
+}
+
+void TestMapWholeFile()
+{
+  std::cout << "Mapping rest of file." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar, dax::cont::ArrayContainerControlTagMMap>
+      handle = dax::cont::make_ArrayHandleMMap<dax::Scalar>(FILENAME,
+                                                            -1,
+                                                            HEADER_SIZE);
+  DAX_TEST_ASSERT(handle.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad array size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(handle.GetPortalConstControl().Get(index)
+                    == TestValue(index),
+                    "Got bad value from control portal.");
+    }
+
+  std::cout << "Checking execution array shares the mapping." << std::endl;
+  DAX_TEST_ASSERT(&*handle.PrepareForInput().GetIteratorBegin() ==
+                  &*handle.GetPortalConstControl().GetIteratorBegin(),
+                  "Execution array is not using the mapped memory.");
+
+  std::cout << "Copying through device." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> copy;
+  dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        handle, copy);
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  copy.CopyInto(values.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(values[index] == TestValue(index),
+                    "Got bad value from copy.");
+    }
+}
+
+void TestMapRegion()
+{
+  std::cout << "Mapping region of file." << std::endl;
+  const dax::Id start = 100;
+  const dax::Id size = 50;
+  dax::cont::ArrayHandle<dax::Scalar, dax::cont::ArrayContainerControlTagMMap>
+      handle = dax::cont::make_ArrayHandleMMap<dax::Scalar>(
+        FILENAME,
+        size,
+        HEADER_SIZE + start*sizeof(dax::Scalar),
+        dax::cont::MMAP_ADVICE_RANDOM | dax::cont::MMAP_ADVICE_WILL_NEED);
+  DAX_TEST_ASSERT(handle.GetNumberOfValues() == size, "Bad array size.");
+  std::vector<dax::Scalar> values(size);
+  handle.CopyInto(values.begin());
+  for (dax::Id index = 0; index < size; index++)
+    {
+    DAX_TEST_ASSERT(values[index] == TestValue(start + index),
+                    "Got bad value.");
+    }
+}
+
+void TestErrors()
+{
+  std::cout << "Mapping past end of file." << std::endl;
+  bool gotError = false;
+  try
+    {
+    dax::cont::make_ArrayHandleMMap<dax::Scalar>(FILENAME,
+                                                 ARRAY_SIZE+1,
+                                                 HEADER_SIZE);
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Did not get error mapping past end of file.");
+
+  std::cout << "Mapping missing file." << std::endl;
+  gotError = false;
+  try
+    {
+    dax::cont::make_ArrayHandleMMap<dax::Scalar>("NoSuchFile.raw");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Did not get error mapping missing file.");
+
+  std::cout << "Writing to mapped array." << std::endl;
+  gotError = false;
+  dax::cont::ArrayHandle<dax::Scalar, dax::cont::ArrayContainerControlTagMMap>
+      handle = dax::cont::make_ArrayHandleMMap<dax::Scalar>(FILENAME);
+  try
+    {
+    handle.PrepareForInPlace();
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Did not get error writing to mapped array.");
+}
+
+void TestArrayContainerControlMMap()
+{
+  WriteTestFile();
+  TestMapWholeFile();
+  TestMapRegion();
+  TestErrors();
+  std::remove(FILENAME);
+}
+
+} // anonymous namespace
+
+int UnitTestArrayContainerControlMMap(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayContainerControlMMap);
+}
@@ -0,0 +1,164 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayContainerControlUserMemory.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+typedef dax::cont::ArrayHandle<
+    dax::Scalar, dax::cont::ArrayContainerControlTagUserMemory>
+    UserArrayHandle;
+
+dax::Scalar TestValue(dax::Id index) { return 0.5*index + 1; }
+
+int NumberOfReleases;
+const dax::Scalar *ReleasedArray;
+
+struct RecordRelease
+{
+  void operator()(const dax::Scalar *array) const
+  {
+    NumberOfReleases++;
+    ReleasedArray = array;
+  }
+};
+
+void TestInput()
+{
+  std::cout << "Reading user memory." << std::endl;
+  std::vector<dax::Scalar> buffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    buffer[index] = TestValue(index);
+    }
+
+  UserArrayHandle array =
+      dax::cont::make_ArrayHandleUserMemory(&buffer[0], ARRAY_SIZE);
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values.");
+  DAX_TEST_ASSERT(array.PrepareForInput().GetIteratorBegin() == &buffer[0],
+                  "Input did not use the user buffer.");
+
+  dax::cont::ArrayHandle<dax::Scalar> copy;
+  Algorithm::Copy(array, copy);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(copy.GetPortalConstControl().Get(index) == TestValue(index),
+                    "Bad value read from user memory.");
+    }
+}
+
+void TestOutput()
+{
+  std::cout << "Writing worklet output into user memory." << std::endl;
+  std::vector<dax::Scalar> buffer(ARRAY_SIZE, -1);
+  NumberOfReleases = 0;
+  ReleasedArray = NULL;
+  {
+    UserArrayHandle array =
+        dax::cont::make_ArrayHandleUserMemory(&buffer[0],
+                                              ARRAY_SIZE,
+                                              RecordRelease());
+    dax::cont::ArrayHandleCounting<dax::Scalar> input =
+        dax::cont::make_ArrayHandleCounting(dax::Scalar(0), ARRAY_SIZE);
+
+    dax::cont::Scheduler<> scheduler;
+    scheduler.Invoke(dax::worklet::Square(), input, array);
+    DAX_TEST_ASSERT(array.GetPortalConstControl().GetIteratorBegin()
+                    == &buffer[0],
+                    "Output was not written into the user buffer.");
+    for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+      {
+      DAX_TEST_ASSERT(buffer[index] == dax::Scalar(index*index),
+                      "Bad value written to user memory.");
+      }
+
+    std::cout << "Writing less than the buffer." << std::endl;
+    Algorithm::Copy(
+          dax::cont::make_ArrayHandleCounting(dax::Scalar(0), ARRAY_SIZE/2),
+          array);
+    DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE/2,
+                    "Output did not shrink array.");
+    DAX_TEST_ASSERT(buffer[1] == 1, "Output not in user buffer.");
+
+    std::cout << "Writing more than the buffer." << std::endl;
+    try
+      {
+      Algorithm::Copy(
+            dax::cont::make_ArrayHandleCounting(dax::Scalar(0), 2*ARRAY_SIZE),
+            array);
+      DAX_TEST_FAIL("User memory array grew past its buffer.");
+      }
+    catch (dax::cont::ErrorControlBadValue error)
+      {
+      std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+      }
+
+    UserArrayHandle sharedArray = array;
+    array = UserArrayHandle();
+    DAX_TEST_ASSERT(NumberOfReleases == 0, "Buffer released while in use.");
+  }
+  DAX_TEST_ASSERT(NumberOfReleases == 1, "Buffer not released once.");
+  DAX_TEST_ASSERT(ReleasedArray == &buffer[0], "Wrong buffer released.");
+}
+
+void TestIntermediate()
+{
+  std::cout << "Using a user memory array without a buffer." << std::endl;
+  UserArrayHandle array;
+  Algorithm::Copy(
+        dax::cont::make_ArrayHandleCounting(dax::Scalar(0), ARRAY_SIZE),
+        array);
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(array.GetPortalConstControl().Get(index) == index,
+                    "Bad value in allocated array.");
+    }
+}
+
+void TestArrayContainerControlUserMemory()
+{
+  TestInput();
+  TestOutput();
+  TestIntermediate();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayContainerControlUserMemory(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayContainerControlUserMemory);
+}
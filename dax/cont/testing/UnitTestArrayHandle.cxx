@@ -147,10 +147,104 @@ void TestArrayHandle()
     }
 }
 
+void TestCopyOnWrite()
+{
+  std::cout << "Create copy on write array." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> source;
+  {
+  dax::cont::ArrayHandle<dax::Scalar>::PortalExecution executionPortal
+      = source.PrepareForOutput(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    executionPortal.Set(index, TestValue(index));
+    }
+  }
+
+  dax::cont::ArrayHandle<dax::Scalar> copy = source.CopyOnWrite();
+  DAX_TEST_ASSERT(copy.GetNumberOfValues() == ARRAY_SIZE,
+                  "Copy has wrong number of entries.");
+  DAX_TEST_ASSERT(CheckValues(copy), "Copy has wrong values.");
+  DAX_TEST_ASSERT(copy.PrepareForInput().GetIteratorBegin()
+                  == source.PrepareForInput().GetIteratorBegin(),
+                  "Read only copy does not share memory.");
+
+  std::cout << "Write to copy." << std::endl;
+  copy.GetPortalControl().Set(0, TestValue(ARRAY_SIZE));
+  DAX_TEST_ASSERT(copy.GetPortalConstControl().Get(0) == TestValue(ARRAY_SIZE),
+                  "Copy did not get written value.");
+  DAX_TEST_ASSERT(CheckValues(source), "Writing copy changed source.");
+  DAX_TEST_ASSERT(copy.PrepareForInput().GetIteratorBegin()
+                  != source.PrepareForInput().GetIteratorBegin(),
+                  "Written copy still shares memory.");
+
+  std::cout << "Write to source." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> copy2 = source.CopyOnWrite();
+  // A copy of a copy shares the original values.
+  dax::cont::ArrayHandle<dax::Scalar> copy3 = copy2.CopyOnWrite();
+  {
+  dax::cont::ArrayHandle<dax::Scalar>::PortalExecution executionPortal
+      = source.PrepareForInPlace();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    executionPortal.Set(index, executionPortal.Get(index) + 1);
+    }
+  }
+  DAX_TEST_ASSERT(CheckValues(copy2), "Writing source changed copy.");
+  DAX_TEST_ASSERT(CheckValues(copy3), "Writing source changed copy.");
+  DAX_TEST_ASSERT(source.GetPortalConstControl().Get(0) == TestValue(0) + 1,
+                  "Source did not get written value.");
+
+  std::cout << "Overwrite source and shrink copy." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> copy4 = copy3.CopyOnWrite();
+  copy3.PrepareForOutput(1);
+  copy4.Shrink(ARRAY_SIZE/2);
+  DAX_TEST_ASSERT(copy4.GetNumberOfValues() == ARRAY_SIZE/2,
+                  "Copy did not shrink.");
+  DAX_TEST_ASSERT(CheckValues(copy4), "Copy lost values.");
+
+  std::cout << "Release execution resources of source." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> outputSource;
+  {
+  dax::cont::ArrayHandle<dax::Scalar>::PortalExecution executionPortal
+      = outputSource.PrepareForOutput(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    executionPortal.Set(index, TestValue(index));
+    }
+  }
+  dax::cont::ArrayHandle<dax::Scalar> copy5 = outputSource.CopyOnWrite();
+  outputSource.ReleaseResourcesExecution();
+  DAX_TEST_ASSERT(copy5.GetNumberOfValues() == ARRAY_SIZE,
+                  "Copy lost its size.");
+  DAX_TEST_ASSERT(CheckValues(copy5), "Copy lost values.");
+
+  std::cout << "Copy from user array." << std::endl;
+  dax::Scalar array[ARRAY_SIZE];
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    array[index] = TestValue(index);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> userCopy =
+      dax::cont::make_ArrayHandle(array, ARRAY_SIZE).CopyOnWrite();
+  userCopy.GetPortalControl().Set(0, TestValue(ARRAY_SIZE));
+  DAX_TEST_ASSERT(array[0] == TestValue(0), "Copy wrote into user array.");
+
+  std::cout << "Copy empty array." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> empty;
+  DAX_TEST_ASSERT(empty.CopyOnWrite().GetNumberOfValues() == 0,
+                  "Copy of empty array is not empty.");
+}
+
+void TestArrayHandles()
+{
+  TestArrayHandle();
+  TestCopyOnWrite();
+}
+
 }
 
 
 int UnitTestArrayHandle(int, char *[])
 {
-  return dax::cont::testing::Testing::Run(TestArrayHandle);
+  return dax::cont::testing::Testing::Run(TestArrayHandles);
 }
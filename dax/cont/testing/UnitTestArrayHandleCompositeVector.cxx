@@ -0,0 +1,206 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleCompositeVector.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+
+dax::Scalar TestValue(dax::Id index, int component)
+{
+  return 10*index + component;
+}
+
+struct DoubleVector : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &value) const
+  {
+    return 2*value;
+  }
+};
+
+ScalarArrayHandle MakeComponentArray(int component)
+{
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = TestValue(index, component);
+    }
+  ScalarArrayHandle array;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(values), array);
+  return array;
+}
+
+template<class PortalType>
+void CheckPortal(const PortalType &portal, int numComponents)
+{
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    typename PortalType::ValueType value = portal.Get(index);
+    for (int component = 0; component < numComponents; component++)
+      {
+      DAX_TEST_ASSERT(value[component] == TestValue(index, component),
+                      "Bad composite value.");
+      }
+    }
+}
+
+void TestRead()
+{
+  std::cout << "Reading Vector3 from three arrays." << std::endl;
+  ScalarArrayHandle x = MakeComponentArray(0);
+  ScalarArrayHandle y = MakeComponentArray(1);
+  ScalarArrayHandle z = MakeComponentArray(2);
+  dax::cont::ArrayHandleCompositeVector<ScalarArrayHandle,3> composite =
+      dax::cont::make_ArrayHandleCompositeVector(x, y, z);
+  CheckPortal(composite.GetPortalConstControl(), 3);
+
+  std::vector<dax::Vector3> values(ARRAY_SIZE);
+  composite.CopyInto(values.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(values[index] == dax::make_Vector3(TestValue(index, 0),
+                                                       TestValue(index, 1),
+                                                       TestValue(index, 2)),
+                    "Bad value from CopyInto.");
+    }
+
+  std::cout << "Copying Vector3 in execution environment." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> interleaved;
+  Algorithm::Copy(composite, interleaved);
+  CheckPortal(interleaved.GetPortalConstControl(), 3);
+
+  std::cout << "Reading Vector4 from four arrays." << std::endl;
+  dax::cont::ArrayHandleCompositeVector<ScalarArrayHandle,4> composite4 =
+      dax::cont::make_ArrayHandleCompositeVector(x, y, z,
+                                                 MakeComponentArray(3));
+  dax::cont::ArrayHandle<dax::Vector4> interleaved4;
+  Algorithm::Copy(composite4, interleaved4);
+  CheckPortal(interleaved4.GetPortalConstControl(), 4);
+}
+
+void TestWrite()
+{
+  std::cout << "Writing Vector3 into three arrays." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> interleaved;
+  Algorithm::Copy(dax::cont::make_ArrayHandleCompositeVector(
+                    MakeComponentArray(0),
+                    MakeComponentArray(1),
+                    MakeComponentArray(2)),
+                  interleaved);
+
+  ScalarArrayHandle x, y, z;
+  dax::cont::ArrayHandleCompositeVector<ScalarArrayHandle,3> composite =
+      dax::cont::make_ArrayHandleCompositeVector(x, y, z);
+  Algorithm::Copy(interleaved, composite);
+  CheckPortal(composite.GetPortalConstControl(), 3);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(y.GetPortalConstControl().Get(index)
+                    == TestValue(index, 1),
+                    "Bad value in component array.");
+    }
+
+  std::cout << "Writing in place." << std::endl;
+  composite.GetPortalControl().Set(0, dax::make_Vector3(-1, -2, -3));
+  DAX_TEST_ASSERT(z.GetPortalConstControl().Get(0) == -3,
+                  "Write not in component array.");
+  composite.PrepareForInPlace().Set(1, dax::make_Vector3(-4, -5, -6));
+  DAX_TEST_ASSERT(x.GetPortalConstControl().Get(0) == -1,
+                  "Execution write lost control write.");
+  DAX_TEST_ASSERT(y.GetPortalConstControl().Get(1) == -5,
+                  "Execution write not in component array.");
+
+  std::cout << "Copying between composite arrays." << std::endl;
+  ScalarArrayHandle xCopy, yCopy, zCopy;
+  dax::cont::ArrayHandleCompositeVector<ScalarArrayHandle,3> compositeCopy =
+      dax::cont::make_ArrayHandleCompositeVector(xCopy, yCopy, zCopy);
+  Algorithm::Copy(composite, compositeCopy);
+  DAX_TEST_ASSERT(compositeCopy.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values copied.");
+  DAX_TEST_ASSERT(xCopy.GetPortalConstControl().Get(0) == -1,
+                  "Bad value in copied component array.");
+  DAX_TEST_ASSERT(zCopy.GetPortalConstControl().Get(1) == -6,
+                  "Bad value in copied component array.");
+  for (dax::Id index = 2; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(yCopy.GetPortalConstControl().Get(index)
+                    == TestValue(index, 1),
+                    "Bad value in copied component array.");
+    }
+}
+
+void TestWorklet()
+{
+  std::cout << "Passing composite arrays to a worklet." << std::endl;
+  ScalarArrayHandle x, y, z;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(DoubleVector(),
+                   dax::cont::make_ArrayHandleCompositeVector(
+                     MakeComponentArray(0),
+                     MakeComponentArray(1),
+                     MakeComponentArray(2)),
+                   dax::cont::make_ArrayHandleCompositeVector(x, y, z));
+  DAX_TEST_ASSERT(z.GetNumberOfValues() == ARRAY_SIZE,
+                  "Component array not allocated.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(x.GetPortalConstControl().Get(index)
+                    == 2*TestValue(index, 0),
+                    "Bad worklet output.");
+    DAX_TEST_ASSERT(z.GetPortalConstControl().Get(index)
+                    == 2*TestValue(index, 2),
+                    "Bad worklet output.");
+    }
+}
+
+void TestArrayHandleCompositeVector()
+{
+  TestRead();
+  TestWrite();
+  TestWorklet();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleCompositeVector(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleCompositeVector);
+}
@@ -0,0 +1,191 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleConcatenate.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id FIRST_SIZE = 40;
+const dax::Id SECOND_SIZE = 60;
+const dax::Id ARRAY_SIZE = FIRST_SIZE + SECOND_SIZE;
+
+typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+typedef dax::cont::ArrayHandle<dax::Id> IdArrayHandle;
+typedef dax::cont::ArrayHandleConcatenate<IdArrayHandle,IdArrayHandle>
+    ConcatenateArrayHandle;
+
+dax::Id TestValue(dax::Id index) { return 3*index + 1; }
+
+struct Negate : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Id operator()(dax::Id value) const
+  {
+    return -value;
+  }
+};
+
+IdArrayHandle MakeTestArray(dax::Id start, dax::Id size)
+{
+  IdArrayHandle array;
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(start, size), array);
+  for (dax::Id index = 0; index < size; index++)
+    {
+    array.GetPortalControl().Set(index, TestValue(start + index));
+    }
+  return array;
+}
+
+template<class PortalType>
+void CheckPortal(const PortalType &portal)
+{
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == TestValue(index),
+                    "Bad concatenated value.");
+    }
+}
+
+void TestRead()
+{
+  std::cout << "Reading concatenated arrays." << std::endl;
+  ConcatenateArrayHandle concatenate =
+      dax::cont::make_ArrayHandleConcatenate(
+        MakeTestArray(0, FIRST_SIZE),
+        MakeTestArray(FIRST_SIZE, SECOND_SIZE));
+  CheckPortal(concatenate.GetPortalConstControl());
+
+  std::vector<dax::Id> values(ARRAY_SIZE);
+  concatenate.CopyInto(values.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(values[index] == TestValue(index),
+                    "Bad value from CopyInto.");
+    }
+
+  std::cout << "Copying in execution environment." << std::endl;
+  IdArrayHandle copy;
+  Algorithm::Copy(concatenate, copy);
+  CheckPortal(copy.GetPortalConstControl());
+
+  std::cout << "Scanning across both arrays." << std::endl;
+  dax::Id sum = Algorithm::ScanInclusive(concatenate, copy);
+  dax::Id expected = 0;
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    expected += TestValue(index);
+    }
+  DAX_TEST_ASSERT(sum == expected, "Bad scan of concatenated arrays.");
+}
+
+void TestWrite()
+{
+  std::cout << "Writing concatenated arrays in place." << std::endl;
+  IdArrayHandle first = MakeTestArray(0, FIRST_SIZE);
+  IdArrayHandle second = MakeTestArray(FIRST_SIZE, SECOND_SIZE);
+  ConcatenateArrayHandle concatenate =
+      dax::cont::make_ArrayHandleConcatenate(first, second);
+
+  // Reverse the values, then sort them back across both arrays.
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    concatenate.GetPortalControl().Set(index, TestValue(ARRAY_SIZE-index-1));
+    }
+  DAX_TEST_ASSERT(second.GetPortalConstControl().Get(SECOND_SIZE-1)
+                  == TestValue(0),
+                  "Write not in second array.");
+  Algorithm::Sort(concatenate);
+  CheckPortal(concatenate.GetPortalConstControl());
+  DAX_TEST_ASSERT(first.GetPortalConstControl().Get(0) == TestValue(0),
+                  "Sort did not write first array.");
+
+  std::cout << "Using concatenated arrays as output." << std::endl;
+  IdArrayHandle growSecond;
+  ConcatenateArrayHandle output =
+      dax::cont::make_ArrayHandleConcatenate(MakeTestArray(0, FIRST_SIZE),
+                                             growSecond);
+  IdArrayHandle source;
+  Algorithm::Copy(concatenate, source);
+  Algorithm::Copy(source, output);
+  CheckPortal(output.GetPortalConstControl());
+  DAX_TEST_ASSERT(growSecond.GetNumberOfValues() == SECOND_SIZE,
+                  "Second array not allocated for output.");
+
+  std::cout << "Shrinking concatenated arrays." << std::endl;
+  output.Shrink(FIRST_SIZE/2);
+  DAX_TEST_ASSERT(output.GetNumberOfValues() == FIRST_SIZE/2,
+                  "Concatenated array did not shrink.");
+  DAX_TEST_ASSERT(growSecond.GetNumberOfValues() == 0,
+                  "Second array did not shrink.");
+}
+
+void TestWorklet()
+{
+  std::cout << "Passing concatenated arrays to a worklet." << std::endl;
+  // Writes into both of the existing arrays.
+  IdArrayHandle first = MakeTestArray(0, FIRST_SIZE);
+  IdArrayHandle second = MakeTestArray(0, SECOND_SIZE);
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Negate(),
+                   dax::cont::make_ArrayHandleConcatenate(
+                     MakeTestArray(0, FIRST_SIZE),
+                     MakeTestArray(FIRST_SIZE, SECOND_SIZE)),
+                   dax::cont::make_ArrayHandleConcatenate(first, second));
+  DAX_TEST_ASSERT(first.GetNumberOfValues() == FIRST_SIZE,
+                  "First array changed size.");
+  DAX_TEST_ASSERT(second.GetNumberOfValues() == SECOND_SIZE,
+                  "Second array changed size.");
+  DAX_TEST_ASSERT(first.GetPortalConstControl().Get(FIRST_SIZE-1)
+                  == -TestValue(FIRST_SIZE-1),
+                  "Bad worklet output.");
+  DAX_TEST_ASSERT(second.GetPortalConstControl().Get(0)
+                  == -TestValue(FIRST_SIZE),
+                  "Bad worklet output.");
+}
+
+void TestArrayHandleConcatenate()
+{
+  TestRead();
+  TestWrite();
+  TestWorklet();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleConcatenate(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleConcatenate);
+}
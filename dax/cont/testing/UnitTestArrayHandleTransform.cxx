@@ -0,0 +1,150 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleTransform.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/exec/WorkletMapField.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/cont/testing/Testing.h>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+struct HalfFunctor
+{
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar operator()(dax::Id value) const
+  {
+    return 0.5f*value;
+  }
+};
+
+struct MagnitudeFunctor
+{
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar operator()(const dax::Vector3 &value) const
+  {
+    return dax::math::Magnitude(value);
+  }
+};
+
+struct AddOne : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar value) const
+  {
+    return value + 1;
+  }
+};
+
+void TestTransformCounting()
+{
+  std::cout << "Transforming counting array." << std::endl;
+  typedef dax::cont::ArrayHandleCounting<dax::Id> CountingType;
+  dax::cont::ArrayHandleTransform<dax::Scalar, CountingType, HalfFunctor>
+      transform = dax::cont::make_ArrayHandleTransform<dax::Scalar>(
+        CountingType(0, ARRAY_SIZE), HalfFunctor());
+
+  DAX_TEST_ASSERT(transform.GetNumberOfValues() == ARRAY_SIZE,
+                  "Bad number of values.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(transform.GetPortalConstControl().Get(index),
+                               0.5f*index),
+                    "Bad value in control portal.");
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> copy;
+  Algorithm::Copy(transform, copy);
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  transform.CopyInto(values.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(copy.GetPortalConstControl().Get(index),
+                               0.5f*index),
+                    "Bad value copied in execution environment.");
+    DAX_TEST_ASSERT(test_equal(values[index], 0.5f*index),
+                    "Bad value from CopyInto.");
+    }
+
+  std::cout << "Writing transformed array." << std::endl;
+  try
+    {
+    transform.PrepareForOutput(ARRAY_SIZE);
+    DAX_TEST_FAIL("Wrote to transformed array.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestTransformWorkletInput()
+{
+  std::cout << "Using transformed coordinates as worklet input." << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(4, 4, 4));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1.0, 2.0));
+
+  typedef dax::cont::UniformGrid<>::PointCoordinatesType CoordinatesType;
+  dax::cont::ArrayHandleTransform<dax::Scalar, CoordinatesType, MagnitudeFunctor>
+      magnitudes(grid.GetPointCoordinates());
+
+  dax::cont::ArrayHandle<dax::Scalar> result;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(AddOne(), magnitudes, result);
+
+  DAX_TEST_ASSERT(result.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Bad result size.");
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    const dax::Scalar expected =
+        dax::math::Magnitude(grid.ComputePointCoordinates(index)) + 1;
+    DAX_TEST_ASSERT(test_equal(result.GetPortalConstControl().Get(index),
+                               expected),
+                    "Bad result from transformed input.");
+    }
+}
+
+void TestArrayHandleTransform()
+{
+  TestTransformCounting();
+  TestTransformWorkletInput();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleTransform(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleTransform);
+}
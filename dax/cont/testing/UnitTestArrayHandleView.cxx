@@ -0,0 +1,205 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleView.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+const dax::Id OFFSET = 25;
+const dax::Id LENGTH = 50;
+
+typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+dax::Id TestValue(dax::Id index) { return 3*index + 1; }
+
+dax::cont::ArrayHandle<dax::Id> MakeTestArray()
+{
+  dax::cont::ArrayHandle<dax::Id> array;
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0), ARRAY_SIZE),
+                  array);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    array.GetPortalControl().Set(index, TestValue(index));
+    }
+  return array;
+}
+
+void TestRead()
+{
+  std::cout << "Reading through view." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> array = MakeTestArray();
+  dax::cont::ArrayHandleView<dax::cont::ArrayHandle<dax::Id> > view =
+      dax::cont::make_ArrayHandleView(array, OFFSET, LENGTH);
+
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == LENGTH, "Bad view length.");
+  for (dax::Id index = 0; index < LENGTH; index++)
+    {
+    DAX_TEST_ASSERT(view.GetPortalConstControl().Get(index)
+                    == TestValue(index + OFFSET),
+                    "Bad value in control portal.");
+    }
+
+  DAX_TEST_ASSERT(&*view.PrepareForInput().GetIteratorBegin()
+                  == &*array.PrepareForInput().GetIteratorBegin() + OFFSET,
+                  "View copied the array.");
+
+  dax::cont::ArrayHandle<dax::Id> copy;
+  Algorithm::Copy(view, copy);
+  DAX_TEST_ASSERT(copy.GetNumberOfValues() == LENGTH, "Bad copy length.");
+  std::vector<dax::Id> values(LENGTH);
+  view.CopyInto(values.begin());
+  for (dax::Id index = 0; index < LENGTH; index++)
+    {
+    DAX_TEST_ASSERT(copy.GetPortalConstControl().Get(index)
+                    == TestValue(index + OFFSET),
+                    "Bad value copied from view.");
+    DAX_TEST_ASSERT(values[index] == TestValue(index + OFFSET),
+                    "Bad value from CopyInto.");
+    }
+
+  std::cout << "Viewing a view." << std::endl;
+  dax::Id sum = Algorithm::ScanInclusive(
+        dax::cont::make_ArrayHandleView(view, 1, 2), copy);
+  DAX_TEST_ASSERT(sum == TestValue(OFFSET+1) + TestValue(OFFSET+2),
+                  "Bad scan of view of view.");
+}
+
+void TestWrite()
+{
+  std::cout << "Writing through view." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> array = MakeTestArray();
+  dax::cont::ArrayHandleView<dax::cont::ArrayHandle<dax::Id> > view =
+      dax::cont::make_ArrayHandleView(array, OFFSET, LENGTH);
+
+  // Reverse the values in the view, then sort them back in place.
+  for (dax::Id index = 0; index < LENGTH; index++)
+    {
+    view.GetPortalControl().Set(index, TestValue(OFFSET + LENGTH - index - 1));
+    }
+  DAX_TEST_ASSERT(array.GetPortalConstControl().Get(OFFSET)
+                  == TestValue(OFFSET + LENGTH - 1),
+                  "Write through view not in array.");
+  Algorithm::Sort(view);
+
+  std::cout << "Using view as output." << std::endl;
+  dax::cont::ArrayHandleView<dax::cont::ArrayHandle<dax::Id> > head =
+      dax::cont::make_ArrayHandleView(array, 0, OFFSET);
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0), OFFSET),
+                  head);
+
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    const dax::Id expected = (index < OFFSET) ? index : TestValue(index);
+    DAX_TEST_ASSERT(array.GetPortalConstControl().Get(index) == expected,
+                    "Bad value in array after writing view.");
+    }
+
+  std::cout << "Shrinking view." << std::endl;
+  view.Shrink(LENGTH/2);
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == LENGTH/2, "View did not shrink.");
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Shrinking view shrank array.");
+
+  std::cout << "Growing view." << std::endl;
+  try
+    {
+    Algorithm::Copy(array, head);
+    DAX_TEST_FAIL("View grown past its end.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestBadRange()
+{
+  std::cout << "Making view past end." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> array = MakeTestArray();
+  try
+    {
+    dax::cont::make_ArrayHandleView(array, OFFSET, ARRAY_SIZE);
+    DAX_TEST_FAIL("Made view past end of array.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestWorklet()
+{
+  std::cout << "Passing views to a worklet." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> array = MakeTestArray();
+  dax::cont::ArrayHandle<dax::Id> squares;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Square(),
+                   dax::cont::make_ArrayHandleView(array, OFFSET, LENGTH),
+                   squares);
+  DAX_TEST_ASSERT(squares.GetNumberOfValues() == LENGTH,
+                  "Bad length of worklet output.");
+  for (dax::Id index = 0; index < LENGTH; index++)
+    {
+    const dax::Id value = TestValue(index + OFFSET);
+    DAX_TEST_ASSERT(squares.GetPortalConstControl().Get(index) == value*value,
+                    "Bad worklet output from view.");
+    }
+
+  std::cout << "Writing worklet output into a view." << std::endl;
+  scheduler.Invoke(dax::worklet::Square(),
+                   dax::cont::make_ArrayHandleCounting(dax::Id(0), LENGTH),
+                   dax::cont::make_ArrayHandleView(array, OFFSET, LENGTH));
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Writing view resized array.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    const dax::Id viewIndex = index - OFFSET;
+    const dax::Id expected =
+        ((viewIndex >= 0) && (viewIndex < LENGTH))
+        ? viewIndex*viewIndex : TestValue(index);
+    DAX_TEST_ASSERT(array.GetPortalConstControl().Get(index) == expected,
+                    "Bad value in array after worklet wrote view.");
+    }
+}
+
+void TestArrayHandleView()
+{
+  TestRead();
+  TestWrite();
+  TestBadRange();
+  TestWorklet();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleView(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleView);
+}
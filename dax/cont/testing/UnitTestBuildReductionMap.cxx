@@ -21,6 +21,7 @@
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapterSerial.h>
 #include <dax/cont/ReduceKeysValues.h>
+#include <dax/cont/ReductionMap.h>
 
 #include <dax/exec/WorkletReduceKeysValues.h>
 
@@ -115,11 +116,12 @@ KeyMapType BuildSerialKeyMap(const ArrayType &inputKeys)
   return keyMap;
 }
 
-DaxKeyMapType BuildDaxKeyMap(const ArrayType &inputKeys)
+DaxKeyMapType BuildDaxKeyMap(const ArrayType &inputKeys, dax::Id keyRange)
 {
   std::cout << "Building Dax version of key map" << std::endl;
 
   DaxKeyMapType keyMap(inputKeys);
+  keyMap.SetKeyRange(keyRange);
   keyMap.BuildReductionMap();
 
 #ifdef PRINT_VALUES
@@ -198,14 +200,42 @@ void CheckKeyMap(KeyMapType serialMap, DaxKeyMapType daxMap)
     }
 }
 
+void TestSharedReductionMap(const ArrayType &inputKeys,
+                            const KeyMapType &serialMap)
+{
+  std::cout << "Sharing one reduction map between reductions" << std::endl;
+
+  dax::cont::ReductionMap<ArrayType> map(inputKeys);
+  DaxKeyMapType firstReduction(map);
+  DaxKeyMapType secondReduction(map, DummyWorklet());
+  DAX_TEST_ASSERT(!map.IsValid(), "Map built too early.");
+
+  firstReduction.BuildReductionMap();
+  DAX_TEST_ASSERT(map.IsValid(), "Building through a user did not build map.");
+  DAX_TEST_ASSERT(secondReduction.GetReductionMap().IsValid(),
+                  "Map not shared.");
+  DAX_TEST_ASSERT(secondReduction.GetReductionIndices().GetPortalConstControl()
+                    .GetIteratorBegin() ==
+                  map.GetReductionIndices().GetPortalConstControl()
+                    .GetIteratorBegin(),
+                  "Reductions do not share the same arrays.");
+  CheckKeyMap(serialMap, secondReduction);
+}
+
 void RunBuildReductionMap()
 {
   srandom(time(NULL));
 
   ArrayType randomKeyInput = MakeInputArray();
   KeyMapType serialMap = BuildSerialKeyMap(randomKeyInput);
-  DaxKeyMapType daxMap = BuildDaxKeyMap(randomKeyInput);
+  DaxKeyMapType daxMap = BuildDaxKeyMap(randomKeyInput, 0);
   CheckKeyMap(serialMap, daxMap);
+
+  std::cout << "Using counting sort with declared key range" << std::endl;
+  DaxKeyMapType countingMap = BuildDaxKeyMap(randomKeyInput, NUM_KEYS);
+  CheckKeyMap(serialMap, countingMap);
+
+  TestSharedReductionMap(randomKeyInput, serialMap);
 }
 
 } // anonymous namespace
@@ -0,0 +1,183 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/FieldStatistics.h>
+
+#include <dax/cont/ArrayHandleConstant.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <math.h>
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100003;
+const dax::Id NUMBER_OF_BINS = 17;
+
+typedef dax::cont::FieldStatistics<> FieldStatisticsType;
+
+// A skewed field: most of the values are small.
+dax::Scalar TestValue(dax::Id index)
+{
+  const dax::Scalar fraction =
+      static_cast<dax::Scalar>((index*7919)%ARRAY_SIZE)/ARRAY_SIZE;
+  return 1000 + 50*fraction*fraction;
+}
+
+bool test_close(double computed, double expected)
+{
+  return fabs(computed - expected) <= 1e-6*(1 + fabs(expected));
+}
+
+void CheckStatistics(const FieldStatisticsType &statistics,
+                     const std::vector<dax::Scalar> &values)
+{
+  const dax::Id numValues = static_cast<dax::Id>(values.size());
+  double minimum = values[0];
+  double maximum = values[0];
+  double sum = 0;
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    minimum = std::min(minimum, static_cast<double>(values[index]));
+    maximum = std::max(maximum, static_cast<double>(values[index]));
+    sum += values[index];
+    }
+  const double mean = sum/numValues;
+  double m2 = 0;
+  double m3 = 0;
+  for (dax::Id index = 0; index < numValues; index++)
+    {
+    const double difference = values[index] - mean;
+    m2 += difference*difference;
+    m3 += difference*difference*difference;
+    }
+  const double variance = m2/numValues;
+  const double skewness = (m3/numValues)/pow(variance, 1.5);
+
+  std::cout << "  mean " << statistics.GetMean()
+            << " variance " << statistics.GetVariance()
+            << " skewness " << statistics.GetSkewness() << std::endl;
+  DAX_TEST_ASSERT(statistics.GetNumberOfValues() == numValues,
+                  "Wrong number of values.");
+  DAX_TEST_ASSERT(statistics.GetMinimum() == minimum, "Wrong minimum.");
+  DAX_TEST_ASSERT(statistics.GetMaximum() == maximum, "Wrong maximum.");
+  DAX_TEST_ASSERT(test_close(statistics.GetMean(), mean), "Wrong mean.");
+  DAX_TEST_ASSERT(test_close(statistics.GetVariance(), variance),
+                  "Wrong variance.");
+  DAX_TEST_ASSERT(test_close(statistics.GetSkewness(), skewness),
+                  "Wrong skewness.");
+}
+
+void CheckHistogram(
+    const FieldStatisticsType::IdArrayHandleType &histogram,
+    const std::vector<dax::Scalar> &values,
+    double minimum,
+    double maximum)
+{
+  DAX_TEST_ASSERT(histogram.GetNumberOfValues() == NUMBER_OF_BINS,
+                  "Wrong number of bins.");
+  std::vector<dax::Id> expected(NUMBER_OF_BINS, 0);
+  for (std::size_t index = 0; index < values.size(); index++)
+    {
+    const double value = values[index];
+    if ((value < minimum) || (value > maximum)) { continue; }
+    dax::Id bin = static_cast<dax::Id>(
+          (value - minimum)*(NUMBER_OF_BINS/(maximum - minimum)));
+    expected[std::min(bin, NUMBER_OF_BINS-1)]++;
+    }
+  for (dax::Id bin = 0; bin < NUMBER_OF_BINS; bin++)
+    {
+    DAX_TEST_ASSERT(histogram.GetPortalConstControl().Get(bin)
+                    == expected[bin],
+                    "Wrong histogram count.");
+    }
+}
+
+void TestFieldStatistics()
+{
+  std::vector<dax::Scalar> values(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    values[index] = TestValue(index);
+    }
+  FieldStatisticsType::IdArrayHandleType histogram;
+
+  // Use small blocks so that many partial results are merged.
+  FieldStatisticsType statistics;
+  statistics.SetMaximumNumberOfBlocks(64);
+  statistics.SetMinimumBlockSize(100);
+
+  std::cout << "Statistics of a field." << std::endl;
+  statistics.Run(dax::cont::make_ArrayHandle(values));
+  CheckStatistics(statistics, values);
+
+  std::cout << "Histogram of the field range." << std::endl;
+  statistics.RunHistogram(dax::cont::make_ArrayHandle(values),
+                          NUMBER_OF_BINS,
+                          histogram);
+  CheckHistogram(histogram,
+                 values,
+                 statistics.GetMinimum(),
+                 statistics.GetMaximum());
+  DAX_TEST_ASSERT(
+        histogram.GetPortalConstControl().Get(0)
+        > histogram.GetPortalConstControl().Get(NUMBER_OF_BINS-1),
+        "Histogram does not show the skew.");
+
+  std::cout << "Histogram of part of the range." << std::endl;
+  statistics.RunHistogram(dax::cont::make_ArrayHandle(values),
+                          NUMBER_OF_BINS,
+                          1010.0,
+                          1030.0,
+                          histogram);
+  CheckHistogram(histogram, values, 1010.0, 1030.0);
+
+  std::cout << "Statistics of a field in one block." << std::endl;
+  values.resize(50);
+  FieldStatisticsType defaultStatistics;
+  defaultStatistics.Run(dax::cont::make_ArrayHandle(values));
+  CheckStatistics(defaultStatistics, values);
+
+  std::cout << "Statistics of a constant field." << std::endl;
+  defaultStatistics.Run(
+        dax::cont::make_ArrayHandleConstant(dax::Scalar(3), 1000));
+  DAX_TEST_ASSERT(defaultStatistics.GetMinimum() == 3, "Wrong minimum.");
+  DAX_TEST_ASSERT(defaultStatistics.GetMaximum() == 3, "Wrong maximum.");
+  DAX_TEST_ASSERT(defaultStatistics.GetMean() == 3, "Wrong mean.");
+  DAX_TEST_ASSERT(defaultStatistics.GetVariance() == 0, "Wrong variance.");
+  DAX_TEST_ASSERT(defaultStatistics.GetSkewness() == 0, "Wrong skewness.");
+  defaultStatistics.RunHistogram(
+        dax::cont::make_ArrayHandleConstant(dax::Scalar(3), 1000),
+        NUMBER_OF_BINS,
+        histogram);
+  DAX_TEST_ASSERT(histogram.GetPortalConstControl().Get(0) == 1000,
+                  "Constant values not in first bin.");
+
+  std::cout << "Statistics of an empty field." << std::endl;
+  defaultStatistics.Run(dax::cont::ArrayHandle<dax::Scalar>());
+  DAX_TEST_ASSERT(defaultStatistics.GetNumberOfValues() == 0,
+                  "Wrong number of values.");
+  DAX_TEST_ASSERT(defaultStatistics.GetVariance() == 0, "Wrong variance.");
+}
+
+} // anonymous namespace
+
+int UnitTestFieldStatistics(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestFieldStatistics);
+}
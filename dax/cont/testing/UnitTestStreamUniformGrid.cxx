@@ -0,0 +1,264 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/StreamUniformGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/GenerateInterpolatedCells.h>
+#include <dax/cont/GenerateTopology.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/worklet/MarchingCubes.h>
+#include <dax/worklet/Threshold.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+const dax::Id3 DIMENSIONS = dax::make_Id3(12, 10, 23);
+const dax::Id CELLS_PER_SLAB = 5;
+const char FILENAME[] = "UnitTestStreamUniformGrid.raw";
+
+const dax::Scalar ISOVALUE = 60;
+const dax::Scalar MIN_THRESHOLD = 40;
+const dax::Scalar MAX_THRESHOLD = 80;
+
+typedef dax::cont::UniformGrid<> UniformGridType;
+typedef dax::cont::UnstructuredGrid<dax::CellTagHexahedron> HexahedronGridType;
+typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> TriangleGridType;
+
+UniformGridType MakeGrid()
+{
+  UniformGridType grid;
+  grid.SetOrigin(dax::make_Vector3(-1.0, 0.5, 2.0));
+  grid.SetSpacing(dax::make_Vector3(1.0, 2.0, 0.5));
+  grid.SetExtent(dax::make_Id3(0, 0, 0),
+                 dax::make_Id3(DIMENSIONS[0]-1, DIMENSIONS[1]-1, DIMENSIONS[2]-1));
+  return grid;
+}
+
+dax::Scalar FieldValue(const dax::Vector3 &coordinates)
+{
+  return dax::dot(coordinates, coordinates);
+}
+
+std::vector<dax::Scalar> MakeField(const UniformGridType &grid)
+{
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    field[index] = FieldValue(grid.ComputePointCoordinates(index));
+    }
+  return field;
+}
+
+void WriteTestFile(const std::vector<dax::Scalar> &field)
+{
+  std::ofstream file(FILENAME, std::ios::out | std::ios::binary);
+  file.write(reinterpret_cast<const char *>(&field[0]),
+             field.size()*sizeof(dax::Scalar));
+}
+
+template<class FieldHandleType>
+void RunThreshold(const UniformGridType &grid,
+                  FieldHandleType field,
+                  HexahedronGridType &output)
+{
+  typedef dax::cont::GenerateTopology<dax::worklet::ThresholdTopology>
+      GenerateTopologyType;
+
+  dax::cont::Scheduler<> scheduler;
+  typename GenerateTopologyType::ClassifyResultType classification;
+  scheduler.Invoke(
+        dax::worklet::ThresholdClassify<dax::Scalar>(MIN_THRESHOLD,
+                                                     MAX_THRESHOLD),
+        grid,
+        field,
+        classification);
+  GenerateTopologyType generate(classification);
+  scheduler.Invoke(generate, grid, output);
+}
+
+template<class FieldHandleType>
+void RunMarchingCubes(const UniformGridType &grid,
+                      FieldHandleType field,
+                      TriangleGridType &output)
+{
+  typedef dax::cont::ArrayHandle<dax::Id> ClassifyResultType;
+  typedef dax::cont::GenerateInterpolatedCells<
+      dax::worklet::MarchingCubesGenerate, ClassifyResultType>
+      GenerateCellsType;
+
+  dax::cont::Scheduler<> scheduler;
+  ClassifyResultType classification;
+  scheduler.Invoke(dax::worklet::MarchingCubesClassify(ISOVALUE),
+                   grid,
+                   field,
+                   classification);
+  GenerateCellsType generate(classification,
+                             dax::worklet::MarchingCubesGenerate(ISOVALUE));
+  scheduler.Invoke(generate, grid, output, field);
+}
+
+struct ThresholdPipeline
+{
+  dax::cont::UnstructuredGridAppender<HexahedronGridType> Output;
+
+  template<class FieldHandleType>
+  void operator()(const UniformGridType &grid,
+                  FieldHandleType field,
+                  dax::Id)
+  {
+    HexahedronGridType slabOutput;
+    RunThreshold(grid, field, slabOutput);
+    this->Output.Append(slabOutput);
+  }
+};
+
+struct MarchingCubesPipeline
+{
+  dax::cont::UnstructuredGridAppender<TriangleGridType> Output;
+  dax::Id NumberOfSlabs;
+
+  MarchingCubesPipeline() : NumberOfSlabs(0) {  }
+
+  template<class FieldHandleType>
+  void operator()(const UniformGridType &grid,
+                  FieldHandleType field,
+                  dax::Id slab)
+  {
+    DAX_TEST_ASSERT(slab == this->NumberOfSlabs, "Slabs out of order.");
+    this->NumberOfSlabs++;
+
+    TriangleGridType slabOutput;
+    RunMarchingCubes(grid, field, slabOutput);
+    this->Output.Append(slabOutput);
+  }
+};
+
+template<class GridType>
+void CheckSameCells(const GridType &streamed, const GridType &inCore)
+{
+  DAX_TEST_ASSERT(streamed.GetNumberOfCells() == inCore.GetNumberOfCells(),
+                  "Streamed output has wrong number of cells.");
+  DAX_TEST_ASSERT(inCore.GetNumberOfCells() > 0, "Test produced no cells.");
+
+  typename GridType::CellConnectionsType::PortalConstControl
+      streamedConnections =
+        streamed.GetCellConnections().GetPortalConstControl();
+  typename GridType::CellConnectionsType::PortalConstControl
+      inCoreConnections = inCore.GetCellConnections().GetPortalConstControl();
+  typename GridType::PointCoordinatesType::PortalConstControl
+      streamedPoints = streamed.GetPointCoordinates().GetPortalConstControl();
+  typename GridType::PointCoordinatesType::PortalConstControl
+      inCorePoints = inCore.GetPointCoordinates().GetPortalConstControl();
+  for (dax::Id index = 0;
+       index < inCoreConnections.GetNumberOfValues();
+       index++)
+    {
+    DAX_TEST_ASSERT(
+          test_equal(streamedPoints.Get(streamedConnections.Get(index)),
+                     inCorePoints.Get(inCoreConnections.Get(index))),
+          "Streamed cell differs from in-core cell.");
+    }
+}
+
+void TestSlabs()
+{
+  std::cout << "Checking slabs." << std::endl;
+  UniformGridType grid = MakeGrid();
+  dax::cont::StreamUniformGrid<> stream(grid, CELLS_PER_SLAB);
+  DAX_TEST_ASSERT(stream.GetNumberOfSlabs() == 5, "Wrong number of slabs.");
+
+  dax::Id numberOfCells = 0;
+  for (dax::Id slab = 0; slab < stream.GetNumberOfSlabs(); slab++)
+    {
+    UniformGridType slabGrid = stream.GetSlabGrid(slab);
+    numberOfCells += slabGrid.GetNumberOfCells();
+    DAX_TEST_ASSERT(stream.GetSlabFirstPoint(slab)
+                    == slab*CELLS_PER_SLAB*DIMENSIONS[0]*DIMENSIONS[1],
+                    "Wrong first point of slab.");
+    DAX_TEST_ASSERT(test_equal(slabGrid.ComputePointCoordinates(0),
+                               grid.ComputePointCoordinates(
+                                 stream.GetSlabFirstPoint(slab))),
+                    "Slab has wrong coordinates.");
+    }
+  DAX_TEST_ASSERT(numberOfCells == grid.GetNumberOfCells(),
+                  "Slabs do not cover the grid.");
+}
+
+void TestStreamThreshold()
+{
+  std::cout << "Streaming threshold from a raw file." << std::endl;
+  UniformGridType grid = MakeGrid();
+  std::vector<dax::Scalar> field = MakeField(grid);
+  WriteTestFile(field);
+
+  ThresholdPipeline pipeline;
+  {
+    dax::cont::StreamReaderRawFile<dax::Scalar> reader(FILENAME);
+    dax::cont::StreamUniformGrid<>(grid, CELLS_PER_SLAB).Run(reader, pipeline);
+  }
+  std::remove(FILENAME);
+
+  HexahedronGridType inCore;
+  RunThreshold(grid, dax::cont::make_ArrayHandle(field), inCore);
+  CheckSameCells(pipeline.Output.GetGrid(), inCore);
+}
+
+void TestStreamMarchingCubes()
+{
+  std::cout << "Streaming marching cubes from a portal." << std::endl;
+  UniformGridType grid = MakeGrid();
+  std::vector<dax::Scalar> field = MakeField(grid);
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  typedef dax::cont::ArrayHandle<dax::Scalar>::PortalConstControl PortalType;
+  dax::cont::StreamReaderPortal<PortalType>
+      reader(fieldHandle.GetPortalConstControl());
+  MarchingCubesPipeline pipeline;
+  dax::cont::StreamUniformGrid<> stream(grid, CELLS_PER_SLAB);
+  stream.Run(reader, pipeline);
+  DAX_TEST_ASSERT(pipeline.NumberOfSlabs == stream.GetNumberOfSlabs(),
+                  "Pipeline not run on every slab.");
+
+  TriangleGridType inCore;
+  RunMarchingCubes(grid, fieldHandle, inCore);
+  CheckSameCells(pipeline.Output.GetGrid(), inCore);
+}
+
+void TestStreamUniformGrid()
+{
+  TestSlabs();
+  TestStreamThreshold();
+  TestStreamMarchingCubes();
+}
+
+} // anonymous namespace
+
+int UnitTestStreamUniformGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestStreamUniformGrid);
+}
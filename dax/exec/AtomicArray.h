@@ -0,0 +1,107 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_AtomicArray_h
+#define __dax_exec_AtomicArray_h
+
+#include <dax/Types.h>
+#include <dax/exec/ExecutionObjectBase.h>
+#include <dax/exec/internal/AtomicOperations.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief An array that worklets update with atomic operations.
+///
+/// Field outputs let each worklet instance write only its own value. An
+/// AtomicArray, passed to a worklet as an \c ExecObject, lets any instance
+/// update any value safely, so scatter algorithms (histograms, counting,
+/// accumulating cell values to points) run in one pass instead of sorting
+/// by key. Get one from dax::cont::AtomicArray::PrepareForExecution.
+///
+/// Every operation returns the value held before the operation. \c T has to
+/// be a 4 or 8 byte type such as dax::Id or dax::Scalar. Contended updates of
+/// the same value serialize, so spread updates over many values where
+/// possible (for example one histogram per block of values).
+///
+template<typename T, class DeviceAdapterTag>
+class AtomicArray : public dax::exec::ExecutionObjectBase
+{
+  typedef dax::exec::internal::AtomicOperations<DeviceAdapterTag> Operations;
+
+public:
+  typedef T ValueType;
+
+  DAX_CONT_EXPORT
+  AtomicArray() : Data(NULL), NumberOfValues(0) {  }
+
+  DAX_CONT_EXPORT
+  AtomicArray(ValueType *data, dax::Id numberOfValues)
+    : Data(data), NumberOfValues(numberOfValues) {  }
+
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_EXEC_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return Operations::Load(this->GetAddress(index));
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Add(dax::Id index, const ValueType &value) const
+  {
+    return Operations::Add(this->GetAddress(index), value);
+  }
+
+  /// Sets the value at \p index to \p newValue if it is \p expected.
+  ///
+  DAX_EXEC_EXPORT
+  ValueType CompareAndSwap(dax::Id index,
+                           const ValueType &newValue,
+                           const ValueType &expected) const
+  {
+    return Operations::CompareAndSwap(this->GetAddress(index),
+                                      newValue,
+                                      expected);
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Min(dax::Id index, const ValueType &value) const
+  {
+    return Operations::Min(this->GetAddress(index), value);
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Max(dax::Id index, const ValueType &value) const
+  {
+    return Operations::Max(this->GetAddress(index), value);
+  }
+
+private:
+  DAX_EXEC_EXPORT
+  ValueType *GetAddress(dax::Id index) const
+  {
+    return this->Data + index;
+  }
+
+  ValueType *Data;
+  dax::Id NumberOfValues;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_AtomicArray_h
@@ -0,0 +1,278 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_CellLocatorUniformBins_h
+#define __dax_exec_CellLocatorUniformBins_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/ExecutionObjectBase.h>
+#include <dax/exec/Interpolate.h>
+#include <dax/exec/ParametricCoordinates.h>
+
+#include <dax/math/Compare.h>
+#include <dax/math/Precision.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Describes an axis-aligned grid of bins used to spatially index cells. The
+/// bins cover the box starting at \c Origin with \c NumberOfBins divisions
+/// along each axis. Coordinates are always clamped to a valid bin, so callers
+/// should check \c Contains or \c Overlaps first.
+///
+struct UniformBinning
+{
+  dax::Vector3 Origin;
+  dax::Vector3 InverseBinSize;
+  dax::Id3 NumberOfBins;
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfBins() const
+  {
+    return this->NumberOfBins[0]*this->NumberOfBins[1]*this->NumberOfBins[2];
+  }
+
+  /// Returns true if \p coords is inside the binned region.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  bool Contains(const dax::Vector3 &coords) const
+  {
+    return this->Overlaps(coords, coords);
+  }
+
+  /// Returns true if the box given by \p minCoords and \p maxCoords touches
+  /// the binned region.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  bool Overlaps(const dax::Vector3 &minCoords,
+                const dax::Vector3 &maxCoords) const
+  {
+    const dax::Vector3 minBin = (minCoords - this->Origin)*this->InverseBinSize;
+    const dax::Vector3 maxBin = (maxCoords - this->Origin)*this->InverseBinSize;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      if ((maxBin[dimension] < 0)
+          || (minBin[dimension] > this->NumberOfBins[dimension]))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  /// Returns the i, j, k index of the bin containing \p coords.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id3 BinIndex3(const dax::Vector3 &coords) const
+  {
+    const dax::Vector3 binCoords =
+        dax::math::Floor((coords - this->Origin)*this->InverseBinSize);
+    dax::Id3 ijk;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      ijk[dimension] = dax::math::Max(
+            dax::Id(0),
+            dax::math::Min(static_cast<dax::Id>(binCoords[dimension]),
+                           this->NumberOfBins[dimension] - 1));
+      }
+    return ijk;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id FlatBinIndex(const dax::Id3 &ijk) const
+  {
+    return ijk[0] + this->NumberOfBins[0]*(ijk[1] + this->NumberOfBins[1]*ijk[2]);
+  }
+};
+
+} // namespace internal
+
+/// \brief Finds the cell containing a point.
+///
+/// CellLocatorUniformBins is an execution object that, given a world
+/// coordinate, returns the cell containing it along with the parametric
+/// coordinates of the point within that cell. Candidate cells are looked up
+/// through a uniform grid of bins, each of which lists the cells whose
+/// bounding boxes overlap it. The bins are built in the control environment by
+/// dax::cont::CellLocatorUniformBins, which is also the preferred way to
+/// construct this object.
+///
+template<class TopologyT, class CoordinatesPortalT, class IdPortalT>
+class CellLocatorUniformBins : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef TopologyT TopologyType;
+  typedef typename TopologyType::CellTag CellTag;
+  typedef CoordinatesPortalT CoordinatesPortalType;
+  typedef IdPortalT IdPortalType;
+
+  DAX_CONT_EXPORT
+  CellLocatorUniformBins() {  }
+
+  DAX_CONT_EXPORT
+  CellLocatorUniformBins(const TopologyType &topology,
+                         const CoordinatesPortalType &coordinates,
+                         const dax::exec::internal::UniformBinning &bins,
+                         const IdPortalType &binOffsets,
+                         const IdPortalType &binCellIds)
+    : Topology(topology),
+      Coordinates(coordinates),
+      Bins(bins),
+      BinOffsets(binOffsets),
+      BinCellIds(binCellIds) {  }
+
+  DAX_EXEC_EXPORT
+  dax::exec::CellField<dax::Vector3,CellTag>
+  GetCellVertexCoordinates(dax::Id cellIndex) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    const dax::exec::CellVertices<CellTag> vertices =
+        this->Topology.GetCellConnections(cellIndex);
+    dax::exec::CellField<dax::Vector3,CellTag> coordinates;
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      coordinates[vertexIndex] = this->Coordinates.Get(vertices[vertexIndex]);
+      }
+    return coordinates;
+  }
+
+  /// Returns the index of the cell containing \p point and sets \p pcoords to
+  /// the parametric coordinates of the point in that cell. If no cell contains
+  /// the point, -1 is returned and \p pcoords is left undefined.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id FindCell(const dax::Vector3 &point, dax::Vector3 &pcoords) const
+  {
+    if (!this->Bins.Contains(point))
+      {
+      return -1;
+      }
+
+    const dax::Id binIndex =
+        this->Bins.FlatBinIndex(this->Bins.BinIndex3(point));
+    const dax::Id endIndex = this->BinOffsets.Get(binIndex+1);
+    for (dax::Id index = this->BinOffsets.Get(binIndex);
+         index < endIndex;
+         index++)
+      {
+      const dax::Id cellIndex = this->BinCellIds.Get(index);
+      const dax::exec::CellField<dax::Vector3,CellTag> coordinates =
+          this->GetCellVertexCoordinates(cellIndex);
+
+      // Reject on the bounding box first. It is much cheaper than the
+      // (possibly iterative) inversion to parametric coordinates.
+      if (!this->InsideBounds(coordinates, point)) { continue; }
+
+      pcoords = dax::exec::WorldCoordinatesToParametricCoordinates(
+            coordinates, point, CellTag());
+      if (dax::exec::ParametricCoordinatesInsideCell(
+            pcoords, this->GetParametricTolerance(), CellTag()))
+        {
+        return cellIndex;
+        }
+      }
+    return -1;
+  }
+
+private:
+  DAX_EXEC_EXPORT
+  static dax::Scalar GetParametricTolerance() { return dax::Scalar(1e-4); }
+
+  DAX_EXEC_EXPORT
+  bool InsideBounds(const dax::exec::CellField<dax::Vector3,CellTag> &coords,
+                    const dax::Vector3 &point) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    dax::Vector3 minCoords = coords[0];
+    dax::Vector3 maxCoords = coords[0];
+    for (int vertexIndex = 1; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      minCoords = dax::math::Min(minCoords, coords[vertexIndex]);
+      maxCoords = dax::math::Max(maxCoords, coords[vertexIndex]);
+      }
+    const dax::Vector3 tolerance =
+        (maxCoords - minCoords)*this->GetParametricTolerance();
+    minCoords = minCoords - tolerance;
+    maxCoords = maxCoords + tolerance;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      if ((point[dimension] < minCoords[dimension])
+          || (point[dimension] > maxCoords[dimension]))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  TopologyType Topology;
+  CoordinatesPortalType Coordinates;
+  dax::exec::internal::UniformBinning Bins;
+  IdPortalType BinOffsets;
+  IdPortalType BinCellIds;
+};
+
+/// \brief Interpolates a point field anywhere inside a cell.
+///
+/// Given a cell index and parametric coordinates (as returned from
+/// CellLocatorUniformBins::FindCell), gathers the field values at the cell
+/// vertices and interpolates them. This is the companion of
+/// CellLocatorUniformBins for probing fields of a located grid.
+///
+template<class TopologyT, class FieldPortalT>
+class PointFieldInterpolator : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef TopologyT TopologyType;
+  typedef typename TopologyType::CellTag CellTag;
+  typedef FieldPortalT FieldPortalType;
+  typedef typename FieldPortalType::ValueType ValueType;
+
+  DAX_CONT_EXPORT
+  PointFieldInterpolator() {  }
+
+  DAX_CONT_EXPORT
+  PointFieldInterpolator(const TopologyType &topology,
+                         const FieldPortalType &field)
+    : Topology(topology), Field(field) {  }
+
+  DAX_EXEC_EXPORT
+  ValueType GetValue(dax::Id cellIndex, const dax::Vector3 &pcoords) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    const dax::exec::CellVertices<CellTag> vertices =
+        this->Topology.GetCellConnections(cellIndex);
+    dax::exec::CellField<ValueType,CellTag> values;
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      values[vertexIndex] = this->Field.Get(vertices[vertexIndex]);
+      }
+    return dax::exec::CellInterpolate(values, pcoords, CellTag());
+  }
+
+private:
+  TopologyType Topology;
+  FieldPortalType Field;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_CellLocatorUniformBins_h
@@ -0,0 +1,135 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_CellMeasure_h
+#define __dax_exec_CellMeasure_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/Derivative.h>
+#include <dax/exec/ParametricCoordinates.h>
+
+#include <dax/exec/internal/DerivativeWeights.h>
+
+#include <dax/math/Matrix.h>
+#include <dax/math/Sign.h>
+#include <dax/math/VectorAnalysis.h>
+
+namespace dax { namespace exec {
+
+//-----------------------------------------------------------------------------
+namespace detail {
+
+// The volume of a 3D cell is the integral of the Jacobian determinant over
+// parametric space. We take it at the parametric center, which is exact for
+// cells whose map to world coordinates is affine and a good estimate for
+// mildly distorted cells.
+template<class CellTag>
+DAX_EXEC_EXPORT dax::Scalar CellMeasureFor3DCell(
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertCoords,
+    dax::Scalar parametricVolume)
+{
+  const dax::math::Matrix3x3 jacobian =
+      detail::make_JacobianFor3DCell(
+        dax::exec::internal::DerivativeWeights(
+          dax::exec::ParametricCoordinates<CellTag>::Center(), CellTag()),
+        vertCoords.GetAsTuple());
+  return parametricVolume
+      * dax::math::Abs(dax::math::MatrixDeterminant(jacobian));
+}
+
+}
+
+/// Returns the size of a cell: the volume of 3D cells, the area of 2D cells,
+/// the length of lines and 1 for vertices. Hexahedra and wedges use the
+/// Jacobian at the cell center and quadrilaterals the diagonals, so the
+/// results for those are exact only when the cell is a parallelepiped, an
+/// extruded triangle or a planar quadrilateral. This is intended for
+/// weighting cell contributions, such as when averaging cell values to points.
+///
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &vertCoords,
+    dax::CellTagVoxel)
+{
+  const dax::Vector3 widths = vertCoords[6] - vertCoords[0];
+  return dax::math::Abs(widths[0]*widths[1]*widths[2]);
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron> &vertCoords,
+    dax::CellTagHexahedron)
+{
+  return detail::CellMeasureFor3DCell(vertCoords, 1);
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagWedge> &vertCoords,
+    dax::CellTagWedge)
+{
+  return detail::CellMeasureFor3DCell(vertCoords, dax::Scalar(0.5));
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron>
+        &vertCoords,
+    dax::CellTagTetrahedron)
+{
+  const dax::Vector3 &origin = vertCoords[0];
+  return dax::math::Abs(
+        dax::dot(vertCoords[1] - origin,
+                 dax::math::Cross(vertCoords[2] - origin,
+                                  vertCoords[3] - origin)))
+      / 6;
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagTriangle> &vertCoords,
+    dax::CellTagTriangle)
+{
+  return dax::Scalar(0.5)*dax::math::Magnitude(
+        dax::math::TriangleNormal(vertCoords[0], vertCoords[1], vertCoords[2]));
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagQuadrilateral>
+        &vertCoords,
+    dax::CellTagQuadrilateral)
+{
+  return dax::Scalar(0.5)*dax::math::Magnitude(
+        dax::math::Cross(vertCoords[2] - vertCoords[0],
+                         vertCoords[3] - vertCoords[1]));
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagLine> &vertCoords,
+    dax::CellTagLine)
+{
+  return dax::math::Magnitude(vertCoords[1] - vertCoords[0]);
+}
+
+DAX_EXEC_EXPORT dax::Scalar CellMeasure(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagVertex>
+        &daxNotUsed(vertCoords),
+    dax::CellTagVertex)
+{
+  return 1;
+}
+
+}};
+
+#endif //__dax_exec_CellMeasure_h
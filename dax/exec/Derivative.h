@@ -25,21 +25,42 @@
 #include <dax/exec/internal/DerivativeWeights.h>
 
 #include <dax/math/Matrix.h>
+#include <dax/math/PrecisionPolicy.h>
 #include <dax/math/VectorAnalysis.h>
 
 namespace dax { namespace exec {
 
+//-----------------------------------------------------------------------------
+namespace detail {
+
+DAX_EXEC_EXPORT dax::Vector3 Divide(const dax::Vector3 &numerator,
+                                    const dax::Vector3 &denominator,
+                                    dax::math::PrecisionTagExact)
+{
+  return numerator/denominator;
+}
+DAX_EXEC_EXPORT dax::Vector3 Divide(const dax::Vector3 &numerator,
+                                    const dax::Vector3 &denominator,
+                                    dax::math::PrecisionTagFast)
+{
+  return numerator*dax::math::Reciprocal(denominator,
+                                         dax::math::PrecisionTagFast());
+}
+
+}
+
 //-----------------------------------------------------------------------------
 
 /// Special version of CellDerivative for Voxels or other axis aligned cells
 /// that do not require vertex coordinates.
 ///
-template<class CellTag>
+template<class CellTag, class PrecisionTag>
 DAX_EXEC_EXPORT dax::Vector3 CellDerivativeAxisAligned(
     const dax::Vector3 &parametricCoords,
     const dax::Vector3 &axisAlignedWidths,
     const dax::exec::CellField<dax::Scalar, CellTag> &fieldValues,
-    CellTag)
+    CellTag,
+    PrecisionTag)
 {
   const dax::Id NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
   typedef dax::Tuple<dax::Vector3,NUM_VERTICES> DerivWeights;
@@ -54,7 +75,20 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivativeAxisAligned(
     sum = sum + fieldValues[vertexId] * derivativeWeights[vertexId];
     }
 
-  return sum/axisAlignedWidths;
+  return detail::Divide(sum, axisAlignedWidths, PrecisionTag());
+}
+template<class CellTag>
+DAX_EXEC_EXPORT dax::Vector3 CellDerivativeAxisAligned(
+    const dax::Vector3 &parametricCoords,
+    const dax::Vector3 &axisAlignedWidths,
+    const dax::exec::CellField<dax::Scalar, CellTag> &fieldValues,
+    CellTag)
+{
+  return CellDerivativeAxisAligned(parametricCoords,
+                                   axisAlignedWidths,
+                                   fieldValues,
+                                   CellTag(),
+                                   dax::math::PrecisionTagExact());
 }
 
 /// If you can get the axis aligned widths (i.e. spacing) of the voxel rather
@@ -117,12 +151,13 @@ dax::math::Matrix3x3 make_JacobianFor3DCell(
   return jacobian;
 }
 
-template<class CellTag>
+template<class CellTag, class PrecisionTag>
 DAX_EXEC_EXPORT dax::Vector3 CellDerivativeFor3DCell(
     const dax::Vector3 &parametricCoords,
     const dax::exec::CellField<dax::Vector3, CellTag> &vertCoords,
     const dax::exec::CellField<dax::Scalar, CellTag> &fieldValues,
-    CellTag)
+    CellTag,
+    PrecisionTag)
 {
   const dax::Id NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
   typedef dax::Tuple<dax::Vector3,NUM_VERTICES> DerivWeights;
@@ -165,7 +200,8 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivativeFor3DCell(
   bool valid;  // Ignored.
   return dax::math::SolveLinearSystem(jacobianTranspose,
                                       parametricDerivative,
-                                      valid);
+                                      valid,
+                                      PrecisionTag());
 }
 
 }
@@ -177,7 +213,8 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
     dax::CellTagHexahedron)
 {
   return detail::CellDerivativeFor3DCell(
-        parametricCoords, vertCoords, fieldValues, dax::CellTagHexahedron());
+        parametricCoords, vertCoords, fieldValues, dax::CellTagHexahedron(),
+        dax::math::PrecisionTagExact());
 }
 
 DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
@@ -187,16 +224,19 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
     dax::CellTagWedge)
 {
   return detail::CellDerivativeFor3DCell(
-        parametricCoords, vertCoords, fieldValues, dax::CellTagWedge());
+        parametricCoords, vertCoords, fieldValues, dax::CellTagWedge(),
+        dax::math::PrecisionTagExact());
 }
 
 
 //-----------------------------------------------------------------------------
-DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
-    const dax::Vector3 &daxNotUsed(parametricCoords),
+namespace detail {
+
+template<class PrecisionTag>
+DAX_EXEC_EXPORT dax::Vector3 CellDerivativeForTetrahedron(
     const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron> &vertCoords,
     const dax::exec::CellField<dax::Scalar,dax::CellTagTetrahedron> &fieldValues,
-    dax::CellTagTetrahedron)
+    PrecisionTag)
 {
   // The scalar values of the four points in a tetrahedron completely specify a
   // linear field (with constant gradient). The field, defined by the 3-vector
@@ -247,7 +287,20 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
   //
   bool valid;
 
-  return dax::math::SolveLinearSystem(A, b, valid);
+  return dax::math::SolveLinearSystem(A, b, valid, PrecisionTag());
+}
+
+}
+
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &daxNotUsed(parametricCoords),
+    const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,dax::CellTagTetrahedron> &fieldValues,
+    dax::CellTagTetrahedron)
+{
+  return detail::CellDerivativeForTetrahedron(vertCoords,
+                                              fieldValues,
+                                              dax::math::PrecisionTagExact());
 }
 
 
@@ -480,6 +533,263 @@ DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
   return dax::make_Vector3(0, 0, 0);
 }
 
+//-----------------------------------------------------------------------------
+/// The derivative of a field in a cell is linear in the field values. For a
+/// fixed cell and parametric location it is therefore the sum of each vertex
+/// value times a weight vector. This is the type holding those weights (a
+/// 3xN matrix stored as one column per vertex).
+///
+template<class CellTag>
+struct CellDerivativeOperator
+{
+  typedef dax::Tuple<dax::Vector3,dax::CellTraits<CellTag>::NUM_VERTICES> Type;
+};
+
+/// Returns the weights that ApplyCellDerivativeOperator combines with field
+/// values to get the same result as CellDerivative. The weights depend only on
+/// the cell coordinates, so on a mesh that does not move they can be computed
+/// once and reused for every new field. This general version finds the
+/// weight of each vertex by taking the derivative of a field that is 1 at
+/// that vertex and 0 everywhere else.
+///
+template<class CellTag>
+DAX_EXEC_EXPORT
+typename dax::exec::CellDerivativeOperator<CellTag>::Type
+make_CellDerivativeOperator(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertCoords,
+    CellTag)
+{
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  typename dax::exec::CellDerivativeOperator<CellTag>::Type derivativeOperator;
+  dax::exec::CellField<dax::Scalar,CellTag> unitField(dax::Scalar(0));
+  for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+    {
+    unitField[vertexIndex] = 1;
+    derivativeOperator[vertexIndex] =
+        CellDerivative(parametricCoords, vertCoords, unitField, CellTag());
+    unitField[vertexIndex] = 0;
+    }
+  return derivativeOperator;
+}
+
+DAX_EXEC_EXPORT
+dax::exec::CellDerivativeOperator<dax::CellTagVoxel>::Type
+make_CellDerivativeOperator(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &vertCoords,
+    dax::CellTagVoxel)
+{
+  dax::exec::CellDerivativeOperator<dax::CellTagVoxel>::Type
+      derivativeOperator =
+        dax::exec::internal::DerivativeWeights(parametricCoords,
+                                               dax::CellTagVoxel());
+  const dax::Vector3 axisAlignedWidths = vertCoords[6] - vertCoords[0];
+  for (int vertexIndex = 0;
+       vertexIndex < dax::CellTraits<dax::CellTagVoxel>::NUM_VERTICES;
+       vertexIndex++)
+    {
+    derivativeOperator[vertexIndex] =
+        derivativeOperator[vertexIndex] / axisAlignedWidths;
+    }
+  return derivativeOperator;
+}
+
+namespace detail {
+
+template<class CellTag>
+DAX_EXEC_EXPORT
+typename dax::exec::CellDerivativeOperator<CellTag>::Type
+make_CellDerivativeOperatorFor3DCell(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertCoords,
+    CellTag)
+{
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  typedef typename dax::exec::CellDerivativeOperator<CellTag>::Type
+      OperatorType;
+
+  const OperatorType derivativeWeights =
+      dax::exec::internal::DerivativeWeights(parametricCoords, CellTag());
+
+  // See CellDerivativeFor3DCell. Rather than solving the system with the
+  // transposed Jacobian for one parametric derivative, invert it once and
+  // apply the inverse to the parametric derivative weight of each vertex.
+  bool valid;  // Ignored.
+  const dax::math::Matrix3x3 inverseJacobianTranspose =
+      dax::math::MatrixInverse(
+        dax::math::MatrixTranspose(
+          detail::make_JacobianFor3DCell(derivativeWeights,
+                                         vertCoords.GetAsTuple())),
+        valid);
+
+  OperatorType derivativeOperator;
+  for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+    {
+    derivativeOperator[vertexIndex] =
+        dax::math::MatrixMultiply(inverseJacobianTranspose,
+                                  derivativeWeights[vertexIndex]);
+    }
+  return derivativeOperator;
+}
+
+}
+
+DAX_EXEC_EXPORT
+dax::exec::CellDerivativeOperator<dax::CellTagHexahedron>::Type
+make_CellDerivativeOperator(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron> &vertCoords,
+    dax::CellTagHexahedron)
+{
+  return detail::make_CellDerivativeOperatorFor3DCell(
+        parametricCoords, vertCoords, dax::CellTagHexahedron());
+}
+
+DAX_EXEC_EXPORT
+dax::exec::CellDerivativeOperator<dax::CellTagWedge>::Type
+make_CellDerivativeOperator(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagWedge> &vertCoords,
+    dax::CellTagWedge)
+{
+  return detail::make_CellDerivativeOperatorFor3DCell(
+        parametricCoords, vertCoords, dax::CellTagWedge());
+}
+
+DAX_EXEC_EXPORT
+dax::exec::CellDerivativeOperator<dax::CellTagTetrahedron>::Type
+make_CellDerivativeOperator(
+    const dax::Vector3 &daxNotUsed(parametricCoords),
+    const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron> &vertCoords,
+    dax::CellTagTetrahedron)
+{
+  // See CellDerivativeForTetrahedron. The gradient is inverse(A)*b where the
+  // rows of A are the edges from vertex 0 and b holds the field differences
+  // from vertex 0. So vertex k+1 is weighted by column k of inverse(A), and
+  // vertex 0 by the negated sum of the columns.
+  dax::math::Matrix3x3 A;
+  dax::math::MatrixSetRow(A, 0, vertCoords[1] - vertCoords[0]);
+  dax::math::MatrixSetRow(A, 1, vertCoords[2] - vertCoords[0]);
+  dax::math::MatrixSetRow(A, 2, vertCoords[3] - vertCoords[0]);
+
+  bool valid;  // Ignored.
+  const dax::math::Matrix3x3 inverseA = dax::math::MatrixInverse(A, valid);
+
+  dax::exec::CellDerivativeOperator<dax::CellTagTetrahedron>::Type
+      derivativeOperator;
+  derivativeOperator[1] = dax::math::MatrixColumn(inverseA, 0);
+  derivativeOperator[2] = dax::math::MatrixColumn(inverseA, 1);
+  derivativeOperator[3] = dax::math::MatrixColumn(inverseA, 2);
+  derivativeOperator[0] = dax::Scalar(-1)*(derivativeOperator[1]
+                                           + derivativeOperator[2]
+                                           + derivativeOperator[3]);
+  return derivativeOperator;
+}
+
+/// Computes the derivative of a field from the weights returned by
+/// make_CellDerivativeOperator.
+///
+template<class CellTag>
+DAX_EXEC_EXPORT dax::Vector3 ApplyCellDerivativeOperator(
+    const typename dax::exec::CellDerivativeOperator<CellTag>::Type
+        &derivativeOperator,
+    const dax::exec::CellField<dax::Scalar,CellTag> &fieldValues)
+{
+  // The weights sum to zero (a constant field has no derivative), so we can
+  // subtract the first value from all of them without changing the result.
+  // Doing so keeps a large offset in the field from amplifying the rounding
+  // error in the weights.
+  dax::Vector3 derivative(dax::Scalar(0));
+  for (int vertexIndex = 1;
+       vertexIndex < dax::CellTraits<CellTag>::NUM_VERTICES;
+       vertexIndex++)
+    {
+    derivative = derivative
+        + ((fieldValues[vertexIndex] - fieldValues[0])
+           * derivativeOperator[vertexIndex]);
+    }
+  return derivative;
+}
+
+//-----------------------------------------------------------------------------
+/// Versions of CellDerivative that take the precision a worklet declares.
+/// With dax::math::PrecisionTagFast, voxels, hexahedra, wedges and tetrahedra
+/// solve for the gradient with approximate reciprocals. Other cells compute
+/// the same result as with dax::math::PrecisionTagExact.
+///
+template<class CellTag>
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,CellTag> &fieldValues,
+    CellTag,
+    dax::math::PrecisionTagExact)
+{
+  return CellDerivative(parametricCoords, vertCoords, fieldValues, CellTag());
+}
+template<class CellTag>
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,CellTag> &fieldValues,
+    CellTag,
+    dax::math::PrecisionTagFast)
+{
+  return CellDerivative(parametricCoords, vertCoords, fieldValues, CellTag());
+}
+
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,dax::CellTagVoxel> &fieldValues,
+    dax::CellTagVoxel,
+    dax::math::PrecisionTagFast)
+{
+  dax::Vector3 axisAlignedWidths = vertCoords[6] - vertCoords[0];
+  return CellDerivativeAxisAligned(parametricCoords,
+                                   axisAlignedWidths,
+                                   fieldValues,
+                                   dax::CellTagVoxel(),
+                                   dax::math::PrecisionTagFast());
+}
+
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,dax::CellTagHexahedron> &fieldValues,
+    dax::CellTagHexahedron,
+    dax::math::PrecisionTagFast)
+{
+  return detail::CellDerivativeFor3DCell(
+        parametricCoords, vertCoords, fieldValues, dax::CellTagHexahedron(),
+        dax::math::PrecisionTagFast());
+}
+
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &parametricCoords,
+    const dax::exec::CellField<dax::Vector3,dax::CellTagWedge> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,dax::CellTagWedge> &fieldValues,
+    dax::CellTagWedge,
+    dax::math::PrecisionTagFast)
+{
+  return detail::CellDerivativeFor3DCell(
+        parametricCoords, vertCoords, fieldValues, dax::CellTagWedge(),
+        dax::math::PrecisionTagFast());
+}
+
+DAX_EXEC_EXPORT dax::Vector3 CellDerivative(
+    const dax::Vector3 &daxNotUsed(parametricCoords),
+    const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron> &vertCoords,
+    const dax::exec::CellField<dax::Scalar,dax::CellTagTetrahedron> &fieldValues,
+    dax::CellTagTetrahedron,
+    dax::math::PrecisionTagFast)
+{
+  return detail::CellDerivativeForTetrahedron(vertCoords,
+                                              fieldValues,
+                                              dax::math::PrecisionTagFast());
+}
+
 }};
 
 #endif //__dax_exec_Derivative_h
@@ -0,0 +1,134 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_FieldEvaluatorUniformGrid_h
+#define __dax_exec_FieldEvaluatorUniformGrid_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/ExecutionObjectBase.h>
+#include <dax/exec/Interpolate.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+#include <dax/math/Precision.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief Evaluates a point field of a uniform grid at arbitrary locations.
+///
+/// Because the topology is implicit, the voxel containing a world coordinate
+/// and the parametric coordinates within it are computed directly from the
+/// origin and spacing without any search. The field is then trilinearly
+/// interpolated from the voxel vertices. The grid must have at least one cell
+/// along every axis.
+///
+template<class FieldPortalT>
+class FieldEvaluatorUniformGrid : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef FieldPortalT FieldPortalType;
+  typedef typename FieldPortalType::ValueType ValueType;
+  typedef dax::exec::internal::TopologyUniform TopologyType;
+
+  DAX_CONT_EXPORT
+  FieldEvaluatorUniformGrid() {  }
+
+  DAX_CONT_EXPORT
+  FieldEvaluatorUniformGrid(const TopologyType &topology,
+                            const FieldPortalType &field)
+    : Topology(topology),
+      InverseSpacing(dax::make_Vector3(1.0/topology.Spacing[0],
+                                       1.0/topology.Spacing[1],
+                                       1.0/topology.Spacing[2])),
+      Field(field) {  }
+
+  /// Returns true if \p point is inside the grid.
+  ///
+  DAX_EXEC_EXPORT
+  bool Contains(const dax::Vector3 &point) const
+  {
+    const dax::Vector3 location = this->ComputeLocation(point);
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      if ((location[dimension] < this->Topology.Extent.Min[dimension])
+          || (location[dimension] > this->Topology.Extent.Max[dimension]))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  /// Interpolates the field at \p point and stores it in \p value. Returns
+  /// false (and leaves \p value unchanged) if the point is outside the grid.
+  ///
+  DAX_EXEC_EXPORT
+  bool Evaluate(const dax::Vector3 &point, ValueType &value) const
+  {
+    if (!this->Contains(point)) { return false; }
+
+    const dax::Vector3 location = this->ComputeLocation(point);
+    const dax::Vector3 floorLocation = dax::math::Floor(location);
+    dax::Id3 ijk;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      // Points on the maximum boundary belong to the last cell.
+      ijk[dimension] = static_cast<dax::Id>(floorLocation[dimension]);
+      if (ijk[dimension] >= this->Topology.Extent.Max[dimension])
+        {
+        ijk[dimension] = this->Topology.Extent.Max[dimension] - 1;
+        }
+      }
+
+    const dax::Vector3 pcoords = location - dax::make_Vector3(ijk[0],
+                                                              ijk[1],
+                                                              ijk[2]);
+
+    const int NUM_VERTICES = dax::CellTraits<dax::CellTagVoxel>::NUM_VERTICES;
+    const dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+        this->Topology.GetCellConnections(
+          dax::index3ToFlatIndexCell(ijk, this->Topology.Extent));
+    dax::exec::CellField<ValueType,dax::CellTagVoxel> values;
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      values[vertexIndex] = this->Field.Get(vertices[vertexIndex]);
+      }
+    value = dax::exec::CellInterpolate(values, pcoords, dax::CellTagVoxel());
+    return true;
+  }
+
+private:
+  /// Point location in (continuous) i, j, k index space.
+  DAX_EXEC_EXPORT
+  dax::Vector3 ComputeLocation(const dax::Vector3 &point) const
+  {
+    return (point - this->Topology.Origin)*this->InverseSpacing;
+  }
+
+  TopologyType Topology;
+  dax::Vector3 InverseSpacing;
+  FieldPortalType Field;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_FieldEvaluatorUniformGrid_h
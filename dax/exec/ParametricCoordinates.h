@@ -24,8 +24,10 @@
 #include <dax/exec/Derivative.h>
 #include <dax/exec/Interpolate.h>
 
+#include <dax/math/Compare.h>
 #include <dax/math/Matrix.h>
 #include <dax/math/Numerical.h>
+#include <dax/math/Precision.h>
 #include <dax/math/VectorAnalysis.h>
 
 namespace dax {
@@ -248,8 +250,125 @@ DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
   return cellOffset / axisAlignedWidths;
 }
 
-// TODO: Special versions of parametric to world and vice versa for voxels
-// that requires only origin and spacing.
+//-----------------------------------------------------------------------------
+namespace detail {
+
+/// Converts world coordinates to parametric coordinates for one cell. The
+/// constructor does whatever work depends only on the cell (for example,
+/// inverting a constant Jacobian), so converting many points in the same cell
+/// with one functor is cheaper than calling
+/// WorldCoordinatesToParametricCoordinates for each of them. This general
+/// version does no such work and simply forwards to
+/// WorldCoordinatesToParametricCoordinates.
+///
+template<class CellTag>
+class WorldToParametricFunctor {
+  // Be careful!  Don't let member go out of scope!
+  const dax::exec::CellField<dax::Vector3,CellTag> &VertexCoordinates;
+public:
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctor(
+      const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords)
+    : VertexCoordinates(vertexCoords) {  }
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &worldCoords) const {
+    return WorldCoordinatesToParametricCoordinates(
+          this->VertexCoordinates, worldCoords, CellTag());
+  }
+};
+
+/// Inverts the affine map origin + J*pcoords, where the columns of J are the
+/// three given axes. The inverse of J is built from cross products of the
+/// axes (Cramer's rule), which is exact up to rounding and needs only one
+/// division.
+///
+class AffineInverse3D {
+  dax::Vector3 Origin;
+  dax::math::Matrix3x3 InverseJacobian;
+public:
+  DAX_EXEC_EXPORT AffineInverse3D() {  }
+  DAX_EXEC_EXPORT
+  AffineInverse3D(const dax::Vector3 &origin,
+                  const dax::Vector3 &axis0,
+                  const dax::Vector3 &axis1,
+                  const dax::Vector3 &axis2)
+    : Origin(origin)
+  {
+    const dax::Vector3 cross12 = dax::math::Cross(axis1, axis2);
+    const dax::Vector3 cross20 = dax::math::Cross(axis2, axis0);
+    const dax::Vector3 cross01 = dax::math::Cross(axis0, axis1);
+    const dax::Scalar inverseDeterminant =
+        dax::Scalar(1)/dax::dot(axis0, cross12);
+    dax::math::MatrixSetRow(this->InverseJacobian, 0,
+                            cross12*inverseDeterminant);
+    dax::math::MatrixSetRow(this->InverseJacobian, 1,
+                            cross20*inverseDeterminant);
+    dax::math::MatrixSetRow(this->InverseJacobian, 2,
+                            cross01*inverseDeterminant);
+  }
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &worldCoords) const {
+    return dax::math::MatrixMultiply(this->InverseJacobian,
+                                     worldCoords - this->Origin);
+  }
+};
+
+/// Returns the largest absolute coordinate of any vertex scaled by a few
+/// machine epsilons. Vertices that agree to within this tolerance cannot be
+/// told apart from rounding error in the coordinates themselves.
+///
+template<class CellTag>
+DAX_EXEC_EXPORT
+dax::Scalar AffineTolerance(
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords)
+{
+  dax::Scalar maxCoord = 0;
+  for (int vertexIndex = 0;
+       vertexIndex < dax::CellTraits<CellTag>::NUM_VERTICES;
+       vertexIndex++)
+    {
+    const dax::Vector3 absCoord = dax::math::Abs(vertexCoords[vertexIndex]);
+    maxCoord = dax::math::Max(maxCoord,
+                              dax::math::Max(absCoord[0],
+                                             dax::math::Max(absCoord[1],
+                                                            absCoord[2])));
+    }
+  return 4*dax::math::Epsilon()*maxCoord;
+}
+
+DAX_EXEC_EXPORT
+bool CoordinatesMatch(const dax::Vector3 &coord1,
+                      const dax::Vector3 &coord2,
+                      dax::Scalar tolerance)
+{
+  const dax::Vector3 difference = dax::math::Abs(coord1 - coord2);
+  return ((difference[0] <= tolerance)
+          && (difference[1] <= tolerance)
+          && (difference[2] <= tolerance));
+}
+
+template<>
+class WorldToParametricFunctor<dax::CellTagVoxel> {
+  dax::Vector3 MinCoord;
+  dax::Vector3 InverseWidths;
+public:
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctor(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &vertexCoords)
+    : MinCoord(vertexCoords[0])
+  {
+    const dax::Vector3 axisAlignedWidths = vertexCoords[6] - vertexCoords[0];
+    this->InverseWidths = dax::make_Vector3(dax::Scalar(1)/axisAlignedWidths[0],
+                                            dax::Scalar(1)/axisAlignedWidths[1],
+                                            dax::Scalar(1)/axisAlignedWidths[2]);
+  }
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &worldCoords) const {
+    return (worldCoords - this->MinCoord) * this->InverseWidths;
+  }
+};
+
+} // Namespace detail
 
 //-----------------------------------------------------------------------------
 namespace detail {
@@ -287,6 +406,128 @@ public:
   }
 };
 
+/// Returns true if the trilinear map of the hexahedron has no nonlinear
+/// terms, which is the case when the cell is a parallelepiped (including any
+/// axis-aligned box). The map is then origin + J*pcoords with a constant
+/// Jacobian J.
+///
+DAX_EXEC_EXPORT
+bool HexahedronIsAffine(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron>
+        &vertexCoords)
+{
+  const dax::Scalar tolerance = AffineTolerance(vertexCoords);
+  const dax::Vector3 &origin = vertexCoords[0];
+  const dax::Vector3 axis0 = vertexCoords[1] - origin;
+  const dax::Vector3 axis1 = vertexCoords[3] - origin;
+  const dax::Vector3 axis2 = vertexCoords[4] - origin;
+  return (CoordinatesMatch(vertexCoords[2], origin + axis0 + axis1, tolerance)
+          && CoordinatesMatch(vertexCoords[5], origin + axis0 + axis2, tolerance)
+          && CoordinatesMatch(vertexCoords[7], origin + axis1 + axis2, tolerance)
+          && CoordinatesMatch(vertexCoords[6],
+                              origin + axis0 + axis1 + axis2,
+                              tolerance));
+}
+
+/// Returns true if the wedge is a straight extrusion of its bottom triangle,
+/// in which case its map to world coordinates is affine.
+///
+DAX_EXEC_EXPORT
+bool WedgeIsAffine(
+    const dax::exec::CellField<dax::Vector3,dax::CellTagWedge> &vertexCoords)
+{
+  const dax::Scalar tolerance = AffineTolerance(vertexCoords);
+  const dax::Vector3 extrusion = vertexCoords[3] - vertexCoords[0];
+  return (CoordinatesMatch(vertexCoords[4],
+                           vertexCoords[1] + extrusion,
+                           tolerance)
+          && CoordinatesMatch(vertexCoords[5],
+                              vertexCoords[2] + extrusion,
+                              tolerance));
+}
+
+/// Hexahedra and wedges whose map to world coordinates is affine are
+/// inverted directly. All others fall back to Newton's method.
+///
+template<class CellTag>
+class WorldToParametricFunctorNonlinear3DCell {
+  // Be careful!  Don't let member go out of scope!
+  const dax::exec::CellField<dax::Vector3,CellTag> &VertexCoordinates;
+  bool Affine;
+  AffineInverse3D Inverse;
+public:
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctorNonlinear3DCell(
+      const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords,
+      bool affine,
+      const dax::Vector3 &origin,
+      const dax::Vector3 &axis0,
+      const dax::Vector3 &axis1,
+      const dax::Vector3 &axis2)
+    : VertexCoordinates(vertexCoords), Affine(affine)
+  {
+    if (affine)
+      {
+      this->Inverse = AffineInverse3D(origin, axis0, axis1, axis2);
+      }
+  }
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &worldCoords) const {
+    if (this->Affine)
+      {
+      return this->Inverse(worldCoords);
+      }
+    else
+      {
+      return dax::math::NewtonsMethod(
+            JacobianFunctor3DCell<CellTag>(this->VertexCoordinates),
+            CoodinatesFunctor3DCell<CellTag>(this->VertexCoordinates),
+            worldCoords,
+            dax::make_Vector3(0.5, 0.5, 0.5));
+      }
+  }
+};
+
+template<>
+class WorldToParametricFunctor<dax::CellTagHexahedron>
+    : public WorldToParametricFunctorNonlinear3DCell<dax::CellTagHexahedron>
+{
+  typedef WorldToParametricFunctorNonlinear3DCell<dax::CellTagHexahedron>
+      Superclass;
+public:
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctor(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron>
+          &vertexCoords)
+    : Superclass(vertexCoords,
+                 HexahedronIsAffine(vertexCoords),
+                 vertexCoords[0],
+                 vertexCoords[1] - vertexCoords[0],
+                 vertexCoords[3] - vertexCoords[0],
+                 vertexCoords[4] - vertexCoords[0]) {  }
+};
+
+template<>
+class WorldToParametricFunctor<dax::CellTagWedge>
+    : public WorldToParametricFunctorNonlinear3DCell<dax::CellTagWedge>
+{
+  typedef WorldToParametricFunctorNonlinear3DCell<dax::CellTagWedge>
+      Superclass;
+public:
+  // Wedge parametric coordinates (1,0,0) and (0,1,0) are at vertices 2 and 1,
+  // respectively.
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctor(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagWedge>
+          &vertexCoords)
+    : Superclass(vertexCoords,
+                 WedgeIsAffine(vertexCoords),
+                 vertexCoords[0],
+                 vertexCoords[2] - vertexCoords[0],
+                 vertexCoords[1] - vertexCoords[0],
+                 vertexCoords[3] - vertexCoords[0]) {  }
+};
+
 } // Namespace detail
 
 DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
@@ -294,11 +535,8 @@ DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
     const dax::Vector3 &worldCoords,
     dax::CellTagHexahedron)
 {
-  return dax::math::NewtonsMethod(
-        detail::JacobianFunctor3DCell<dax::CellTagHexahedron>(vertexCoords),
-        detail::CoodinatesFunctor3DCell<dax::CellTagHexahedron>(vertexCoords),
-        worldCoords,
-        dax::make_Vector3(0.5, 0.5, 0.5));
+  return detail::WorldToParametricFunctor<dax::CellTagHexahedron>(
+        vertexCoords)(worldCoords);
 }
 
 DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
@@ -306,14 +544,30 @@ DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
     const dax::Vector3 &worldCoords,
     dax::CellTagWedge)
 {
-  return dax::math::NewtonsMethod(
-        detail::JacobianFunctor3DCell<dax::CellTagWedge>(vertexCoords),
-        detail::CoodinatesFunctor3DCell<dax::CellTagWedge>(vertexCoords),
-        worldCoords,
-        dax::make_Vector3(0.5, 0.5, 0.5));
+  return detail::WorldToParametricFunctor<dax::CellTagWedge>(
+        vertexCoords)(worldCoords);
 }
 
 //-----------------------------------------------------------------------------
+namespace detail {
+
+template<>
+class WorldToParametricFunctor<dax::CellTagTetrahedron>
+    : public AffineInverse3D
+{
+public:
+  DAX_EXEC_EXPORT
+  WorldToParametricFunctor(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron>
+          &vertexCoords)
+    : AffineInverse3D(vertexCoords[0],
+                      vertexCoords[1] - vertexCoords[0],
+                      vertexCoords[2] - vertexCoords[0],
+                      vertexCoords[3] - vertexCoords[0]) {  }
+};
+
+} // Namespace detail
+
 DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
     const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron>
         &vertexCoordinates,
@@ -341,24 +595,12 @@ DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
   //
   // d = dot((wcoords - p0), planeNormal)/dot((p1-p0), planeNormal)
   //
+  // The three denominators are all the triple product of the edges (up to
+  // sign), so this is Cramer's rule for the affine map of the tetrahedron.
+  // AffineInverse3D computes it with a single division.
 
-  dax::Vector3 pcoords(dax::Scalar(0));
-
-  const dax::Vector3 vec0 = vertexCoordinates[1] - vertexCoordinates[0];
-  const dax::Vector3 vec1 = vertexCoordinates[2] - vertexCoordinates[0];
-  const dax::Vector3 vec2 = vertexCoordinates[3] - vertexCoordinates[0];
-  const dax::Vector3 coordVec = worldCoords - vertexCoordinates[0];
-
-  dax::Vector3 planeNormal = dax::math::Cross(vec1, vec2);
-  pcoords[0] = dax::dot(coordVec, planeNormal)/dax::dot(vec0, planeNormal);
-
-  planeNormal = dax::math::Cross(vec0, vec2);
-  pcoords[1] = dax::dot(coordVec, planeNormal)/dax::dot(vec1, planeNormal);
-
-  planeNormal = dax::math::Cross(vec0, vec1);
-  pcoords[2] = dax::dot(coordVec, planeNormal)/dax::dot(vec2, planeNormal);
-
-  return pcoords;
+  return detail::WorldToParametricFunctor<dax::CellTagTetrahedron>(
+        vertexCoordinates)(worldCoords);
 }
 
 //-----------------------------------------------------------------------------
@@ -601,6 +843,88 @@ DAX_EXEC_EXPORT dax::Vector3 WorldCoordinatesToParametricCoordinates(
   return dax::make_Vector3(0.0, 0.0, 0.0);
 }
 
+//-----------------------------------------------------------------------------
+/// Converts a group of world coordinates that all lie in (or are being tested
+/// against) the same cell. The work that depends only on the cell, such as
+/// checking whether a hexahedron is a parallelepiped and inverting its
+/// Jacobian, is done once for the whole group rather than once per point.
+///
+template<int NumPoints, class CellTag>
+DAX_EXEC_EXPORT
+dax::Tuple<dax::Vector3,NumPoints> WorldCoordinatesToParametricCoordinates(
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords,
+    const dax::Tuple<dax::Vector3,NumPoints> &worldCoords,
+    CellTag)
+{
+  const detail::WorldToParametricFunctor<CellTag> toParametric(vertexCoords);
+  dax::Tuple<dax::Vector3,NumPoints> pcoords;
+  for (int pointIndex = 0; pointIndex < NumPoints; pointIndex++)
+    {
+    pcoords[pointIndex] = toParametric(worldCoords[pointIndex]);
+    }
+  return pcoords;
+}
+
+//-----------------------------------------------------------------------------
+/// Returns true if the given parametric coordinates lie inside the cell (or
+/// within \c tolerance of its boundary). This is typically paired with
+/// WorldCoordinatesToParametricCoordinates to determine whether a cell
+/// contains a point. The default implementation works for cells whose
+/// parametric space is the unit square/cube (hexahedra, voxels,
+/// quadrilaterals, lines, and vertices).
+///
+template<class CellTag>
+DAX_EXEC_EXPORT bool ParametricCoordinatesInsideCell(
+    const dax::Vector3 &pcoords,
+    dax::Scalar tolerance,
+    CellTag)
+{
+  const int TOPOLOGICAL_DIMENSIONS =
+      dax::CellTraits<CellTag>::TOPOLOGICAL_DIMENSIONS;
+  for (int dimension = 0; dimension < TOPOLOGICAL_DIMENSIONS; dimension++)
+    {
+    if ((pcoords[dimension] < -tolerance)
+        || (pcoords[dimension] > 1 + tolerance))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+DAX_EXEC_EXPORT bool ParametricCoordinatesInsideCell(
+    const dax::Vector3 &pcoords,
+    dax::Scalar tolerance,
+    dax::CellTagTetrahedron)
+{
+  return ((pcoords[0] >= -tolerance)
+          && (pcoords[1] >= -tolerance)
+          && (pcoords[2] >= -tolerance)
+          && (pcoords[0] + pcoords[1] + pcoords[2] <= 1 + tolerance));
+}
+
+DAX_EXEC_EXPORT bool ParametricCoordinatesInsideCell(
+    const dax::Vector3 &pcoords,
+    dax::Scalar tolerance,
+    dax::CellTagWedge)
+{
+  return ((pcoords[0] >= -tolerance)
+          && (pcoords[1] >= -tolerance)
+          && (pcoords[0] + pcoords[1] <= 1 + tolerance)
+          && (pcoords[2] >= -tolerance)
+          && (pcoords[2] <= 1 + tolerance));
+}
+
+DAX_EXEC_EXPORT bool ParametricCoordinatesInsideCell(
+    const dax::Vector3 &pcoords,
+    dax::Scalar tolerance,
+    dax::CellTagTriangle)
+{
+  return ((pcoords[0] >= -tolerance)
+          && (pcoords[1] >= -tolerance)
+          && (pcoords[0] + pcoords[1] <= 1 + tolerance));
+}
+
 }
 }
 
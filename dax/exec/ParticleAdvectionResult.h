@@ -0,0 +1,117 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_ParticleAdvectionResult_h
+#define __dax_exec_ParticleAdvectionResult_h
+
+#include <dax/Types.h>
+#include <dax/exec/ExecutionObjectBase.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief Collects the output of a particle advection round.
+///
+/// Particles are compacted between rounds, so a worklet only knows the
+/// original index of the particle it is working on. This execution object
+/// scatters results back to arrays indexed by that original index: the end
+/// point of each particle and, optionally, a polyline of every step taken.
+///
+/// Polylines are stored with a fixed stride of \c PointsPerPolyline points
+/// per particle. Only the first \c PolylineLengths[particle] of those points
+/// are valid. When \c RecordPolylines is false the polyline portals are never
+/// touched and may be empty.
+///
+template<class PointPortalT, class IdPortalT>
+class ParticleAdvectionResult : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef PointPortalT PointPortalType;
+  typedef IdPortalT IdPortalType;
+
+  DAX_CONT_EXPORT
+  ParticleAdvectionResult() {  }
+
+  DAX_CONT_EXPORT
+  ParticleAdvectionResult(const PointPortalType &endPoints,
+                          bool recordPolylines,
+                          const PointPortalType &polylinePoints,
+                          const IdPortalType &polylineLengths,
+                          dax::Id pointsPerPolyline,
+                          dax::Id firstStep)
+    : EndPoints(endPoints),
+      RecordPolylines(recordPolylines),
+      PolylinePoints(polylinePoints),
+      PolylineLengths(polylineLengths),
+      PointsPerPolyline(pointsPerPolyline),
+      FirstStep(firstStep) {  }
+
+  /// Called once per particle at the start of a round with its current
+  /// position. Starts the polyline on the first round.
+  ///
+  DAX_EXEC_EXPORT
+  void BeginParticle(dax::Id particleIndex, const dax::Vector3 &point) const
+  {
+    if (this->RecordPolylines && (this->FirstStep == 0))
+      {
+      this->PolylinePoints.Set(particleIndex*this->PointsPerPolyline, point);
+      }
+  }
+
+  /// Records the position of a particle after \p step steps (1 based) of the
+  /// current round.
+  ///
+  DAX_EXEC_EXPORT
+  void AddStep(dax::Id particleIndex,
+               dax::Id step,
+               const dax::Vector3 &point) const
+  {
+    if (this->RecordPolylines)
+      {
+      this->PolylinePoints.Set(
+            particleIndex*this->PointsPerPolyline + this->FirstStep + step,
+            point);
+      }
+  }
+
+  /// Called once per particle at the end of a round after taking
+  /// \p numberOfSteps steps.
+  ///
+  DAX_EXEC_EXPORT
+  void EndParticle(dax::Id particleIndex,
+                   dax::Id numberOfSteps,
+                   const dax::Vector3 &point) const
+  {
+    this->EndPoints.Set(particleIndex, point);
+    if (this->RecordPolylines)
+      {
+      this->PolylineLengths.Set(particleIndex,
+                                this->FirstStep + numberOfSteps + 1);
+      }
+  }
+
+private:
+  PointPortalType EndPoints;
+  bool RecordPolylines;
+  PointPortalType PolylinePoints;
+  IdPortalType PolylineLengths;
+  dax::Id PointsPerPolyline;
+  dax::Id FirstStep;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_ParticleAdvectionResult_h
@@ -0,0 +1,141 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_PointGradient_h
+#define __dax_exec_PointGradient_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/exec/ExecutionObjectBase.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief Computes the gradient of a point field of a uniform grid at a point.
+///
+/// Interior points use central differences of their two neighbors along each
+/// axis. Points on the boundary use a one-sided difference with their one
+/// neighbor. Axes along which the grid has a single point have a zero
+/// gradient component.
+///
+template<class FieldPortalT>
+class PointGradientUniformGrid : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef FieldPortalT FieldPortalType;
+  typedef dax::exec::internal::TopologyUniform TopologyType;
+
+  DAX_CONT_EXPORT
+  PointGradientUniformGrid() {  }
+
+  DAX_CONT_EXPORT
+  PointGradientUniformGrid(const TopologyType &topology,
+                           const FieldPortalType &field)
+    : Extent(topology.Extent),
+      InverseSpacing(dax::make_Vector3(1.0/topology.Spacing[0],
+                                       1.0/topology.Spacing[1],
+                                       1.0/topology.Spacing[2])),
+      Field(field) {  }
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetGradient(dax::Id pointIndex) const
+  {
+    const dax::Id3 dimensions = dax::extentDimensions(this->Extent);
+    const dax::Id3 ijk = dax::flatIndexToIndex3(pointIndex, this->Extent);
+
+    dax::Vector3 gradient;
+    dax::Id stride = 1;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      // Step to each neighbor that exists. The difference is divided by the
+      // number of steps taken, so boundary points get a one-sided difference.
+      const dax::Id lowerSteps = (ijk[dimension] > this->Extent.Min[dimension]);
+      const dax::Id upperSteps = (ijk[dimension] < this->Extent.Max[dimension]);
+      const dax::Id steps = lowerSteps + upperSteps;
+      if (steps > 0)
+        {
+        const dax::Scalar difference =
+            this->Field.Get(pointIndex + upperSteps*stride)
+            - this->Field.Get(pointIndex - lowerSteps*stride);
+        gradient[dimension] =
+            difference * this->InverseSpacing[dimension] / steps;
+        }
+      else
+        {
+        gradient[dimension] = 0;
+        }
+      stride *= dimensions[dimension];
+      }
+    return gradient;
+  }
+
+private:
+  dax::Extent3 Extent;
+  dax::Vector3 InverseSpacing;
+  FieldPortalType Field;
+};
+
+/// \brief Sums a cell field over the cells incident to each point.
+///
+/// The cells using each point are given as a concatenated list of cell ids and
+/// an array of offsets into it with one extra entry at the end (as built by
+/// dax::cont::PointGradient). Sum returns the total of the cell values over
+/// the cells that use the given point.
+///
+template<class IdPortalT, class ValuePortalT>
+class PointIncidentCellSum : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef IdPortalT IdPortalType;
+  typedef ValuePortalT ValuePortalType;
+  typedef typename ValuePortalType::ValueType ValueType;
+
+  DAX_CONT_EXPORT
+  PointIncidentCellSum() {  }
+
+  DAX_CONT_EXPORT
+  PointIncidentCellSum(const IdPortalType &pointOffsets,
+                       const IdPortalType &incidentCellIds,
+                       const ValuePortalType &cellValues)
+    : PointOffsets(pointOffsets),
+      IncidentCellIds(incidentCellIds),
+      CellValues(cellValues) {  }
+
+  DAX_EXEC_EXPORT
+  ValueType Sum(dax::Id pointIndex) const
+  {
+    ValueType sum(dax::Scalar(0));
+    const dax::Id endIndex = this->PointOffsets.Get(pointIndex+1);
+    for (dax::Id index = this->PointOffsets.Get(pointIndex);
+         index < endIndex;
+         index++)
+      {
+      sum = sum + this->CellValues.Get(this->IncidentCellIds.Get(index));
+      }
+    return sum;
+  }
+
+private:
+  IdPortalType PointOffsets;
+  IdPortalType IncidentCellIds;
+  ValuePortalType CellValues;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_PointGradient_h
@@ -0,0 +1,60 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletMapFieldPacket_h
+#define __dax_exec_WorkletMapFieldPacket_h
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <boost/static_assert.hpp>
+
+namespace dax { namespace exec {
+
+namespace internal {
+
+/// Non-templated marker used by the scheduler to recognize packet worklets.
+///
+class WorkletMapFieldPacketBase {  };
+
+}
+
+///----------------------------------------------------------------------------
+/// Superclass for field worklets that can process several values at once.
+///
+/// Worklets deriving from this class are invoked with \c dax::Tuple packets of
+/// \p Width contiguous values for every Field argument bound to an array
+/// (constant arguments are passed unchanged), which gives the compiler a
+/// fixed-length loop it can vectorize instead of one call per value through
+/// the portal. Values left over after the last full packet are processed one
+/// at a time, so the worklet must provide both the scalar and the packet form
+/// of its operator(). A template over the value type usually covers both.
+///
+/// Only the \c _N placeholders may appear in the ExecutionSignature.
+///
+template<int Width>
+class WorkletMapFieldPacket
+    : public dax::exec::WorkletMapField,
+      public dax::exec::internal::WorkletMapFieldPacketBase
+{
+  BOOST_STATIC_ASSERT(Width == 4 || Width == 8 || Width == 16);
+public:
+  enum { PACKET_WIDTH = Width };
+
+  DAX_EXEC_CONT_EXPORT WorkletMapFieldPacket() { }
+};
+
+}}
+
+#endif //__dax_exec_WorkletMapFieldPacket_h
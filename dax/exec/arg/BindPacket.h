@@ -0,0 +1,52 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindPacket_h
+#define __dax_exec_arg_BindPacket_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/cont/sig/Arg.h>
+#include <dax/exec/arg/BindInfo.h>
+#include <dax/exec/arg/FieldPacket.h>
+
+namespace dax { namespace exec { namespace arg {
+
+//binds an ExecutionSignature parameter to a FieldPacket of the matching
+//control argument. Only the _N placeholders can be packed, so there is no
+//generic implementation.
+template <typename Parameter, typename Invocation, int Width>
+class BindPacket;
+
+template <int N, typename Invocation, int Width>
+class BindPacket<dax::cont::sig::Arg<N>, Invocation, Width>
+  : public dax::exec::arg::FieldPacket<
+      typename dax::exec::arg::BindInfo<N,Invocation>::ExecArgType, Width>
+{
+  typedef dax::exec::arg::BindInfo<N,Invocation> MyInfo;
+  typedef typename MyInfo::AllControlBindings AllControlBindings;
+  typedef dax::exec::arg::FieldPacket<
+      typename MyInfo::ExecArgType, Width> Superclass;
+public:
+  DAX_CONT_EXPORT BindPacket(AllControlBindings& bindings):
+    Superclass(dax::exec::arg::GetNthExecArg<N>(bindings)) {}
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindPacket_h
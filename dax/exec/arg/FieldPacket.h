@@ -0,0 +1,134 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_FieldPacket_h
+#define __dax_exec_arg_FieldPacket_h
+
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+#include <dax/cont/sig/Tag.h>
+#include <dax/exec/arg/FieldConstant.h>
+#include <dax/exec/arg/FieldPortal.h>
+#include <dax/exec/internal/FieldAccess.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+
+namespace dax { namespace exec { namespace arg {
+
+/// \headerfile FieldPacket.h dax/exec/arg/FieldPacket.h
+/// \brief Execution worklet argument holding \p Width consecutive values of
+/// a field.
+///
+/// Specialized on the scalar execution argument it wraps. Only field
+/// arguments can be packed; any other execution argument fails to compile
+/// here.
+template <typename ExecArgType, int Width> class FieldPacket;
+
+template <typename T, typename Tags, typename PortalType, int Width>
+class FieldPacket<dax::exec::arg::FieldPortal<T,Tags,PortalType>, Width>
+{
+  typedef typename Tags::template Has<dax::cont::sig::In>::type HasInTag;
+  typedef typename Tags::template Has<dax::cont::sig::Out>::type HasOutTag;
+public:
+  typedef dax::Tuple<T,Width> PacketType;
+  typedef typename ::boost::mpl::if_<HasOutTag,
+                                     PacketType&,
+                                     PacketType const&>::type ReturnType;
+
+  DAX_CONT_EXPORT
+  FieldPacket(const dax::exec::arg::FieldPortal<T,Tags,PortalType>& arg):
+    Portal(arg.GetPortal()),
+    Packet(T(typename dax::VectorTraits<T>::ComponentType()))
+    {
+    }
+
+  DAX_EXEC_EXPORT ReturnType operator()() { return this->Packet; }
+
+  /// Reads the packet starting at \p startIndex if this is an input.
+  DAX_EXEC_EXPORT void Load(dax::Id startIndex,
+                            const dax::exec::internal::WorkletBase& work)
+    {
+    this->load(startIndex, work, HasInTag());
+    }
+
+  /// Writes the packet starting at \p startIndex if this is an output.
+  DAX_EXEC_EXPORT void Store(dax::Id startIndex,
+                             const dax::exec::internal::WorkletBase& work) const
+    {
+    this->store(startIndex, work, HasOutTag());
+    }
+
+private:
+  DAX_EXEC_EXPORT void load(dax::Id startIndex,
+                            const dax::exec::internal::WorkletBase& work,
+                            ::boost::mpl::bool_<true>)
+    {
+    dax::exec::internal::FieldGetMultiple(this->Portal,
+                                          startIndex,
+                                          this->Packet,
+                                          work);
+    }
+  DAX_EXEC_EXPORT void load(dax::Id,
+                            const dax::exec::internal::WorkletBase&,
+                            ::boost::mpl::bool_<false>)
+    {
+    }
+
+  DAX_EXEC_EXPORT void store(dax::Id startIndex,
+                             const dax::exec::internal::WorkletBase& work,
+                             ::boost::mpl::bool_<true>) const
+    {
+    dax::exec::internal::FieldSetMultiple(this->Portal,
+                                          startIndex,
+                                          this->Packet,
+                                          work);
+    }
+  DAX_EXEC_EXPORT void store(dax::Id,
+                             const dax::exec::internal::WorkletBase&,
+                             ::boost::mpl::bool_<false>) const
+    {
+    }
+
+  PortalType Portal;
+  PacketType Packet;
+};
+
+/// Constants are the same for every lane, so they are passed as is.
+template <typename T, int Width>
+class FieldPacket<dax::exec::arg::FieldConstant<T>, Width>
+{
+public:
+  typedef T const& ReturnType;
+
+  DAX_CONT_EXPORT
+  FieldPacket(const dax::exec::arg::FieldConstant<T>& arg):
+    Value(arg(dax::Id(0), dax::exec::internal::WorkletBase())) {  }
+
+  DAX_EXEC_EXPORT ReturnType operator()() const { return this->Value; }
+
+  DAX_EXEC_EXPORT void Load(dax::Id,
+                            const dax::exec::internal::WorkletBase&) const {  }
+  DAX_EXEC_EXPORT void Store(dax::Id,
+                             const dax::exec::internal::WorkletBase&) const {  }
+
+private:
+  T Value;
+};
+
+}}} // namespace dax::exec::arg
+
+#endif //__dax_exec_arg_FieldPacket_h
@@ -75,6 +75,8 @@ public:
     dax::exec::internal::FieldSet(Portal,index,v,work);
     }
 
+  DAX_EXEC_EXPORT const PortalType& GetPortal() const { return this->Portal; }
+
 private:
   ValueType Value;
   PortalType Portal;
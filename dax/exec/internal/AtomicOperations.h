@@ -0,0 +1,246 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_AtomicOperations_h
+#define __dax_exec_internal_AtomicOperations_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/internal/DeviceAdapterTagSerial.h>
+#include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
+#include <dax/tbb/cont/internal/DeviceAdapterTagTBB.h>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+namespace detail {
+
+/// The integer type with the same size as T. Atomic operations on floating
+/// point values compare and swap their bits as this type.
+///
+template<int Size> struct AtomicBitsType;
+template<> struct AtomicBitsType<4> { typedef dax::internal::Int32Type type; };
+template<> struct AtomicBitsType<8> { typedef dax::internal::Int64Type type; };
+
+template<typename T>
+union AtomicBits
+{
+  T Value;
+  typename AtomicBitsType<sizeof(T)>::type Bits;
+};
+
+/// Compares bits rather than values so that compare and swap treats values
+/// such as NaN, which do not equal themselves, and -0.0, which equals 0.0,
+/// by their representation in memory.
+///
+template<typename T>
+DAX_EXEC_EXPORT
+bool AtomicSameBits(const T &value1, const T &value2)
+{
+  AtomicBits<T> bits1;
+  bits1.Value = value1;
+  AtomicBits<T> bits2;
+  bits2.Value = value2;
+  return bits1.Bits == bits2.Bits;
+}
+
+/// Atomic operations for device adapters that run worklets on several
+/// threads sharing memory (such as OpenMP and TBB). It uses the compiler's
+/// atomic builtins. The values can be 4 or 8 byte integers or floating point
+/// numbers. Floating point additions, minimums and maximums are done with
+/// compare and swap loops.
+///
+struct AtomicOperationsSharedMemory
+{
+  /// Writes \p newValue to \p address if it holds \p expected. Returns the
+  /// value \p address held before.
+  ///
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T CompareAndSwap(T *address, const T &newValue, const T &expected)
+  {
+    typedef typename AtomicBitsType<sizeof(T)>::type BitsType;
+    AtomicBits<T> newBits;
+    newBits.Value = newValue;
+    AtomicBits<T> expectedBits;
+    expectedBits.Value = expected;
+    AtomicBits<T> oldBits;
+    oldBits.Bits = __sync_val_compare_and_swap(
+          reinterpret_cast<volatile BitsType *>(address),
+          expectedBits.Bits,
+          newBits.Bits);
+    return oldBits.Value;
+  }
+
+  /// Adds \p value to \p address. Returns the value \p address held before.
+  ///
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Add(T *address, const T &value)
+  {
+    return Add(address, value, typename boost::is_integral<T>::type());
+  }
+
+  /// Replaces the value at \p address with \p value if \p value is smaller.
+  /// Returns the value \p address held before.
+  ///
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Min(T *address, const T &value)
+  {
+    T oldValue = Load(address);
+    while (value < oldValue)
+      {
+      const T foundValue = CompareAndSwap(address, value, oldValue);
+      if (AtomicSameBits(foundValue, oldValue)) { break; }
+      oldValue = foundValue;
+      }
+    return oldValue;
+  }
+
+  /// Replaces the value at \p address with \p value if \p value is larger.
+  /// Returns the value \p address held before.
+  ///
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Max(T *address, const T &value)
+  {
+    T oldValue = Load(address);
+    while (oldValue < value)
+      {
+      const T foundValue = CompareAndSwap(address, value, oldValue);
+      if (AtomicSameBits(foundValue, oldValue)) { break; }
+      oldValue = foundValue;
+      }
+    return oldValue;
+  }
+
+  /// Reads \p address. The read is not torn by concurrent writes.
+  ///
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Load(const T *address)
+  {
+    return *static_cast<const volatile T *>(address);
+  }
+
+private:
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Add(T *address, const T &value, boost::true_type)
+  {
+    return __sync_fetch_and_add(address, value);
+  }
+
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Add(T *address, const T &value, boost::false_type)
+  {
+    T oldValue = Load(address);
+    while (true)
+      {
+      const T foundValue = CompareAndSwap(address, oldValue + value, oldValue);
+      if (AtomicSameBits(foundValue, oldValue)) { return oldValue; }
+      oldValue = foundValue;
+      }
+  }
+};
+
+} // namespace detail
+
+/// \brief Atomic read-modify-write operations on values in memory.
+///
+/// Each device adapter that supports atomic arrays specializes this class
+/// with static \c CompareAndSwap, \c Add, \c Min, \c Max and \c Load
+/// methods. There is no general implementation because the atomic operations
+/// have to match how the device runs worklets.
+///
+template<class DeviceAdapterTag>
+struct AtomicOperations
+{
+  // If you get a compile error here, the device adapter does not support
+  // atomic operations.
+  BOOST_STATIC_ASSERT(sizeof(DeviceAdapterTag) == 0);
+};
+
+/// The serial device runs one worklet instance at a time, so plain reads and
+/// writes are already atomic.
+///
+template<>
+struct AtomicOperations<dax::cont::DeviceAdapterTagSerial>
+{
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T CompareAndSwap(T *address, const T &newValue, const T &expected)
+  {
+    const T oldValue = *address;
+    if (detail::AtomicSameBits(oldValue, expected)) { *address = newValue; }
+    return oldValue;
+  }
+
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Add(T *address, const T &value)
+  {
+    const T oldValue = *address;
+    *address = oldValue + value;
+    return oldValue;
+  }
+
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Min(T *address, const T &value)
+  {
+    const T oldValue = *address;
+    if (value < oldValue) { *address = value; }
+    return oldValue;
+  }
+
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Max(T *address, const T &value)
+  {
+    const T oldValue = *address;
+    if (oldValue < value) { *address = value; }
+    return oldValue;
+  }
+
+  template<typename T>
+  DAX_EXEC_EXPORT
+  static T Load(const T *address)
+  {
+    return *address;
+  }
+};
+
+template<>
+struct AtomicOperations<dax::openmp::cont::DeviceAdapterTagOpenMP>
+    : public detail::AtomicOperationsSharedMemory
+{  };
+
+template<>
+struct AtomicOperations<dax::tbb::cont::DeviceAdapterTagTBB>
+    : public detail::AtomicOperationsSharedMemory
+{  };
+
+}
+}
+} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_AtomicOperations_h
@@ -0,0 +1,254 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#if !defined(BOOST_PP_IS_ITERATING)
+
+# ifndef __dax_exec_internal_PacketFunctor_h
+# define __dax_exec_internal_PacketFunctor_h
+
+# if !(__cplusplus >= 201103L)
+#  include <dax/internal/ParameterPackCxx03.h>
+# endif // !(__cplusplus >= 201103L)
+
+# include <dax/Types.h>
+# include <dax/cont/internal/Bindings.h>
+# include <dax/exec/arg/BindPacket.h>
+# include <dax/exec/internal/ErrorMessageBuffer.h>
+# include <dax/exec/internal/Functor.h>
+# include <dax/exec/internal/WorkletBase.h>
+# include <dax/internal/GetNthType.h>
+# include <dax/internal/Members.h>
+
+namespace dax { namespace exec { namespace internal {
+
+namespace detail {
+
+struct LoadPacketArgs
+{
+protected:
+  const dax::Id StartIndex;
+  const dax::exec::internal::WorkletBase& Work;
+public:
+  DAX_EXEC_EXPORT LoadPacketArgs(dax::Id startIndex,
+                                 const dax::exec::internal::WorkletBase& w):
+    StartIndex(startIndex), Work(w)
+    {}
+
+  template <typename BindType>
+  DAX_EXEC_EXPORT void operator()(BindType& execArg) const
+    {
+    execArg.Load(this->StartIndex,this->Work);
+    }
+};
+
+struct StorePacketArgs
+{
+protected:
+  const dax::Id StartIndex;
+  const dax::exec::internal::WorkletBase& Work;
+public:
+  DAX_EXEC_EXPORT StorePacketArgs(dax::Id startIndex,
+                                  const dax::exec::internal::WorkletBase& w):
+    StartIndex(startIndex), Work(w)
+    {}
+
+  template <typename BindType>
+  DAX_EXEC_EXPORT void operator()(BindType& execArg) const
+    {
+    execArg.Store(this->StartIndex,this->Work);
+    }
+};
+
+template <typename Invocation, int Width>
+struct PacketFunctorMemberMap
+{
+  template <int Id, typename Parameter>
+  struct Get
+  {
+  typedef dax::exec::arg::BindPacket<Parameter, Invocation, Width> type;
+  };
+};
+
+# if __cplusplus >= 201103L
+template <typename Invocation, int Width, typename ExecutionSignature,
+          typename NumList> class PacketFunctorImpl;
+template <typename Invocation, int Width> struct PacketFunctorImplLookup
+{
+  typedef typename dax::internal::GetNthType<0, Invocation>::type WorkletType;
+  typedef typename WorkletType::ExecutionSignature Sig;
+  typedef PacketFunctorImpl<Invocation, Width, Sig,
+                            typename FunctorNums<Sig>::type> type;
+};
+# else // !(__cplusplus >= 201103L)
+template <typename Invocation, int Width, typename ExecutionSignature>
+class PacketFunctorImpl;
+template <typename Invocation, int Width> struct PacketFunctorImplLookup
+{
+  typedef typename dax::internal::GetNthType<0, Invocation>::type WorkletType;
+  typedef PacketFunctorImpl<Invocation, Width,
+                            typename WorkletType::ExecutionSignature> type;
+};
+# endif // !(__cplusplus >= 201103L)
+
+#define _dax_PacketFunctorImpl_Argument(n) instance.template Get<n>()()
+#define _dax_PacketFunctorImpl_T0          instance.template Get<0>()() =
+#define _dax_PacketFunctorImpl_void
+#define _dax_PacketFunctorImpl(r)                                       \
+public:                                                                 \
+  typedef typename dax::internal::GetNthType<0, Invocation>::type       \
+    WorkletType;                                                        \
+  typedef dax::cont::internal::Bindings<Invocation> BindingsType;       \
+protected:                                                              \
+  typedef dax::internal::Members<                                       \
+      ExecutionSignature, PacketFunctorMemberMap<Invocation,Width>      \
+    > ArgumentsType;                                                    \
+  WorkletType Worklet;                                                  \
+  const ArgumentsType Arguments;                                        \
+public:                                                                 \
+  DAX_CONT_EXPORT                                                       \
+  PacketFunctorImpl(WorkletType worklet, BindingsType& bindings):       \
+    Worklet(worklet), Arguments(bindings) {}                            \
+                                                                        \
+  DAX_EXEC_EXPORT void operator()(dax::Id startIndex) const             \
+    {                                                                   \
+    ArgumentsType instance(this->Arguments);                            \
+    instance.ForEachExec(LoadPacketArgs(startIndex,this->Worklet));     \
+    _dax_PacketFunctorImpl_##r                                          \
+    this->Worklet(_dax_pp_enum___(_dax_PacketFunctorImpl_Argument));    \
+    instance.ForEachExec(StorePacketArgs(startIndex,this->Worklet));    \
+    }                                                                   \
+                                                                        \
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(                           \
+      const dax::exec::internal::ErrorMessageBuffer &errorBuffer) {     \
+    this->Worklet.SetErrorMessageBuffer(errorBuffer);                   \
+  }                                                                     \
+
+
+# if __cplusplus >= 201103L
+#  define _dax_pp_enum___(x) x(N)...
+template <typename Invocation, int Width,
+          typename T0, typename...T, int...N>
+class PacketFunctorImpl<Invocation, Width, T0(T...),
+                        dax::internal::detail::NumList<N...> >
+{
+  typedef T0 ExecutionSignature(T...);
+  _dax_PacketFunctorImpl(T0)
+};
+template <typename Invocation, int Width, typename...T, int...N>
+class PacketFunctorImpl<Invocation, Width, void(T...),
+                        dax::internal::detail::NumList<N...> >
+{
+  typedef void ExecutionSignature(T...);
+  _dax_PacketFunctorImpl(void)
+};
+#  undef _dax_pp_enum___
+# else // !(__cplusplus >= 201103L)
+#  define BOOST_PP_ITERATION_PARAMS_1 (3, (1, 10, <dax/exec/internal/PacketFunctor.h>))
+#  include BOOST_PP_ITERATE()
+# endif // !(__cplusplus >= 201103L)
+
+# undef _dax_PacketFunctorImpl
+# undef _dax_PacketFunctorImpl_T0
+# undef _dax_PacketFunctorImpl_void
+# undef _dax_PacketFunctorImpl_Argument
+
+} // namespace detail
+
+//----------------------------------------------------------------------------
+
+/// \headerfile PacketFunctor.h dax/exec/internal/PacketFunctor.h
+/// \brief Worklet invocation functor that processes \p Width values per call.
+///
+/// Work item \c i invokes the worklet once with the packet of values
+/// starting at <tt>i*Width</tt>. The work item past the last full packet runs
+/// the remaining values through the scalar Functor, so a schedule of
+/// GetNumberOfWorkItems() items covers all \c count values.
+///
+template <typename Invocation, int Width>
+class PacketFunctor
+{
+  typedef typename detail::PacketFunctorImplLookup<Invocation,Width>::type
+      PacketFunctorType;
+  typedef dax::exec::internal::Functor<Invocation> ScalarFunctorType;
+public:
+  typedef typename PacketFunctorType::WorkletType WorkletType;
+  typedef typename PacketFunctorType::BindingsType BindingsType;
+
+  DAX_CONT_EXPORT
+  PacketFunctor(WorkletType worklet, BindingsType& args, dax::Id count):
+    PacketImpl(worklet, args),
+    ScalarImpl(worklet, args),
+    NumberOfPackets(count/Width),
+    Count(count) {}
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfWorkItems() const
+    {
+    return this->NumberOfPackets + ((this->Count%Width) > 0 ? 1 : 0);
+    }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+    if (index < this->NumberOfPackets)
+      {
+      this->PacketImpl(index*Width);
+      }
+    else
+      {
+      for (dax::Id valueIndex = this->NumberOfPackets*Width;
+           valueIndex < this->Count;
+           valueIndex++)
+        {
+        this->ScalarImpl(valueIndex);
+        }
+      }
+    }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorBuffer) {
+    this->PacketImpl.SetErrorMessageBuffer(errorBuffer);
+    this->ScalarImpl.SetErrorMessageBuffer(errorBuffer);
+  }
+
+private:
+  PacketFunctorType PacketImpl;
+  ScalarFunctorType ScalarImpl;
+  dax::Id NumberOfPackets;
+  dax::Id Count;
+};
+
+}}} // namespace dax::exec::internal
+
+# endif //__dax_exec_internal_PacketFunctor_h
+
+#else // defined(BOOST_PP_IS_ITERATING)
+
+template <typename Invocation, int Width,
+          typename T0 _dax_pp_comma _dax_pp_typename___T>
+class PacketFunctorImpl<Invocation, Width, T0(_dax_pp_T___)>
+{
+  typedef T0 ExecutionSignature(_dax_pp_T___);
+  _dax_PacketFunctorImpl(T0)
+};
+
+# if _dax_pp_sizeof___T > 0
+template <typename Invocation, int Width, _dax_pp_typename___T>
+class PacketFunctorImpl<Invocation, Width, void(_dax_pp_T___)>
+{
+  typedef void ExecutionSignature(_dax_pp_T___);
+  _dax_PacketFunctorImpl(void)
+};
+# endif // _dax_pp_sizeof___T > 0
+
+#endif // defined(BOOST_PP_IS_ITERATING)
@@ -23,6 +23,7 @@
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/sig/WorkId.h>
 #include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/math/PrecisionTags.h>
 
 namespace dax {
 namespace exec {
@@ -35,6 +36,13 @@ namespace internal {
 class WorkletBase
 {
 public:
+  /// The precision the worklet wants for the math it computes. A worklet
+  /// that can tolerate approximate results redefines this as
+  /// dax::math::PrecisionTagFast and passes PrecisionTag() to the functions
+  /// in dax/math/PrecisionPolicy.h.
+  ///
+  typedef dax::math::PrecisionTagExact PrecisionTag;
+
   DAX_EXEC_CONT_EXPORT WorkletBase() {  }
 
   DAX_EXEC_EXPORT void RaiseError(const char *message) const
@@ -0,0 +1,157 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_ByteSwapWorklets_h
+#define __dax_exec_internal_kernel_ByteSwapWorklets_h
+
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <boost/cstdint.hpp>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+DAX_EXEC_EXPORT
+boost::uint8_t ByteSwap(boost::uint8_t word)
+{
+  return word;
+}
+
+DAX_EXEC_EXPORT
+boost::uint16_t ByteSwap(boost::uint16_t word)
+{
+  return static_cast<boost::uint16_t>((word << 8) | (word >> 8));
+}
+
+DAX_EXEC_EXPORT
+boost::uint32_t ByteSwap(boost::uint32_t word)
+{
+  return ((word & 0x000000FFu) << 24) |
+         ((word & 0x0000FF00u) << 8) |
+         ((word & 0x00FF0000u) >> 8) |
+         ((word & 0xFF000000u) >> 24);
+}
+
+DAX_EXEC_EXPORT
+boost::uint64_t ByteSwap(boost::uint64_t word)
+{
+  return (static_cast<boost::uint64_t>(
+            ByteSwap(static_cast<boost::uint32_t>(word))) << 32) |
+         ByteSwap(static_cast<boost::uint32_t>(word >> 32));
+}
+
+/// Reinterprets the bits of a component as an unsigned word of the same size,
+/// optionally reversing the byte order.
+///
+template<typename WordType, typename ComponentType>
+DAX_EXEC_EXPORT
+WordType ComponentToWord(ComponentType component, bool swapBytes)
+{
+  union { ComponentType Component; WordType Word; } bits;
+  bits.Component = component;
+  return swapBytes ? ByteSwap(bits.Word) : bits.Word;
+}
+
+/// Copies the components of a range of values into an array of words, one
+/// word per component, in the byte order given by \c SwapBytes.
+///
+template<class InPortalType, class OutPortalType>
+struct ByteSwapValues : dax::exec::internal::WorkletBase
+{
+  typedef typename InPortalType::ValueType ValueType;
+  typedef dax::VectorTraits<ValueType> Traits;
+  typedef typename OutPortalType::ValueType WordType;
+
+  InPortalType Values;
+  OutPortalType Words;
+  dax::Id Offset;
+  bool SwapBytes;
+
+  DAX_CONT_EXPORT
+  ByteSwapValues(const InPortalType &values,
+                 const OutPortalType &words,
+                 dax::Id offset,
+                 bool swapBytes)
+    : Values(values), Words(words), Offset(offset), SwapBytes(swapBytes) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const
+  {
+    const ValueType value = this->Values.Get(this->Offset + index);
+    for (int component = 0; component < Traits::NUM_COMPONENTS; component++)
+      {
+      this->Words.Set(index*Traits::NUM_COMPONENTS + component,
+                      ComponentToWord<WordType>(
+                        Traits::GetComponent(value, component),
+                        this->SwapBytes));
+      }
+  }
+};
+
+/// Writes the connections of a range of cells as 32 bit words in the layout
+/// of the legacy VTK CELLS section: the number of vertices followed by the
+/// vertex ids.
+///
+template<class InPortalType, class OutPortalType>
+struct ByteSwapVTKCells : dax::exec::internal::WorkletBase
+{
+  InPortalType Connections;
+  OutPortalType Words;
+  dax::Id Offset;
+  int NumberOfVertices;
+  bool SwapBytes;
+
+  DAX_CONT_EXPORT
+  ByteSwapVTKCells(const InPortalType &connections,
+                   const OutPortalType &words,
+                   dax::Id offset,
+                   int numberOfVertices,
+                   bool swapBytes)
+    : Connections(connections),
+      Words(words),
+      Offset(offset),
+      NumberOfVertices(numberOfVertices),
+      SwapBytes(swapBytes) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const
+  {
+    const dax::Id inIndex = (this->Offset + index)*this->NumberOfVertices;
+    const dax::Id outIndex = index*(this->NumberOfVertices + 1);
+    this->Words.Set(outIndex,
+                    ComponentToWord<boost::uint32_t>(
+                      static_cast<boost::int32_t>(this->NumberOfVertices),
+                      this->SwapBytes));
+    for (int vertex = 0; vertex < this->NumberOfVertices; vertex++)
+      {
+      this->Words.Set(outIndex + vertex + 1,
+                      ComponentToWord<boost::uint32_t>(
+                        static_cast<boost::int32_t>(
+                          this->Connections.Get(inIndex + vertex)),
+                        this->SwapBytes));
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_ByteSwapWorklets_h
@@ -0,0 +1,167 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_CellLocatorWorklets_h
+#define __dax_exec_internal_kernel_CellLocatorWorklets_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/exec/CellLocatorUniformBins.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/math/Compare.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Finds the range of bins overlapped by the bounding box of a cell. Returns
+/// false if the cell lies entirely outside of the binned region.
+///
+template<class TopologyType, class CoordinatesPortalType>
+DAX_EXEC_EXPORT
+bool CellLocatorBinRange(const TopologyType &topology,
+                         const CoordinatesPortalType &coordinates,
+                         const dax::exec::internal::UniformBinning &bins,
+                         dax::Id cellIndex,
+                         dax::Id3 &minBin,
+                         dax::Id3 &maxBin)
+{
+  typedef typename TopologyType::CellTag CellTag;
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+
+  const dax::exec::CellVertices<CellTag> vertices =
+      topology.GetCellConnections(cellIndex);
+  dax::Vector3 minCoords = coordinates.Get(vertices[0]);
+  dax::Vector3 maxCoords = minCoords;
+  for (int vertexIndex = 1; vertexIndex < NUM_VERTICES; vertexIndex++)
+    {
+    const dax::Vector3 coords = coordinates.Get(vertices[vertexIndex]);
+    minCoords = dax::math::Min(minCoords, coords);
+    maxCoords = dax::math::Max(maxCoords, coords);
+    }
+
+  if (!bins.Overlaps(minCoords, maxCoords)) { return false; }
+
+  minBin = bins.BinIndex3(minCoords);
+  maxBin = bins.BinIndex3(maxCoords);
+  return true;
+}
+
+template<class TopologyType, class CoordinatesPortalType, class OutPortalType>
+struct CellLocatorCountBins : dax::exec::internal::WorkletBase
+{
+  TopologyType Topology;
+  CoordinatesPortalType Coordinates;
+  dax::exec::internal::UniformBinning Bins;
+  OutPortalType BinCounts;
+
+  DAX_CONT_EXPORT
+  CellLocatorCountBins(const TopologyType &topology,
+                       const CoordinatesPortalType &coordinates,
+                       const dax::exec::internal::UniformBinning &bins,
+                       const OutPortalType &binCounts)
+    : Topology(topology),
+      Coordinates(coordinates),
+      Bins(bins),
+      BinCounts(binCounts) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    dax::Id3 minBin;
+    dax::Id3 maxBin;
+    dax::Id count = 0;
+    if (CellLocatorBinRange(this->Topology,
+                            this->Coordinates,
+                            this->Bins,
+                            cellIndex,
+                            minBin,
+                            maxBin))
+      {
+      count = (maxBin[0] - minBin[0] + 1)
+          * (maxBin[1] - minBin[1] + 1)
+          * (maxBin[2] - minBin[2] + 1);
+      }
+    this->BinCounts.Set(cellIndex, count);
+  }
+};
+
+template<class TopologyType,
+         class CoordinatesPortalType,
+         class InPortalType,
+         class OutPortalType>
+struct CellLocatorFillBins : dax::exec::internal::WorkletBase
+{
+  TopologyType Topology;
+  CoordinatesPortalType Coordinates;
+  dax::exec::internal::UniformBinning Bins;
+  InPortalType Offsets;
+  OutPortalType BinIds;
+  OutPortalType CellIds;
+
+  DAX_CONT_EXPORT
+  CellLocatorFillBins(const TopologyType &topology,
+                      const CoordinatesPortalType &coordinates,
+                      const dax::exec::internal::UniformBinning &bins,
+                      const InPortalType &offsets,
+                      const OutPortalType &binIds,
+                      const OutPortalType &cellIds)
+    : Topology(topology),
+      Coordinates(coordinates),
+      Bins(bins),
+      Offsets(offsets),
+      BinIds(binIds),
+      CellIds(cellIds) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    dax::Id3 minBin;
+    dax::Id3 maxBin;
+    if (!CellLocatorBinRange(this->Topology,
+                             this->Coordinates,
+                             this->Bins,
+                             cellIndex,
+                             minBin,
+                             maxBin))
+      {
+      return;
+      }
+
+    dax::Id outIndex = this->Offsets.Get(cellIndex);
+    dax::Id3 ijk;
+    for (ijk[2] = minBin[2]; ijk[2] <= maxBin[2]; ijk[2]++)
+      {
+      for (ijk[1] = minBin[1]; ijk[1] <= maxBin[1]; ijk[1]++)
+        {
+        for (ijk[0] = minBin[0]; ijk[0] <= maxBin[0]; ijk[0]++)
+          {
+          this->BinIds.Set(outIndex, this->Bins.FlatBinIndex(ijk));
+          this->CellIds.Set(outIndex, cellIndex);
+          outIndex++;
+          }
+        }
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_CellLocatorWorklets_h
@@ -0,0 +1,229 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_FieldStatisticsWorklets_h
+#define __dax_exec_internal_kernel_FieldStatisticsWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// The statistics of one block of values. The moments are sums of powers of
+/// the differences from the mean (not divided by the count) so that blocks
+/// can be merged exactly. They are kept in double precision so that fields
+/// with billions of values do not lose their low order digits.
+///
+struct FieldStatisticsPartial
+{
+  dax::Id Count;
+  double Minimum;
+  double Maximum;
+  double Mean;
+  double M2;
+  double M3;
+};
+
+/// Merges the statistics of two blocks of values with the pairwise update
+/// formulas of Chan, Golub and LeVeque (extended to the third moment).
+///
+DAX_EXEC_CONT_EXPORT
+FieldStatisticsPartial FieldStatisticsMerge(const FieldStatisticsPartial &a,
+                                            const FieldStatisticsPartial &b)
+{
+  if (a.Count == 0) { return b; }
+  if (b.Count == 0) { return a; }
+
+  const double countA = static_cast<double>(a.Count);
+  const double countB = static_cast<double>(b.Count);
+  const double count = countA + countB;
+  const double delta = b.Mean - a.Mean;
+  const double deltaOverCount = delta/count;
+
+  FieldStatisticsPartial result;
+  result.Count = a.Count + b.Count;
+  result.Minimum = (b.Minimum < a.Minimum) ? b.Minimum : a.Minimum;
+  result.Maximum = (b.Maximum > a.Maximum) ? b.Maximum : a.Maximum;
+  result.Mean = a.Mean + countB*deltaOverCount;
+  result.M2 = a.M2 + b.M2 + delta*deltaOverCount*countA*countB;
+  result.M3 = a.M3 + b.M3
+      + delta*deltaOverCount*deltaOverCount*countA*countB*(countA - countB)
+      + 3*deltaOverCount*(countA*b.M2 - countB*a.M2);
+  return result;
+}
+
+/// Computes the statistics of each block of BlockSize values. The values of
+/// a block are accumulated as sums of powers of their difference from the
+/// first value of the block, which needs no division in the inner loop and
+/// keeps the sums small, and are turned into moments about the mean at the
+/// end.
+///
+template<class InPortalType, class OutPortalType>
+struct FieldStatisticsBlocks : dax::exec::internal::WorkletBase
+{
+  InPortalType Values;
+  dax::Id NumberOfValues;
+  dax::Id BlockSize;
+  OutPortalType Partials;
+
+  DAX_CONT_EXPORT
+  FieldStatisticsBlocks(const InPortalType &values,
+                        dax::Id numberOfValues,
+                        dax::Id blockSize,
+                        const OutPortalType &partials)
+    : Values(values),
+      NumberOfValues(numberOfValues),
+      BlockSize(blockSize),
+      Partials(partials) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id blockIndex) const
+  {
+    const dax::Id begin = blockIndex*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->NumberOfValues) { end = this->NumberOfValues; }
+
+    const double shift = static_cast<double>(this->Values.Get(begin));
+    double minimum = shift;
+    double maximum = shift;
+    double sum1 = 0;
+    double sum2 = 0;
+    double sum3 = 0;
+    for (dax::Id index = begin; index < end; index++)
+      {
+      const double value = static_cast<double>(this->Values.Get(index));
+      minimum = (value < minimum) ? value : minimum;
+      maximum = (value > maximum) ? value : maximum;
+      const double difference = value - shift;
+      const double difference2 = difference*difference;
+      sum1 += difference;
+      sum2 += difference2;
+      sum3 += difference2*difference;
+      }
+
+    const double offset = sum1/(end - begin);
+    FieldStatisticsPartial partial;
+    partial.Count = end - begin;
+    partial.Minimum = minimum;
+    partial.Maximum = maximum;
+    partial.Mean = shift + offset;
+    partial.M2 = sum2 - sum1*offset;
+    partial.M3 = sum3 - 3*offset*sum2 + 2*sum1*offset*offset;
+    this->Partials.Set(blockIndex, partial);
+  }
+};
+
+/// Counts the values of each block of BlockSize values into the block's own
+/// NumberOfBins entries of Counts, so no two blocks ever write the same bin.
+/// Values outside of [Minimum, Maximum] are not counted and the maximum
+/// itself goes in the last bin.
+///
+template<class InPortalType, class OutPortalType>
+struct FieldHistogramBlocks : dax::exec::internal::WorkletBase
+{
+  InPortalType Values;
+  dax::Id NumberOfValues;
+  dax::Id BlockSize;
+  dax::Id NumberOfBins;
+  double Minimum;
+  double Maximum;
+  double BinsPerUnit;
+  OutPortalType Counts;
+
+  DAX_CONT_EXPORT
+  FieldHistogramBlocks(const InPortalType &values,
+                       dax::Id numberOfValues,
+                       dax::Id blockSize,
+                       dax::Id numberOfBins,
+                       double minimum,
+                       double maximum,
+                       const OutPortalType &counts)
+    : Values(values),
+      NumberOfValues(numberOfValues),
+      BlockSize(blockSize),
+      NumberOfBins(numberOfBins),
+      Minimum(minimum),
+      Maximum(maximum),
+      // A range of zero width puts every value in the first bin.
+      BinsPerUnit((maximum > minimum) ? numberOfBins/(maximum - minimum) : 0),
+      Counts(counts) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id blockIndex) const
+  {
+    const dax::Id binOffset = blockIndex*this->NumberOfBins;
+    for (dax::Id bin = 0; bin < this->NumberOfBins; bin++)
+      {
+      this->Counts.Set(binOffset + bin, 0);
+      }
+
+    const dax::Id begin = blockIndex*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->NumberOfValues) { end = this->NumberOfValues; }
+    for (dax::Id index = begin; index < end; index++)
+      {
+      const double value = static_cast<double>(this->Values.Get(index));
+      if ((value < this->Minimum) || (value > this->Maximum)) { continue; }
+      dax::Id bin =
+          static_cast<dax::Id>((value - this->Minimum)*this->BinsPerUnit);
+      if (bin >= this->NumberOfBins) { bin = this->NumberOfBins - 1; }
+      this->Counts.Set(binOffset + bin, this->Counts.Get(binOffset + bin) + 1);
+      }
+  }
+};
+
+/// Adds up the private bins of every block into the final histogram.
+///
+template<class InPortalType, class OutPortalType>
+struct FieldHistogramMerge : dax::exec::internal::WorkletBase
+{
+  InPortalType BlockCounts;
+  dax::Id NumberOfBlocks;
+  dax::Id NumberOfBins;
+  OutPortalType Histogram;
+
+  DAX_CONT_EXPORT
+  FieldHistogramMerge(const InPortalType &blockCounts,
+                      dax::Id numberOfBlocks,
+                      dax::Id numberOfBins,
+                      const OutPortalType &histogram)
+    : BlockCounts(blockCounts),
+      NumberOfBlocks(numberOfBlocks),
+      NumberOfBins(numberOfBins),
+      Histogram(histogram) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id bin) const
+  {
+    dax::Id count = 0;
+    for (dax::Id blockIndex = 0;
+         blockIndex < this->NumberOfBlocks;
+         blockIndex++)
+      {
+      count += this->BlockCounts.Get(blockIndex*this->NumberOfBins + bin);
+      }
+    this->Histogram.Set(bin, count);
+  }
+};
+
+}
+}
+}
+} // namespace dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_FieldStatisticsWorklets_h
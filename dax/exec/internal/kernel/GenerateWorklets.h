@@ -85,6 +85,36 @@ struct InterpolateEdgesToPoint
     OutVec3PortalType InterpCoords;
   };
 
+/// Each input writes its own id into the range of output slots it
+/// generates, [scanned[index-1], scanned[index]), so mapping outputs back
+/// to inputs needs no search.
+template<class ScannedCountsPortalType, class InputIdsPortalType>
+struct ExpandScannedCounts
+  {
+    DAX_CONT_EXPORT ExpandScannedCounts(
+        const ScannedCountsPortalType &scannedCounts,
+        const InputIdsPortalType &inputIds) :
+    ScannedCounts(scannedCounts),
+    InputIds(inputIds)
+    {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      const dax::Id begin = (index == 0) ? 0 : ScannedCounts.Get(index-1);
+      const dax::Id end = ScannedCounts.Get(index);
+      for(dax::Id outIndex = begin; outIndex < end; ++outIndex)
+        {
+        InputIds.Set(outIndex, index);
+        }
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    ScannedCountsPortalType ScannedCounts;
+    InputIdsPortalType InputIds;
+  };
+
 }
 }
 }
@@ -0,0 +1,69 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_PointGradientWorklets_h
+#define __dax_exec_internal_kernel_PointGradientWorklets_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Writes a (point, cell) pair for every vertex of every cell. Sorting the
+/// pairs by point gives the cells incident to each point.
+///
+template<class TopologyType, class OutPortalType>
+struct PointIncidenceFill : dax::exec::internal::WorkletBase
+{
+  TopologyType Topology;
+  OutPortalType PointIds;
+  OutPortalType CellIds;
+
+  DAX_CONT_EXPORT
+  PointIncidenceFill(const TopologyType &topology,
+                     const OutPortalType &pointIds,
+                     const OutPortalType &cellIds)
+    : Topology(topology),
+      PointIds(pointIds),
+      CellIds(cellIds) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    typedef typename TopologyType::CellTag CellTag;
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+
+    const dax::exec::CellVertices<CellTag> vertices =
+        this->Topology.GetCellConnections(cellIndex);
+    const dax::Id outIndex = cellIndex*NUM_VERTICES;
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      this->PointIds.Set(outIndex + vertexIndex, vertices[vertexIndex]);
+      this->CellIds.Set(outIndex + vertexIndex, cellIndex);
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_PointGradientWorklets_h
@@ -35,19 +35,6 @@ public:
   typedef ESig ExecutionSignature;
 };
 
-
-struct ComputeVisitIndex : public WorkletMapField
-{
-  typedef void ControlSignature(Field(In),Field(Out));
-  typedef _2 ExecutionSignature(_1,WorkId);
-
-  DAX_EXEC_EXPORT dax::Id operator()(const dax::Id& LowerBoundsCount,
-                                     const dax::Id& workId) const
-  {
-    return workId - LowerBoundsCount;
-  }
-};
-
 }
 }
 }
@@ -0,0 +1,93 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/exec/CellMeasure.h>
+
+#include <dax/exec/ParametricCoordinates.h>
+
+#include <dax/testing/Testing.h>
+
+namespace {
+
+// The measure of each cell type in parametric space.
+dax::Scalar ParametricMeasure(dax::CellTagVoxel) { return 1; }
+dax::Scalar ParametricMeasure(dax::CellTagHexahedron) { return 1; }
+dax::Scalar ParametricMeasure(dax::CellTagWedge) { return 0.5; }
+dax::Scalar ParametricMeasure(dax::CellTagTetrahedron) { return 1.0/6.0; }
+dax::Scalar ParametricMeasure(dax::CellTagTriangle) { return 0.5; }
+dax::Scalar ParametricMeasure(dax::CellTagQuadrilateral) { return 1; }
+dax::Scalar ParametricMeasure(dax::CellTagLine) { return 1; }
+dax::Scalar ParametricMeasure(dax::CellTagVertex) { return 1; }
+
+// Voxels have to stay axis aligned, so they are not sheared.
+template<class CellTag>
+bool CanShear(CellTag)
+{
+  return (dax::CellTraits<CellTag>::TOPOLOGICAL_DIMENSIONS == 3);
+}
+bool CanShear(dax::CellTagVoxel) { return false; }
+
+struct TestCellMeasureFunctor
+{
+  template<class CellTag>
+  void operator()(CellTag) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    const int TOPOLOGICAL_DIMENSIONS =
+        dax::CellTraits<CellTag>::TOPOLOGICAL_DIMENSIONS;
+
+    // The cell in parametric space.
+    dax::exec::CellField<dax::Vector3,CellTag> vertCoords =
+        dax::exec::ParametricCoordinates<CellTag>::Vertex();
+    DAX_TEST_ASSERT(test_equal(dax::exec::CellMeasure(vertCoords, CellTag()),
+                               ParametricMeasure(CellTag())),
+                    "Wrong measure for parametric cell.");
+
+    // Scale, shear and translate the cell. Shearing along the z axis does not
+    // change the measure, so only the scaling does.
+    const dax::Vector3 scale = dax::make_Vector3(2.0, 3.0, 0.5);
+    dax::Scalar expectedMeasure = ParametricMeasure(CellTag());
+    for (int dimension = 0; dimension < TOPOLOGICAL_DIMENSIONS; dimension++)
+      {
+      expectedMeasure *= scale[dimension];
+      }
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      dax::Vector3 &coord = vertCoords[vertexIndex];
+      coord = coord*scale + dax::make_Vector3(-1.0, 5.0, 0.25);
+      if (CanShear(CellTag()))
+        {
+        coord[0] += dax::Scalar(0.5)*coord[2];
+        coord[1] += coord[2];
+        }
+      }
+    DAX_TEST_ASSERT(test_equal(dax::exec::CellMeasure(vertCoords, CellTag()),
+                               expectedMeasure),
+                    "Wrong measure for transformed cell.");
+  }
+};
+
+void TestCellMeasure()
+{
+  dax::testing::Testing::TryAllCells(TestCellMeasureFunctor());
+}
+
+} // anonymous namespace
+
+int UnitTestCellMeasure(int, char *[])
+{
+  return dax::testing::Testing::Run(TestCellMeasure);
+}
@@ -113,6 +113,17 @@ void TestDerivativeCell(
                            computedDerivative,
                            fieldValues,
                            CellTag());
+
+        typename dax::exec::CellDerivativeOperator<CellTag>::Type
+            derivativeOperator =
+              dax::exec::make_CellDerivativeOperator(pcoords,
+                                                     vertCoords,
+                                                     CellTag());
+        TestGradientResult(vertCoords,
+                           dax::exec::ApplyCellDerivativeOperator(
+                             derivativeOperator, scalarField),
+                           fieldValues,
+                           CellTag());
         }
       }
     }
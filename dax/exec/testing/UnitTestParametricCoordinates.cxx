@@ -116,6 +116,45 @@ void TestPCoordsSample(
     }
 }
 
+template<class CellTag>
+void TestPCoordsBatch(
+    const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords,
+    CellTag)
+{
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  const dax::exec::CellField<dax::Vector3,CellTag> vertexPCoords =
+      dax::exec::ParametricCoordinates<CellTag>::Vertex();
+
+  dax::Tuple<dax::Vector3,NUM_VERTICES+1> truePCoords;
+  dax::Tuple<dax::Vector3,NUM_VERTICES+1> wcoords;
+  for (int pointIndex = 0; pointIndex < NUM_VERTICES; pointIndex++)
+    {
+    truePCoords[pointIndex] = vertexPCoords[pointIndex];
+    wcoords[pointIndex] = vertexCoords[pointIndex];
+    }
+  truePCoords[NUM_VERTICES] =
+      dax::exec::ParametricCoordinates<CellTag>::Center();
+  wcoords[NUM_VERTICES] =
+      dax::exec::ParametricCoordinatesToWorldCoordinates(
+        vertexCoords, truePCoords[NUM_VERTICES], CellTag());
+
+  dax::Tuple<dax::Vector3,NUM_VERTICES+1> computedPCoords =
+      dax::exec::WorldCoordinatesToParametricCoordinates(vertexCoords,
+                                                         wcoords,
+                                                         CellTag());
+  for (int pointIndex = 0; pointIndex <= NUM_VERTICES; pointIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(computedPCoords[pointIndex],
+                               truePCoords[pointIndex],
+                               0.01),
+                    "Computed wrong parametric coords for batch.");
+    DAX_TEST_ASSERT(test_equal(computedPCoords[pointIndex],
+                               dax::exec::WorldCoordinatesToParametricCoordinates(
+                                 vertexCoords, wcoords[pointIndex], CellTag())),
+                    "Batch does not match single point conversion.");
+    }
+}
+
 template<class CellTag>
 static void TestPCoords(
     const dax::exec::CellField<dax::Vector3,CellTag> &vertexCoords,
@@ -123,6 +162,7 @@ static void TestPCoords(
 {
   TestPCoordsSpecial(vertexCoords, CellTag());
   TestPCoordsSample(vertexCoords, CellTag());
+  TestPCoordsBatch(vertexCoords, CellTag());
 }
 
 struct TestPCoordsFunctor
@@ -138,9 +178,43 @@ struct TestPCoordsFunctor
   }
 };
 
+void TestNonAffineCells()
+{
+  // The cells from the topology generator are all parallelepipeds (or
+  // extrusions), which take the closed-form path. Distort some cells so that
+  // the iterative path is also exercised.
+  std::cout << "Hexahedron with affine map" << std::endl;
+  dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron> hexCoords =
+      dax::exec::ParametricCoordinates<dax::CellTagHexahedron>::Vertex();
+  DAX_TEST_ASSERT(dax::exec::detail::HexahedronIsAffine(hexCoords),
+                  "Unit cube not detected as affine.");
+  TestPCoords(hexCoords, dax::CellTagHexahedron());
+
+  std::cout << "Distorted hexahedron" << std::endl;
+  hexCoords[6] = dax::make_Vector3(1.3, 1.2, 1.1);
+  DAX_TEST_ASSERT(!dax::exec::detail::HexahedronIsAffine(hexCoords),
+                  "Distorted hexahedron detected as affine.");
+  TestPCoords(hexCoords, dax::CellTagHexahedron());
+
+  std::cout << "Wedge with affine map" << std::endl;
+  dax::exec::CellField<dax::Vector3,dax::CellTagWedge> wedgeCoords =
+      dax::exec::ParametricCoordinates<dax::CellTagWedge>::Vertex();
+  DAX_TEST_ASSERT(dax::exec::detail::WedgeIsAffine(wedgeCoords),
+                  "Unit wedge not detected as affine.");
+  TestPCoords(wedgeCoords, dax::CellTagWedge());
+
+  std::cout << "Tapered wedge" << std::endl;
+  wedgeCoords[4] = dax::make_Vector3(0.0, 0.8, 1.0);
+  wedgeCoords[5] = dax::make_Vector3(0.7, 0.0, 1.2);
+  DAX_TEST_ASSERT(!dax::exec::detail::WedgeIsAffine(wedgeCoords),
+                  "Tapered wedge detected as affine.");
+  TestPCoords(wedgeCoords, dax::CellTagWedge());
+}
+
 void TestAllPCoords()
 {
   dax::exec::internal::TryAllTopologyTypes(TestPCoordsFunctor());
+  TestNonAffineCells();
 }
 
 } // Anonymous namespace
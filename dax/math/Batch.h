@@ -0,0 +1,599 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_math_Batch_h
+#define __dax_math_Batch_h
+
+// This header file defines versions of the exponential, logarithm,
+// trigonometric and root functions that are meant to be evaluated on many
+// values at once.
+//
+// The functions in dax/math/Exp.h and dax/math/Trig.h call the system math
+// library once per component, and compilers cannot vectorize across those
+// calls. The kernels here are branch-free polynomial approximations written
+// only with arithmetic, integer conversions and selects, so a loop over the
+// components of a dax::Tuple (or over a packet given to a
+// dax::exec::WorkletMapFieldPacket) compiles to SIMD instructions.
+//
+// Errors are given in units in the last place (ULP) of dax::Scalar, measured
+// against a higher precision reference in UnitTestMathBatch:
+//
+//   Function  Float   Double  Notes
+//   Exp       2       1       Subnormal results are rounded correctly.
+//   Log       1       1
+//   Sin, Cos  2       2       For |x| <= 2^19; larger arguments use the
+//                             system function.
+//   Sqrt      1       1
+//   RSqrt     2       2
+//   Pow       2+2|t|  2+2|t|  t = y*ln(x), so the error grows with the
+//                             magnitude of the result's exponent.
+//
+// The bounds hold whether or not the compiler fuses multiplies and adds.
+//
+// Special values (NaN, infinities, zeros and negative arguments) give the same
+// results as the system functions. The only exception is Pow of a negative
+// base with a non-integer exponent, which is NaN as in C99 but without
+// raising a floating point exception.
+
+#include <dax/Types.h>
+#include <dax/internal/MathSystemFunctions.h>
+#include <dax/math/Precision.h>
+
+namespace dax {
+namespace math {
+namespace batch {
+
+namespace internal {
+
+#if DAX_SIZE_SCALAR == 4
+typedef dax::internal::UInt32Type BitsType;
+typedef dax::internal::Int32Type IntType;
+union ScalarBits {
+  dax::Scalar Scalar;
+  BitsType Bits;
+};
+const int MANTISSA_BITS = 23;
+const int EXPONENT_BIAS = 127;
+const dax::Scalar IntegerLimit = 16777216.0f; // 2**24
+#elif DAX_SIZE_SCALAR == 8
+typedef dax::internal::UInt64Type BitsType;
+typedef dax::internal::Int64Type IntType;
+union ScalarBits {
+  dax::Scalar Scalar;
+  BitsType Bits;
+};
+const int MANTISSA_BITS = 52;
+const int EXPONENT_BIAS = 1023;
+const dax::Scalar IntegerLimit = 9007199254740992.0; // 2**53
+#else
+#error Unknown scalar size
+#endif
+
+DAX_EXEC_CONT_EXPORT BitsType AsBits(dax::Scalar x)
+{
+  ScalarBits value;
+  value.Scalar = x;
+  return value.Bits;
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar AsScalar(BitsType bits)
+{
+  ScalarBits value;
+  value.Bits = bits;
+  return value.Scalar;
+}
+
+/// Returns \p a where \p condition is true and \p b elsewhere. The choice is
+/// made with bitwise operations because compilers will not turn a
+/// conditional expression on floating point values into a vector blend when
+/// either side could raise a floating point exception.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Scalar Select(bool condition, dax::Scalar a, dax::Scalar b)
+{
+  const BitsType mask =
+      static_cast<BitsType>(0) - static_cast<BitsType>(condition);
+  return AsScalar((AsBits(a) & mask) | (AsBits(b) & ~mask));
+}
+
+/// Returns 2**n for an exponent in the normal range.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Pow2(dax::internal::Int32Type n)
+{
+  return AsScalar(static_cast<BitsType>(n + EXPONENT_BIAS) << MANTISSA_BITS);
+}
+
+/// Rounds to the nearest integer, with halfway cases away from zero.
+///
+DAX_EXEC_CONT_EXPORT dax::internal::Int32Type RoundToInt(dax::Scalar x)
+{
+  return static_cast<dax::internal::Int32Type>(
+        x + Select(x < 0, dax::Scalar(-0.5), dax::Scalar(0.5)));
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar ExpKernel(dax::Scalar x)
+{
+#if DAX_SIZE_SCALAR == 4
+  // ln(FLT_MAX) and ln of half the smallest subnormal.
+  const dax::Scalar MaxArg = 88.72283905f;
+  const dax::Scalar MinArg = -103.9720770f;
+  const dax::Scalar Log2E = 1.44269504088896341f;
+  const dax::Scalar Ln2Hi = 0.693359375f;
+  const dax::Scalar Ln2Lo = -2.12194440e-4f;
+#else
+  const dax::Scalar MaxArg = 709.782712893383973;
+  const dax::Scalar MinArg = -745.1332191019412;
+  const dax::Scalar Log2E = 1.44269504088896340736;
+  const dax::Scalar Ln2Hi = 6.93147180369123816490e-01;
+  const dax::Scalar Ln2Lo = 1.90821492927058770002e-10;
+#endif
+
+  // Clamp so that the exponent arithmetic below stays in range. NaN fails
+  // both comparisons and ends up at MinArg; it is restored at the end.
+  dax::Scalar xc = Select(x > MinArg, x, MinArg);
+  xc = Select(xc < MaxArg, xc, MaxArg);
+
+  // x = n*ln(2) + r with |r| <= ln(2)/2.
+  const dax::internal::Int32Type n = RoundToInt(xc*Log2E);
+  const dax::Scalar nScalar = static_cast<dax::Scalar>(n);
+
+#if DAX_SIZE_SCALAR == 4
+  const dax::Scalar r = (xc - nScalar*Ln2Hi) - nScalar*Ln2Lo;
+  const dax::Scalar p =
+      ((((((1.9875691500e-4f*r + 1.3981999507e-3f)*r + 8.3334519073e-3f)*r
+           + 4.1665795894e-2f)*r + 1.6666665459e-1f)*r + 5.0000001201e-1f)
+       *r*r) + r + 1;
+#else
+  // Remez approximation of r*(e**r + 1)/(e**r - 1) as in fdlibm, keeping the
+  // low part of the reduced argument separate until the final sum.
+  const dax::Scalar hi = xc - nScalar*Ln2Hi;
+  const dax::Scalar lo = nScalar*Ln2Lo;
+  const dax::Scalar r = hi - lo;
+  const dax::Scalar rr = r*r;
+  const dax::Scalar c =
+      r - rr*(1.66666666666666019037e-01
+              + rr*(-2.77777777770155933842e-03
+                    + rr*(6.61375632143793436117e-05
+                          + rr*(-1.65339022054652515390e-06
+                                + rr*4.13813679705723846039e-08))));
+  const dax::Scalar p = 1 - ((lo - (r*c)/(2 - c)) - hi);
+#endif
+
+  // Scale by 2**n in two steps so that results near overflow and in the
+  // subnormal range are both representable and rounded once.
+  const dax::internal::Int32Type halfN = n/2;
+  dax::Scalar result = (p*Pow2(halfN))*Pow2(n - halfN);
+
+  result = Select(x < MaxArg, result, dax::math::Infinity());
+  result = Select(x > MinArg, result, dax::Scalar(0));
+  return Select(x == x, result, x);
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar LogKernel(dax::Scalar x)
+{
+#if DAX_SIZE_SCALAR == 4
+  const dax::Scalar MinNormal = 1.17549435e-38f;
+  const dax::Scalar SubnormalScale = 33554432.0f; // 2**25
+  const dax::internal::Int32Type SubnormalExponent = 25;
+  // Offsets that move the mantissa into [sqrt(2)/2, sqrt(2)).
+  const BitsType One = 0x3f800000;
+  const BitsType SqrtHalf = 0x3f3504f3;
+  const BitsType MantissaMask = 0x007fffff;
+  const dax::Scalar Ln2Hi = 6.9313812256e-01f;
+  const dax::Scalar Ln2Lo = 9.0580006145e-06f;
+#else
+  const dax::Scalar MinNormal = 2.2250738585072014e-308;
+  const dax::Scalar SubnormalScale = 18014398509481984.0; // 2**54
+  const dax::internal::Int32Type SubnormalExponent = 54;
+  const BitsType One = 0x3ff0000000000000ULL;
+  const BitsType SqrtHalf = 0x3fe6a09e00000000ULL;
+  const BitsType MantissaMask = 0x000fffffffffffffULL;
+  const dax::Scalar Ln2Hi = 6.93147180369123816490e-01;
+  const dax::Scalar Ln2Lo = 1.90821492927058770002e-10;
+#endif
+
+  const bool subnormal = (x < MinNormal);
+  const dax::Scalar xs = Select(subnormal, x*SubnormalScale, x);
+
+  // x = 2**k * m with m in [sqrt(2)/2, sqrt(2)).
+  BitsType bits = AsBits(xs) + (One - SqrtHalf);
+  const dax::internal::Int32Type k =
+      static_cast<dax::internal::Int32Type>(bits >> MANTISSA_BITS)
+      - EXPONENT_BIAS - (subnormal ? SubnormalExponent : 0);
+  bits = (bits & MantissaMask) + SqrtHalf;
+  const dax::Scalar f = AsScalar(bits) - 1;
+
+  // log(1+f) = f - f*f/2 + s*(f*f/2 + R(s*s)) with s = f/(2+f).
+  const dax::Scalar s = f/(2 + f);
+  const dax::Scalar z = s*s;
+  const dax::Scalar w = z*z;
+#if DAX_SIZE_SCALAR == 4
+  const dax::Scalar t1 = w*(0.40000972152f + w*0.24279078841f);
+  const dax::Scalar t2 = z*(0.66666662693f + w*0.28498786688f);
+#else
+  const dax::Scalar t1 = w*(3.999999999940941908e-01
+                            + w*(2.222219843214978396e-01
+                                 + w*1.531383769920937332e-01));
+  const dax::Scalar t2 = z*(6.666666666666735130e-01
+                            + w*(2.857142874366239149e-01
+                                 + w*(1.818357216161805012e-01
+                                      + w*1.479819860511658591e-01)));
+#endif
+  const dax::Scalar hfsq = dax::Scalar(0.5)*f*f;
+  const dax::Scalar kScalar = static_cast<dax::Scalar>(k);
+  dax::Scalar result =
+      s*(hfsq + t1 + t2) + kScalar*Ln2Lo - hfsq + f + kScalar*Ln2Hi;
+
+  result = Select(x < dax::math::Infinity(), result, x);
+  result = Select(x == 0, dax::math::NegativeInfinity(), result);
+  return Select(x >= 0, result, dax::math::Nan());
+}
+
+/// Largest magnitude reduced by the trigonometric kernels.
+const dax::Scalar TrigMaxArg = 524288; // 2**19
+
+/// Reduces |x| to r in [-pi/4, pi/4] and returns the octant in \p j.
+///
+/// The reduction is done in double precision with pi/4 split into parts of
+/// 33 bits, so the products with the octant (at most 20 bits) are exact and
+/// there is no cancellation error near multiples of pi/4. When dax::Scalar is
+/// double, the rounding error of r is returned in \p correction so that the
+/// polynomials can account for it; otherwise \p correction is 0.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Scalar TrigReduce(dax::Scalar absX,
+                       dax::internal::Int32Type &j,
+                       dax::Scalar &correction)
+{
+  const double FourOverPi = 1.27323954473516268615;
+  const double PiOver4Part1 = 7.85398163367062807085e-01;
+  const double PiOver4Part2 = 3.03855025315198298830e-11;
+  const double PiOver4Part3 = 1.01113312439797531577e-21;
+
+  // Arguments outside the domain (including NaN and infinity) are computed
+  // as 0 and replaced by the caller.
+  const double xc =
+      static_cast<double>(Select(absX <= TrigMaxArg, absX, dax::Scalar(0)));
+  j = static_cast<dax::internal::Int32Type>(xc*FourOverPi);
+  j = (j + 1) & ~1;
+  const double y = static_cast<double>(j);
+  const double head = xc - y*PiOver4Part1;
+  const double part2 = y*PiOver4Part2;
+  const double r2 = head - part2;
+  const double tail = ((head - r2) - part2) - y*PiOver4Part3;
+  const double r = r2 + tail;
+#if DAX_SIZE_SCALAR == 4
+  correction = 0;
+  return static_cast<dax::Scalar>(r);
+#else
+  correction = (r2 - r) + tail;
+  return r;
+#endif
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar SinPolynomial(dax::Scalar r, dax::Scalar z)
+{
+#if DAX_SIZE_SCALAR == 4
+  return ((-1.9515295891e-4f*z + 8.3321608736e-3f)*z - 1.6666654611e-1f)*z*r
+      + r;
+#else
+  return r + r*z*(((((1.58962301576546568060e-10*z
+                      - 2.50507477628578072866e-8)*z
+                     + 2.75573136213857245213e-6)*z
+                    - 1.98412698295895385996e-4)*z
+                   + 8.33333333332211858878e-3)*z
+                  - 1.66666666666666307295e-1);
+#endif
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar CosPolynomial(dax::Scalar z)
+{
+#if DAX_SIZE_SCALAR == 4
+  return ((2.443315711809948e-5f*z - 1.388731625493765e-3f)*z
+          + 4.166664568298827e-2f)*z*z - 0.5f*z + 1;
+#else
+  return 1 - 0.5*z + z*z*(((((-1.13585365213876817300e-11*z
+                              + 2.08757008419747316778e-9)*z
+                             - 2.75573141792967388112e-7)*z
+                            + 2.48015872888517045348e-5)*z
+                           - 1.38888888888730564116e-3)*z
+                          + 4.16666666666665929218e-2);
+#endif
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar SinKernel(dax::Scalar x)
+{
+  const dax::Scalar absX = Select(x < 0, -x, x);
+  dax::internal::Int32Type j;
+  dax::Scalar c;
+  const dax::Scalar r = TrigReduce(absX, j, c);
+  const dax::Scalar z = r*r;
+  // sin(r + c) ~ sin(r) + c cos(r) and cos(r + c) ~ cos(r) - c sin(r).
+  dax::Scalar result = Select((j & 2) != 0,
+                              CosPolynomial(z) - c*r,
+                              SinPolynomial(r, z) + c*(1 - dax::Scalar(0.5)*z));
+  const bool negate = ((j & 4) != 0) != (x < 0);
+  return Select(negate, -result, result);
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar CosKernel(dax::Scalar x)
+{
+  const dax::Scalar absX = Select(x < 0, -x, x);
+  dax::internal::Int32Type j;
+  dax::Scalar c;
+  const dax::Scalar r = TrigReduce(absX, j, c);
+  const dax::Scalar z = r*r;
+  dax::Scalar result = Select((j & 2) != 0,
+                              SinPolynomial(r, z) + c*(1 - dax::Scalar(0.5)*z),
+                              CosPolynomial(z) - c*r);
+  const bool negate = ((j & 4) != 0) != ((j & 2) != 0);
+  return Select(negate, -result, result);
+}
+
+#if DAX_SIZE_SCALAR == 4
+const dax::Scalar RootMinNormal = 1.17549435e-38f;
+const dax::Scalar RootSubnormalScale = 16777216.0f; // 2**24
+const dax::Scalar RootSubnormalResultScale = 4096.0f; // 2**12
+#else
+const dax::Scalar RootMinNormal = 2.2250738585072014e-308;
+const dax::Scalar RootSubnormalScale = 18014398509481984.0; // 2**54
+const dax::Scalar RootSubnormalResultScale = 134217728.0; // 2**27
+#endif
+
+/// Reciprocal square root of a positive normal number.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar RSqrtNormal(dax::Scalar x)
+{
+#if DAX_SIZE_SCALAR == 4
+  const BitsType Magic = 0x5f375a86;
+  const int Iterations = 3;
+#else
+  const BitsType Magic = 0x5fe6eb50c7b537a9ULL;
+  const int Iterations = 4;
+#endif
+
+  // Initial estimate from the exponent bits, refined with Newton's method.
+  dax::Scalar y = AsScalar(Magic - (AsBits(x) >> 1));
+  const dax::Scalar halfX = dax::Scalar(0.5)*x;
+  for (int iteration = 0; iteration < Iterations; iteration++)
+    {
+    y = y*(dax::Scalar(1.5) - halfX*y*y);
+    }
+  return y;
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar RSqrtKernel(dax::Scalar x)
+{
+  // Subnormals are scaled by an even power of two into the normal range.
+  const bool subnormal = (x < RootMinNormal);
+  dax::Scalar y = RSqrtNormal(Select(subnormal, x*RootSubnormalScale, x));
+  y = Select(subnormal, y*RootSubnormalResultScale, y);
+
+  y = Select(x < dax::math::Infinity(), y, dax::Scalar(0));
+  y = Select(x == 0, dax::math::Infinity(), y);
+  return Select(x >= 0, y, dax::math::Nan());
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar SqrtKernel(dax::Scalar x)
+{
+  const bool subnormal = (x < RootMinNormal);
+  const dax::Scalar xs = Select(subnormal, x*RootSubnormalScale, x);
+  const dax::Scalar r = RSqrtNormal(xs);
+  dax::Scalar s = xs*r;
+  // One Newton step on s*s = x, using r as the derivative.
+  s = s + dax::Scalar(0.5)*r*(xs - s*s);
+  s = Select(subnormal, s*(1/RootSubnormalResultScale), s);
+
+  s = Select(x < dax::math::Infinity(), s, x);
+  s = Select(x == 0, x, s);
+  return Select(x >= 0, s, dax::math::Nan());
+}
+
+DAX_EXEC_CONT_EXPORT dax::Scalar PowKernel(dax::Scalar x, dax::Scalar y)
+{
+  const dax::Scalar absX = Select(x < 0, -x, x);
+  dax::Scalar result = ExpKernel(y*LogKernel(absX));
+
+  // Negative bases only have real powers for integer exponents. Every
+  // scalar at least 2**(MANTISSA_BITS+1) is an even integer, and skipping
+  // those keeps the conversion below in range.
+  const dax::Scalar absY = Select(y < 0, -y, y);
+  const bool bigY = !(absY < IntegerLimit);
+  const IntType truncY = static_cast<IntType>(Select(bigY, dax::Scalar(0), y));
+  const bool integerY = bigY || (static_cast<dax::Scalar>(truncY) == y);
+  const bool oddY = !bigY && ((truncY & 1) != 0);
+  result = Select((x < 0) && integerY && oddY, -result, result);
+  result = Select((x < 0) && !integerY, dax::math::Nan(), result);
+
+  // x**0 and 1**y are always 1, even for NaN.
+  result = Select(x == 1, dax::Scalar(1), result);
+  return Select(y == 0, dax::Scalar(1), result);
+}
+
+/// Applies a batch kernel to each component of a tuple.
+///
+template<dax::Scalar (*Kernel)(dax::Scalar), int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Map(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  dax::Tuple<dax::Scalar,Size> result;
+  for (int component = 0; component < Size; component++)
+    {
+    result[component] = Kernel(x[component]);
+    }
+  return result;
+}
+
+/// Replaces the result of a trigonometric kernel for arguments it cannot
+/// reduce (large magnitudes, infinities and NaN) with the system function.
+///
+template<dax::Scalar (*SysMathFunc)(dax::Scalar)>
+DAX_EXEC_CONT_EXPORT
+dax::Scalar TrigFixup(dax::Scalar x, dax::Scalar result)
+{
+  const dax::Scalar absX = (x < 0) ? -x : x;
+  return (absX <= TrigMaxArg) ? result : SysMathFunc(x);
+}
+
+/// Applies a trigonometric kernel to each component of a tuple. The fixup is
+/// a separate loop, run only when some component needs it, so that the loops
+/// applying the kernel and checking the domain stay branch-free.
+///
+template<dax::Scalar (*Kernel)(dax::Scalar),
+         dax::Scalar (*SysMathFunc)(dax::Scalar),
+         int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> TrigMap(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  bool insideDomain = true;
+  for (int component = 0; component < Size; component++)
+    {
+    insideDomain &=
+        (x[component] <= TrigMaxArg) & (x[component] >= -TrigMaxArg);
+    }
+  if (insideDomain)
+    {
+    return Map<Kernel>(x);
+    }
+
+  dax::Tuple<dax::Scalar,Size> result = Map<Kernel>(x);
+  for (int component = 0; component < Size; component++)
+    {
+    result[component] =
+        TrigFixup<SysMathFunc>(x[component], result[component]);
+    }
+  return result;
+}
+
+} // namespace internal
+
+//-----------------------------------------------------------------------------
+/// Computes e**\p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Exp(dax::Scalar x)
+{
+  return internal::ExpKernel(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Exp(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::Map<internal::ExpKernel>(x);
+}
+
+//-----------------------------------------------------------------------------
+/// Computes the natural logarithm of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Log(dax::Scalar x)
+{
+  return internal::LogKernel(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Log(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::Map<internal::LogKernel>(x);
+}
+
+//-----------------------------------------------------------------------------
+/// Computes the sine of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Sin(dax::Scalar x)
+{
+  return internal::TrigFixup<DAX_SYS_MATH_FUNCTION(sin)>(
+        x, internal::SinKernel(x));
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Sin(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::TrigMap<internal::SinKernel,
+                           DAX_SYS_MATH_FUNCTION(sin)>(x);
+}
+
+/// Computes the cosine of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Cos(dax::Scalar x)
+{
+  return internal::TrigFixup<DAX_SYS_MATH_FUNCTION(cos)>(
+        x, internal::CosKernel(x));
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Cos(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::TrigMap<internal::CosKernel,
+                           DAX_SYS_MATH_FUNCTION(cos)>(x);
+}
+
+//-----------------------------------------------------------------------------
+/// Computes the square root of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Sqrt(dax::Scalar x)
+{
+  return internal::SqrtKernel(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Sqrt(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::Map<internal::SqrtKernel>(x);
+}
+
+/// Computes the reciprocal square root of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar RSqrt(dax::Scalar x)
+{
+  return internal::RSqrtKernel(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> RSqrt(const dax::Tuple<dax::Scalar,Size> &x)
+{
+  return internal::Map<internal::RSqrtKernel>(x);
+}
+
+//-----------------------------------------------------------------------------
+/// Computes \p x raised to the power of \p y.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Pow(dax::Scalar x, dax::Scalar y)
+{
+  return internal::PowKernel(x, y);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Pow(const dax::Tuple<dax::Scalar,Size> &x,
+                                 const dax::Tuple<dax::Scalar,Size> &y)
+{
+  dax::Tuple<dax::Scalar,Size> result;
+  for (int component = 0; component < Size; component++)
+    {
+    result[component] = internal::PowKernel(x[component], y[component]);
+    }
+  return result;
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Pow(const dax::Tuple<dax::Scalar,Size> &x,
+                                 dax::Scalar y)
+{
+  return dax::math::batch::Pow(x, dax::Tuple<dax::Scalar,Size>(y));
+}
+
+}
+}
+} // namespace dax::math::batch
+
+#endif //__dax_math_Batch_h
@@ -0,0 +1,279 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_math_PrecisionPolicy_h
+#define __dax_math_PrecisionPolicy_h
+
+// This header file defines tags that select how accurately a worklet wants
+// its math computed, and overloads of the dax::math functions that take one
+// of these tags as their last argument.
+//
+// A worklet declares its policy by redefining the PrecisionTag type it
+// inherits from dax::exec::internal::WorkletBase and passes PrecisionTag() to
+// the math functions it calls:
+//
+//   class ShadingNormal : public dax::exec::WorkletMapField
+//   {
+//   public:
+//     typedef dax::math::PrecisionTagFast PrecisionTag;
+//     ...
+//     dax::Vector3 operator()(const dax::Vector3 &v) const
+//     {
+//       return dax::math::Normal(v, PrecisionTag());
+//     }
+//   };
+//
+// With PrecisionTagExact the overloads forward to the regular dax::math
+// functions. With PrecisionTagFast they use approximations built from
+// multiplies and adds, which avoid divides and square roots and vectorize.
+// For finite, normal arguments with a normal result, the relative error of
+// every fast function is below 1e-5 regardless of the size of dax::Scalar.
+// Zero, infinite, NaN and subnormal arguments are not handled by the fast
+// functions.
+
+#include <dax/Types.h>
+#include <dax/math/Batch.h>
+#include <dax/math/Exp.h>
+#include <dax/math/Matrix.h>
+#include <dax/math/PrecisionTags.h>
+#include <dax/math/VectorAnalysis.h>
+
+namespace dax {
+namespace math {
+
+namespace internal {
+
+#if DAX_SIZE_SCALAR == 4
+const dax::math::batch::internal::BitsType ReciprocalMagic = 0x7EF311C3;
+const dax::math::batch::internal::BitsType RSqrtMagic = 0x5F375A86;
+const dax::math::batch::internal::BitsType SignMask = 0x80000000;
+#else
+const dax::math::batch::internal::BitsType ReciprocalMagic =
+    0x7FDE623860000000ULL;
+const dax::math::batch::internal::BitsType RSqrtMagic =
+    0x5FE6EB50C7B537A9ULL;
+const dax::math::batch::internal::BitsType SignMask =
+    0x8000000000000000ULL;
+#endif
+
+}
+
+//-----------------------------------------------------------------------------
+/// Computes 1/\p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Reciprocal(dax::Scalar x, PrecisionTagExact)
+{
+  return 1/x;
+}
+DAX_EXEC_CONT_EXPORT dax::Scalar Reciprocal(dax::Scalar x, PrecisionTagFast)
+{
+  using namespace dax::math::batch::internal;
+  // The magic constant gives an estimate within 6% for positive numbers.
+  // Each Newton step squares the relative error.
+  const BitsType bits = AsBits(x);
+  const BitsType sign = bits & internal::SignMask;
+  dax::Scalar y = AsScalar((internal::ReciprocalMagic - (bits ^ sign)) | sign);
+  y = y*(2 - x*y);
+  y = y*(2 - x*y);
+  return y;
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Reciprocal(const dax::Tuple<dax::Scalar,Size> &x,
+                                        PrecisionTagExact)
+{
+  dax::Tuple<dax::Scalar,Size> result;
+  for (int component = 0; component < Size; component++)
+    {
+    result[component] = 1/x[component];
+    }
+  return result;
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Reciprocal(const dax::Tuple<dax::Scalar,Size> &x,
+                                        PrecisionTagFast)
+{
+  dax::Tuple<dax::Scalar,Size> result;
+  for (int component = 0; component < Size; component++)
+    {
+    result[component] = Reciprocal(x[component], PrecisionTagFast());
+    }
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+/// Computes the reciprocal square root of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar RSqrt(dax::Scalar x, PrecisionTagExact)
+{
+  return dax::math::RSqrt(x);
+}
+DAX_EXEC_CONT_EXPORT dax::Scalar RSqrt(dax::Scalar x, PrecisionTagFast)
+{
+  using namespace dax::math::batch::internal;
+  dax::Scalar y = AsScalar(internal::RSqrtMagic - (AsBits(x) >> 1));
+  const dax::Scalar halfX = dax::Scalar(0.5)*x;
+  y = y*(dax::Scalar(1.5) - halfX*y*y);
+  y = y*(dax::Scalar(1.5) - halfX*y*y);
+  return y;
+}
+
+//-----------------------------------------------------------------------------
+/// Computes the square root of \p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Sqrt(dax::Scalar x, PrecisionTagExact)
+{
+  return dax::math::Sqrt(x);
+}
+DAX_EXEC_CONT_EXPORT dax::Scalar Sqrt(dax::Scalar x, PrecisionTagFast)
+{
+  return x*dax::math::RSqrt(x, PrecisionTagFast());
+}
+
+//-----------------------------------------------------------------------------
+/// Computes e**\p x.
+///
+DAX_EXEC_CONT_EXPORT dax::Scalar Exp(dax::Scalar x, PrecisionTagExact)
+{
+  return dax::math::Exp(x);
+}
+DAX_EXEC_CONT_EXPORT dax::Scalar Exp(dax::Scalar x, PrecisionTagFast)
+{
+  using namespace dax::math::batch::internal;
+  // x = n*ln(2) + r with |r| <= ln(2)/2, and a degree 5 Taylor polynomial
+  // for e**r.
+  const dax::internal::Int32Type n =
+      RoundToInt(x*dax::Scalar(1.44269504088896340736));
+  const dax::Scalar nScalar = static_cast<dax::Scalar>(n);
+  const dax::Scalar r = (x - nScalar*dax::Scalar(0.693359375))
+      + nScalar*dax::Scalar(2.12194440054690583e-4);
+  const dax::Scalar p =
+      (((((dax::Scalar(1.0/120.0)*r + dax::Scalar(1.0/24.0))*r
+          + dax::Scalar(1.0/6.0))*r + dax::Scalar(0.5))*r + 1)*r + 1);
+  return p*Pow2(n);
+}
+
+//-----------------------------------------------------------------------------
+/// Returns the magnitude of a vector.
+///
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Scalar Magnitude(const dax::Tuple<dax::Scalar,Size> &x, PrecisionTagExact)
+{
+  return dax::math::Magnitude(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Scalar Magnitude(const dax::Tuple<dax::Scalar,Size> &x, PrecisionTagFast)
+{
+  return dax::math::Sqrt(dax::dot(x,x), PrecisionTagFast());
+}
+
+/// Returns the reciprocal magnitude of a vector.
+///
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Scalar RMagnitude(const dax::Tuple<dax::Scalar,Size> &x, PrecisionTagExact)
+{
+  return dax::math::RMagnitude(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Scalar RMagnitude(const dax::Tuple<dax::Scalar,Size> &x, PrecisionTagFast)
+{
+  return dax::math::RSqrt(dax::dot(x,x), PrecisionTagFast());
+}
+
+/// Returns a normalized version of the given vector.
+///
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Normal(const dax::Tuple<dax::Scalar,Size> &x,
+                                    PrecisionTagExact)
+{
+  return dax::math::Normal(x);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> Normal(const dax::Tuple<dax::Scalar,Size> &x,
+                                    PrecisionTagFast)
+{
+  return dax::math::RMagnitude(x, PrecisionTagFast()) * x;
+}
+
+/// Scales the given vector to unit length.
+///
+template<int Size, class PrecisionTag>
+DAX_EXEC_CONT_EXPORT
+void Normalize(dax::Tuple<dax::Scalar,Size> &x, PrecisionTag)
+{
+  x = dax::math::Normal(x, PrecisionTag());
+}
+
+//-----------------------------------------------------------------------------
+/// Solve the linear system Ax = b for x. If a single solution is found, valid
+/// is set to true, false otherwise.
+///
+/// With PrecisionTagFast, 3x3 systems are solved with Cramer's rule and an
+/// approximate reciprocal of the determinant instead of an LUP factorization.
+/// This is not stable for badly conditioned matrices.
+///
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> SolveLinearSystem(
+    const dax::math::Matrix<dax::Scalar,Size,Size> &A,
+    const dax::Tuple<dax::Scalar,Size> &b,
+    bool &valid,
+    PrecisionTagExact)
+{
+  return dax::math::SolveLinearSystem(A, b, valid);
+}
+template<int Size>
+DAX_EXEC_CONT_EXPORT
+dax::Tuple<dax::Scalar,Size> SolveLinearSystem(
+    const dax::math::Matrix<dax::Scalar,Size,Size> &A,
+    const dax::Tuple<dax::Scalar,Size> &b,
+    bool &valid,
+    PrecisionTagFast)
+{
+  return dax::math::SolveLinearSystem(A, b, valid);
+}
+DAX_EXEC_CONT_EXPORT
+dax::Vector3 SolveLinearSystem(const dax::math::Matrix3x3 &A,
+                               const dax::Vector3 &b,
+                               bool &valid,
+                               PrecisionTagFast)
+{
+  const dax::Vector3 row0 = dax::math::MatrixRow(A, 0);
+  const dax::Vector3 row1 = dax::math::MatrixRow(A, 1);
+  const dax::Vector3 row2 = dax::math::MatrixRow(A, 2);
+
+  // The columns of the inverse times the determinant.
+  const dax::Vector3 cofactor0 = dax::math::Cross(row1, row2);
+  const dax::Vector3 cofactor1 = dax::math::Cross(row2, row0);
+  const dax::Vector3 cofactor2 = dax::math::Cross(row0, row1);
+
+  const dax::Scalar determinant = dax::dot(row0, cofactor0);
+  valid = (determinant != 0);
+
+  return dax::math::Reciprocal(determinant, PrecisionTagFast())
+      * (b[0]*cofactor0 + b[1]*cofactor1 + b[2]*cofactor2);
+}
+
+}
+} // namespace dax::math
+
+#endif //__dax_math_PrecisionPolicy_h
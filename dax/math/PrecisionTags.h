@@ -0,0 +1,40 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_math_PrecisionTags_h
+#define __dax_math_PrecisionTags_h
+
+// This header file defines the tags a worklet uses to declare how accurately
+// it wants its math computed. See dax/math/PrecisionPolicy.h for the math
+// functions that take them.
+
+namespace dax {
+namespace math {
+
+/// Tag selecting the regular, accurate dax::math functions. This is the
+/// precision used by worklets that do not declare one.
+///
+struct PrecisionTagExact {  };
+
+/// Tag selecting approximate dax::math functions with a relative error below
+/// 1e-5. Meant for values that are only displayed, such as colors and
+/// shading normals.
+///
+struct PrecisionTagFast {  };
+
+}
+} // namespace dax::math
+
+#endif //__dax_math_PrecisionTags_h
@@ -0,0 +1,365 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/math/Batch.h>
+
+#include <dax/Types.h>
+#include <dax/math/Precision.h>
+
+#include <dax/testing/Testing.h>
+
+#include <cmath>
+#include <limits>
+
+//-----------------------------------------------------------------------------
+namespace {
+
+// The reference is computed with more bits than dax::Scalar so that the
+// measured error is the error of the batch kernel.
+#if DAX_SIZE_SCALAR == 4
+typedef double ReferenceType;
+#else
+typedef long double ReferenceType;
+#endif
+
+typedef std::numeric_limits<dax::Scalar> ScalarLimits;
+
+/// Returns the distance between computed and reference in units of the last
+/// place of dax::Scalar at reference.
+///
+double UlpError(dax::Scalar computed, ReferenceType reference)
+{
+  if (static_cast<ReferenceType>(computed) == reference) { return 0; }
+  int exponent;
+  std::frexp(reference, &exponent);
+  if (exponent < ScalarLimits::min_exponent)
+    {
+    exponent = ScalarLimits::min_exponent;
+    }
+  const ReferenceType ulp = std::ldexp(ReferenceType(1),
+                                       exponent - ScalarLimits::digits);
+  return static_cast<double>(
+        std::fabs(static_cast<ReferenceType>(computed) - reference)/ulp);
+}
+
+bool IsRepresentable(ReferenceType reference)
+{
+  return std::fabs(reference) <= ScalarLimits::max();
+}
+
+bool SameSpecial(dax::Scalar computed, dax::Scalar expected)
+{
+  if (dax::math::IsNan(expected)) { return dax::math::IsNan(computed); }
+  return computed == expected;
+}
+
+/// Compares a tuple result with the scalar one. The compiler may contract
+/// multiplies and adds into fused operations differently in vectorized and
+/// scalar code, so they are only required to agree within one unit in the
+/// last place.
+///
+bool SameResult(dax::Scalar computed, dax::Scalar expected)
+{
+  if (SameSpecial(computed, expected)) { return true; }
+  if (!dax::math::IsFinite(expected)) { return false; }
+  return UlpError(computed, expected) <= 1;
+}
+
+//-----------------------------------------------------------------------------
+struct ErrorTracker
+{
+  double MaxError;
+  dax::Scalar WorstInput;
+  ErrorTracker() : MaxError(0), WorstInput(0) {  }
+  void Add(dax::Scalar input, dax::Scalar computed, ReferenceType reference)
+  {
+    if (!IsRepresentable(reference)) { return; }
+    const double error = UlpError(computed, reference);
+    if (!(error <= this->MaxError))
+      {
+      this->MaxError = error;
+      this->WorstInput = input;
+      }
+  }
+  void Check(const char *name, double bound) const
+  {
+    std::cout << "  " << name << " max error " << this->MaxError
+              << " ULP at " << this->WorstInput << std::endl;
+    DAX_TEST_ASSERT(this->MaxError <= bound,
+                    "Batch function exceeds its documented error.");
+  }
+};
+
+/// Samples the positive finite scalars, including subnormals, with a fixed
+/// number of mantissas for every binary exponent.
+template<class Functor>
+void SweepPositive(Functor &functor)
+{
+  const int MANTISSAS = 61;
+  for (int exponent = ScalarLimits::min_exponent - ScalarLimits::digits;
+       exponent < ScalarLimits::max_exponent;
+       exponent++)
+    {
+    for (int index = 0; index < MANTISSAS; index++)
+      {
+      const dax::Scalar x =
+          std::ldexp(dax::Scalar(1) + dax::Scalar(index)/MANTISSAS, exponent);
+      if (x > 0 && x < ScalarLimits::infinity()) { functor(x); }
+      }
+    }
+}
+
+template<class Functor>
+void SweepRange(Functor &functor, dax::Scalar low, dax::Scalar high, int count)
+{
+  for (int index = 0; index <= count; index++)
+    {
+    functor(low + (high - low)*(dax::Scalar(index)/count));
+    }
+}
+
+//-----------------------------------------------------------------------------
+struct ExpSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x, dax::math::batch::Exp(x), std::exp(ReferenceType(x)));
+  }
+};
+struct LogSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x, dax::math::batch::Log(x), std::log(ReferenceType(x)));
+  }
+};
+struct SinSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x, dax::math::batch::Sin(x), std::sin(ReferenceType(x)));
+  }
+};
+struct CosSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x, dax::math::batch::Cos(x), std::cos(ReferenceType(x)));
+  }
+};
+struct SqrtSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x, dax::math::batch::Sqrt(x), std::sqrt(ReferenceType(x)));
+  }
+};
+struct RSqrtSample : ErrorTracker {
+  void operator()(dax::Scalar x) {
+    this->Add(x,
+              dax::math::batch::RSqrt(x),
+              1/std::sqrt(ReferenceType(x)));
+  }
+};
+
+void TestExp()
+{
+  std::cout << "Exp" << std::endl;
+  ExpSample sample;
+  SweepRange(sample, -110, 90, 400000);
+  SweepRange(sample, -1, 1, 100000);
+#if DAX_SIZE_SCALAR == 4
+  sample.Check("Exp", 2);
+#else
+  sample.Check("Exp", 1);
+#endif
+
+  DAX_TEST_ASSERT(dax::math::batch::Exp(0) == 1, "Bad exp(0).");
+  DAX_TEST_ASSERT(dax::math::batch::Exp(dax::math::Infinity())
+                  == dax::math::Infinity(), "Bad exp(inf).");
+  DAX_TEST_ASSERT(dax::math::batch::Exp(dax::math::NegativeInfinity()) == 0,
+                  "Bad exp(-inf).");
+  DAX_TEST_ASSERT(dax::math::batch::Exp(ScalarLimits::max())
+                  == dax::math::Infinity(), "Exp does not overflow.");
+  DAX_TEST_ASSERT(dax::math::batch::Exp(-ScalarLimits::max()) == 0,
+                  "Exp does not underflow.");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::Exp(dax::math::Nan())),
+                  "Bad exp(nan).");
+}
+
+void TestLog()
+{
+  std::cout << "Log" << std::endl;
+  LogSample sample;
+  SweepPositive(sample);
+  SweepRange(sample, dax::Scalar(0.5), 2, 100000);
+  sample.Check("Log", 1);
+
+  DAX_TEST_ASSERT(dax::math::batch::Log(1) == 0, "Bad log(1).");
+  DAX_TEST_ASSERT(dax::math::batch::Log(0) == dax::math::NegativeInfinity(),
+                  "Bad log(0).");
+  DAX_TEST_ASSERT(dax::math::batch::Log(dax::math::Infinity())
+                  == dax::math::Infinity(), "Bad log(inf).");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::Log(-1)),
+                  "Bad log(-1).");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::Log(dax::math::Nan())),
+                  "Bad log(nan).");
+}
+
+void TestTrig()
+{
+  std::cout << "Sin and Cos" << std::endl;
+  SinSample sinSample;
+  CosSample cosSample;
+  SweepRange(sinSample, -8192, 8192, 400000);
+  SweepRange(cosSample, -8192, 8192, 400000);
+  SweepRange(sinSample, -10, 10, 100000);
+  SweepRange(cosSample, -10, 10, 100000);
+  // Beyond the reduction domain the system functions are used.
+  SweepRange(sinSample, 1e4, 1e6, 1000);
+  SweepRange(cosSample, 1e4, 1e6, 1000);
+  sinSample.Check("Sin", 2);
+  cosSample.Check("Cos", 2);
+
+  DAX_TEST_ASSERT(dax::math::batch::Sin(0) == 0, "Bad sin(0).");
+  DAX_TEST_ASSERT(dax::math::batch::Cos(0) == 1, "Bad cos(0).");
+  DAX_TEST_ASSERT(dax::math::IsNan(
+                    dax::math::batch::Sin(dax::math::Infinity())),
+                  "Bad sin(inf).");
+  DAX_TEST_ASSERT(dax::math::IsNan(
+                    dax::math::batch::Cos(dax::math::Nan())),
+                  "Bad cos(nan).");
+}
+
+void TestRoots()
+{
+  std::cout << "Sqrt and RSqrt" << std::endl;
+  SqrtSample sqrtSample;
+  RSqrtSample rsqrtSample;
+  SweepPositive(sqrtSample);
+  SweepPositive(rsqrtSample);
+  sqrtSample.Check("Sqrt", 1);
+  rsqrtSample.Check("RSqrt", 2);
+
+  DAX_TEST_ASSERT(dax::math::batch::Sqrt(0) == 0, "Bad sqrt(0).");
+  DAX_TEST_ASSERT(dax::math::batch::Sqrt(4) == 2, "Bad sqrt(4).");
+  DAX_TEST_ASSERT(dax::math::batch::Sqrt(dax::math::Infinity())
+                  == dax::math::Infinity(), "Bad sqrt(inf).");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::Sqrt(-1)),
+                  "Bad sqrt(-1).");
+  DAX_TEST_ASSERT(dax::math::batch::RSqrt(0) == dax::math::Infinity(),
+                  "Bad rsqrt(0).");
+  DAX_TEST_ASSERT(dax::math::batch::RSqrt(dax::math::Infinity()) == 0,
+                  "Bad rsqrt(inf).");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::RSqrt(-1)),
+                  "Bad rsqrt(-1).");
+}
+
+void TestPow()
+{
+  std::cout << "Pow" << std::endl;
+  double maxExcess = 0;
+  for (int xIndex = 1; xIndex <= 400; xIndex++)
+    {
+    const dax::Scalar x = dax::Scalar(0.25)*xIndex;
+    for (int yIndex = -200; yIndex <= 200; yIndex++)
+      {
+      const dax::Scalar y = dax::Scalar(0.1)*yIndex;
+      const ReferenceType reference =
+          std::pow(ReferenceType(x), ReferenceType(y));
+      if (!IsRepresentable(reference)) { continue; }
+      const double error = UlpError(dax::math::batch::Pow(x, y), reference);
+      const double bound =
+          2 + 2*std::fabs(static_cast<double>(y)*std::log(double(x)));
+      if (error - bound > maxExcess) { maxExcess = error - bound; }
+      }
+    }
+  std::cout << "  Pow max error over bound " << maxExcess << std::endl;
+  DAX_TEST_ASSERT(maxExcess <= 0, "Pow exceeds its documented error.");
+
+  DAX_TEST_ASSERT(test_equal(dax::math::batch::Pow(-2, 3), dax::Scalar(-8)),
+                  "Bad pow of negative base to odd power.");
+  DAX_TEST_ASSERT(test_equal(dax::math::batch::Pow(-2, 2), dax::Scalar(4)),
+                  "Bad pow of negative base to even power.");
+  DAX_TEST_ASSERT(dax::math::IsNan(dax::math::batch::Pow(-2, 0.5)),
+                  "Bad pow of negative base to fractional power.");
+  DAX_TEST_ASSERT(dax::math::batch::Pow(0, 2) == 0, "Bad pow(0,2).");
+  DAX_TEST_ASSERT(dax::math::batch::Pow(0, -2) == dax::math::Infinity(),
+                  "Bad pow(0,-2).");
+  DAX_TEST_ASSERT(dax::math::batch::Pow(dax::math::Nan(), 0) == 1,
+                  "Bad pow(nan,0).");
+  DAX_TEST_ASSERT(dax::math::batch::Pow(1, dax::math::Nan()) == 1,
+                  "Bad pow(1,nan).");
+}
+
+//-----------------------------------------------------------------------------
+template<int Size>
+void TestTuple()
+{
+  std::cout << "Tuple of " << Size << " components" << std::endl;
+  typedef dax::Tuple<dax::Scalar,Size> TupleType;
+  TupleType x;
+  TupleType positive;
+  for (int component = 0; component < Size; component++)
+    {
+    x[component] = dax::Scalar(1.75)*component - 3;
+    positive[component] = dax::Scalar(0.5) + component;
+    }
+  // Exercise the fixup of values outside the trigonometric domain.
+  x[Size-1] = dax::Scalar(1e5);
+
+  const TupleType expX = dax::math::batch::Exp(x);
+  const TupleType logX = dax::math::batch::Log(positive);
+  const TupleType sinX = dax::math::batch::Sin(x);
+  const TupleType cosX = dax::math::batch::Cos(x);
+  const TupleType sqrtX = dax::math::batch::Sqrt(positive);
+  const TupleType rsqrtX = dax::math::batch::RSqrt(positive);
+  const TupleType powX = dax::math::batch::Pow(positive, x);
+  const TupleType powScalar = dax::math::batch::Pow(positive, dax::Scalar(3));
+  for (int component = 0; component < Size; component++)
+    {
+    const dax::Scalar xc = x[component];
+    const dax::Scalar pc = positive[component];
+    DAX_TEST_ASSERT(SameResult(expX[component], dax::math::batch::Exp(xc)),
+                    "Tuple exp differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(logX[component], dax::math::batch::Log(pc)),
+                    "Tuple log differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(sinX[component], dax::math::batch::Sin(xc)),
+                    "Tuple sin differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(cosX[component], dax::math::batch::Cos(xc)),
+                    "Tuple cos differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(sqrtX[component], dax::math::batch::Sqrt(pc)),
+                    "Tuple sqrt differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(rsqrtX[component],
+                               dax::math::batch::RSqrt(pc)),
+                    "Tuple rsqrt differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(powX[component],
+                               dax::math::batch::Pow(pc, xc)),
+                    "Tuple pow differs from scalar.");
+    DAX_TEST_ASSERT(SameResult(powScalar[component],
+                               dax::math::batch::Pow(pc, 3)),
+                    "Tuple pow differs from scalar.");
+    }
+}
+
+void TestBatch()
+{
+  TestExp();
+  TestLog();
+  TestTrig();
+  TestRoots();
+  TestPow();
+  TestTuple<3>();
+  TestTuple<4>();
+  TestTuple<16>();
+}
+
+} // anonymous namespace
+
+int UnitTestMathBatch(int, char *[])
+{
+  return dax::testing::Testing::Run(TestBatch);
+}
@@ -0,0 +1,202 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/math/PrecisionPolicy.h>
+
+#include <dax/Types.h>
+
+#include <dax/testing/Testing.h>
+
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+namespace {
+
+// The documented bound on the relative error of the fast functions.
+const double FAST_TOLERANCE = 1e-5;
+
+double RelativeError(dax::Scalar value, double expected)
+{
+  return fabs(static_cast<double>(value) - expected)/fabs(expected);
+}
+
+// Calls the test functor on numbers in [minimum, maximum] covering many
+// binades, both at and between powers of two.
+template<class Functor>
+void SweepArguments(Functor functor,
+                    double minimum,
+                    double maximum,
+                    bool negate = true)
+{
+  for (double base = minimum; 2*base <= maximum; base *= 2)
+    {
+    for (int step = 0; step < 64; step++)
+      {
+      const dax::Scalar x = static_cast<dax::Scalar>(base*(1 + step/64.0));
+      functor(x);
+      if (negate) { functor(-x); }
+      }
+    }
+}
+
+struct ReciprocalTest
+{
+  void operator()(dax::Scalar x) const
+  {
+    DAX_TEST_ASSERT(
+          dax::math::Reciprocal(x, dax::math::PrecisionTagExact()) == 1/x,
+          "Exact reciprocal differs from a divide.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::Reciprocal(x, dax::math::PrecisionTagFast()),
+                        1/static_cast<double>(x)) < FAST_TOLERANCE,
+          "Fast reciprocal not within its error bound.");
+  }
+};
+
+struct RSqrtTest
+{
+  void operator()(dax::Scalar x) const
+  {
+    DAX_TEST_ASSERT(
+          dax::math::RSqrt(x, dax::math::PrecisionTagExact())
+          == dax::math::RSqrt(x),
+          "Exact RSqrt differs from dax::math::RSqrt.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::RSqrt(x, dax::math::PrecisionTagFast()),
+                        1/sqrt(static_cast<double>(x))) < FAST_TOLERANCE,
+          "Fast RSqrt not within its error bound.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::Sqrt(x, dax::math::PrecisionTagFast()),
+                        sqrt(static_cast<double>(x))) < FAST_TOLERANCE,
+          "Fast Sqrt not within its error bound.");
+  }
+};
+
+struct ExpTest
+{
+  void operator()(dax::Scalar x) const
+  {
+    DAX_TEST_ASSERT(
+          dax::math::Exp(x, dax::math::PrecisionTagExact())
+          == dax::math::Exp(x),
+          "Exact Exp differs from dax::math::Exp.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::Exp(x, dax::math::PrecisionTagFast()),
+                        exp(static_cast<double>(x))) < FAST_TOLERANCE,
+          "Fast Exp not within its error bound.");
+  }
+};
+
+//-----------------------------------------------------------------------------
+void TestScalarFunctions()
+{
+  std::cout << "Reciprocal" << std::endl;
+  SweepArguments(ReciprocalTest(), 1e-30, 1e30);
+
+  std::cout << "Sqrt and RSqrt" << std::endl;
+  SweepArguments(RSqrtTest(), 1e-30, 1e30, false);
+
+  std::cout << "Exp" << std::endl;
+  // Keep the results normal in single precision.
+  SweepArguments(ExpTest(), 1e-6, 80);
+}
+
+//-----------------------------------------------------------------------------
+void TestVectorFunctions()
+{
+  std::cout << "Vector functions" << std::endl;
+  const dax::Vector3 vectors[] = {
+    dax::make_Vector3(1, 0, 0),
+    dax::make_Vector3(3, 4, 12),
+    dax::make_Vector3(-0.001f, 0.002f, 0.0005f),
+    dax::make_Vector3(1000, -2500, 7)
+  };
+  for (int index = 0; index < 4; index++)
+    {
+    const dax::Vector3 &v = vectors[index];
+    const double magnitude = sqrt(static_cast<double>(dax::dot(v,v)));
+
+    DAX_TEST_ASSERT(
+          dax::math::Magnitude(v, dax::math::PrecisionTagExact())
+          == dax::math::Magnitude(v),
+          "Exact Magnitude differs from dax::math::Magnitude.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::Magnitude(v, dax::math::PrecisionTagFast()),
+                        magnitude) < FAST_TOLERANCE,
+          "Fast Magnitude not within its error bound.");
+    DAX_TEST_ASSERT(
+          RelativeError(dax::math::RMagnitude(v, dax::math::PrecisionTagFast()),
+                        1/magnitude) < FAST_TOLERANCE,
+          "Fast RMagnitude not within its error bound.");
+
+    dax::Vector3 normal = v;
+    dax::math::Normalize(normal, dax::math::PrecisionTagFast());
+    DAX_TEST_ASSERT(test_equal(normal, dax::math::Normal(v), FAST_TOLERANCE),
+                    "Fast Normalize gave wrong direction or length.");
+
+    DAX_TEST_ASSERT(
+          test_equal(dax::math::Reciprocal(v+dax::make_Vector3(1,1,1),
+                                           dax::math::PrecisionTagFast()),
+                     dax::make_Vector3(1,1,1)/(v+dax::make_Vector3(1,1,1)),
+                     FAST_TOLERANCE),
+          "Fast reciprocal of a vector is wrong.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestSolveLinearSystem()
+{
+  std::cout << "Solve linear system" << std::endl;
+  dax::math::Matrix3x3 A;
+  dax::math::MatrixSetRow(A, 0, dax::make_Vector3(2, 1, -1));
+  dax::math::MatrixSetRow(A, 1, dax::make_Vector3(-3, -1, 2));
+  dax::math::MatrixSetRow(A, 2, dax::make_Vector3(-2, 1, 2));
+  const dax::Vector3 b = dax::make_Vector3(8, -11, -3);
+
+  bool valid;
+  dax::Vector3 exact = dax::math::SolveLinearSystem(
+        A, b, valid, dax::math::PrecisionTagExact());
+  DAX_TEST_ASSERT(valid, "Exact solve reported singular matrix.");
+  DAX_TEST_ASSERT(test_equal(exact, dax::make_Vector3(2, 3, -1)),
+                  "Exact solve gave wrong answer.");
+
+  dax::Vector3 fast = dax::math::SolveLinearSystem(
+        A, b, valid, dax::math::PrecisionTagFast());
+  DAX_TEST_ASSERT(valid, "Fast solve reported singular matrix.");
+  DAX_TEST_ASSERT(test_equal(fast, dax::make_Vector3(2, 3, -1),
+                             FAST_TOLERANCE),
+                  "Fast solve gave wrong answer.");
+
+  dax::math::MatrixSetRow(A, 2, dax::make_Vector3(4, 2, -2));
+  dax::math::SolveLinearSystem(A, b, valid, dax::math::PrecisionTagFast());
+  DAX_TEST_ASSERT(!valid, "Fast solve did not detect singular matrix.");
+}
+
+//-----------------------------------------------------------------------------
+void TestPrecisionPolicy()
+{
+  TestScalarFunctions();
+  TestVectorFunctions();
+  TestSolveLinearSystem();
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestMathPrecisionPolicy(int, char *[])
+{
+  return dax::testing::Testing::Run(TestPrecisionPolicy);
+}
@@ -16,6 +16,8 @@
 #ifndef __dax_openmp_cont_DeviceAdapterOpenMP_h
 #define __dax_openmp_cont_DeviceAdapterOpenMP_h
 
+#include <dax/openmp/cont/PlacementOpenMP.h>
+#include <dax/openmp/cont/ScheduleOpenMP.h>
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
 #include <dax/openmp/cont/internal/ArrayManagerExecutionOpenMP.h>
 #include <dax/openmp/cont/internal/DeviceAdapterAlgorithmOpenMP.h>
@@ -0,0 +1,298 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_openmp_cont_PlacementOpenMP_h
+#define __dax_openmp_cont_PlacementOpenMP_h
+
+#include <dax/Types.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <omp.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_move_pages) && defined(SYS_getcpu)
+#define DAX_OPENMP_NUMA_PLACEMENT
+#endif
+
+// Placement of arrays and threads on NUMA systems. Memory pages live on the
+// node of the thread that first writes them, so the OpenMP device adapter
+// first-touches new output arrays with the same static partition that its
+// Schedule uses. Pinning the threads keeps each thread on the node that holds
+// its part of the arrays.
+
+namespace dax {
+namespace openmp {
+namespace cont {
+
+namespace internal {
+
+struct PlacementSettings
+{
+  bool FirstTouchOutput;
+};
+
+DAX_CONT_EXPORT PlacementSettings &GetPlacementSettings()
+{
+  static PlacementSettings settings = { true };
+  return settings;
+}
+
+DAX_CONT_EXPORT dax::Id GetPageSize()
+{
+#if defined(__linux__)
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  if (pageSize > 0) { return static_cast<dax::Id>(pageSize); }
+#endif
+  return 4096;
+}
+
+/// The begin of a block when \p numValues are split the way schedule(static)
+/// without a chunk size splits them: the first numValues%numBlocks blocks get
+/// one extra value.
+///
+DAX_CONT_EXPORT dax::Id GetStaticBlockBegin(dax::Id block,
+                                            dax::Id numBlocks,
+                                            dax::Id numValues)
+{
+  const dax::Id blockSize = numValues / numBlocks;
+  const dax::Id remainder = numValues % numBlocks;
+  return block*blockSize + std::min(block, remainder);
+}
+
+/// Writes one value per page of the portal, with the pages statically
+/// partitioned over the threads, so each page lands on the node of the
+/// thread that later writes it.
+///
+template<class PortalType>
+DAX_CONT_EXPORT void FirstTouch(const PortalType &portal)
+{
+  typedef typename PortalType::ValueType ValueType;
+
+  const dax::Id numValues = portal.GetNumberOfValues();
+  const dax::Id valuesPerPage =
+      std::max(dax::Id(1),
+               static_cast<dax::Id>(GetPageSize()/sizeof(ValueType)));
+  const dax::Id numPages = (numValues + valuesPerPage - 1)/valuesPerPage;
+
+  // Arrays this small do not span a page per thread.
+  if (numPages < omp_get_max_threads()) { return; }
+
+#pragma omp parallel for schedule(static)
+  for (dax::Id page = 0; page < numPages; page++)
+    {
+    portal.Set(page*valuesPerPage, ValueType());
+    }
+}
+
+#ifdef DAX_OPENMP_NUMA_PLACEMENT
+DAX_CONT_EXPORT void *GetPageAddress(const void *address)
+{
+  const unsigned long pageSize = static_cast<unsigned long>(GetPageSize());
+  return reinterpret_cast<void*>(
+        reinterpret_cast<unsigned long>(address) & ~(pageSize - 1));
+}
+
+DAX_CONT_EXPORT int GetCurrentNode()
+{
+  unsigned int cpu;
+  unsigned int node;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) { return -1; }
+  return static_cast<int>(node);
+}
+#endif
+
+/// The CPUs the process was allowed to run on before any threads were
+/// pinned.
+///
+DAX_CONT_EXPORT const std::vector<int> &GetAllowedCpus()
+{
+  static std::vector<int> cpus;
+  static bool initialized = false;
+  if (!initialized)
+    {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+      {
+      for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+        if (CPU_ISSET(cpu, &allowed)) { cpus.push_back(cpu); }
+        }
+      }
+#endif
+    initialized = true;
+    }
+  return cpus;
+}
+
+} // namespace internal
+
+/// Sets whether the OpenMP device adapter first-touches newly allocated
+/// output arrays in parallel. On by default.
+///
+DAX_CONT_EXPORT void SetFirstTouchOutput(bool firstTouch)
+{
+  internal::GetPlacementSettings().FirstTouchOutput = firstTouch;
+}
+
+DAX_CONT_EXPORT bool GetFirstTouchOutput()
+{
+  return internal::GetPlacementSettings().FirstTouchOutput;
+}
+
+/// Pins each OpenMP thread to its own CPU, taken in order from the CPUs the
+/// process may run on. Call it again after changing the number of threads.
+/// Returns false if pinning is not supported or a thread could not be
+/// pinned.
+///
+DAX_CONT_EXPORT bool PinThreads()
+{
+#if defined(__linux__)
+  const std::vector<int> &cpus = internal::GetAllowedCpus();
+  if (cpus.empty()) { return false; }
+
+  int failures = 0;
+#pragma omp parallel reduction(+:failures)
+  {
+    const std::size_t thread = static_cast<std::size_t>(omp_get_thread_num());
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpus[thread % cpus.size()], &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) { failures++; }
+  }
+  return (failures == 0);
+#else
+  return false;
+#endif
+}
+
+/// Returns, for each thread's static block of the array, the NUMA node
+/// holding the first page of the block. Entries are -1 where the node is
+/// unknown, such as for empty blocks, pages not yet touched or systems
+/// without NUMA support. The array must be in a basic container.
+///
+template<class ArrayHandleType>
+DAX_CONT_EXPORT std::vector<int> GetPlacement(const ArrayHandleType &array)
+{
+  const dax::Id numBlocks = omp_get_max_threads();
+  std::vector<int> nodes(numBlocks, -1);
+
+#ifdef DAX_OPENMP_NUMA_PLACEMENT
+  const dax::Id numValues = array.GetNumberOfValues();
+  if (numValues < 1) { return nodes; }
+
+  typename ArrayHandleType::PortalConstExecution portal =
+      array.PrepareForInput();
+
+  std::vector<void*> pages;
+  std::vector<dax::Id> pageBlocks;
+  for (dax::Id block = 0; block < numBlocks; block++)
+    {
+    const dax::Id begin =
+        internal::GetStaticBlockBegin(block, numBlocks, numValues);
+    if (begin < internal::GetStaticBlockBegin(block+1, numBlocks, numValues))
+      {
+      pages.push_back(
+            internal::GetPageAddress(&*(portal.GetIteratorBegin() + begin)));
+      pageBlocks.push_back(block);
+      }
+    }
+
+  // With no target nodes, move_pages reports the node of each page.
+  std::vector<int> status(pages.size(), -1);
+  if (syscall(SYS_move_pages, 0, pages.size(), &pages[0], NULL,
+              &status[0], 0) == 0)
+    {
+    for (std::size_t index = 0; index < pages.size(); index++)
+      {
+      nodes[pageBlocks[index]] = (status[index] >= 0) ? status[index] : -1;
+      }
+    }
+#else
+  (void)array;
+#endif
+
+  return nodes;
+}
+
+/// Moves the pages of each thread's static block of the array to the NUMA
+/// node the thread runs on. Use it for arrays that were filled by the
+/// control environment, and pin the threads first so they stay on those
+/// nodes. Returns false if the pages could not be moved. The array must be
+/// in a basic container.
+///
+template<class ArrayHandleType>
+DAX_CONT_EXPORT bool SetPlacement(ArrayHandleType &array)
+{
+#ifdef DAX_OPENMP_NUMA_PLACEMENT
+  const dax::Id numValues = array.GetNumberOfValues();
+  if (numValues < 1) { return true; }
+
+  typename ArrayHandleType::PortalExecution portal = array.PrepareForInPlace();
+  const dax::Id pageSize = internal::GetPageSize();
+  const dax::Id numBlocks = omp_get_max_threads();
+
+  int failures = 0;
+#pragma omp parallel for schedule(static) reduction(+:failures)
+  for (dax::Id block = 0; block < numBlocks; block++)
+    {
+    const dax::Id begin =
+        internal::GetStaticBlockBegin(block, numBlocks, numValues);
+    const dax::Id end =
+        internal::GetStaticBlockBegin(block+1, numBlocks, numValues);
+    if (begin >= end) { continue; }
+
+    char *firstPage = static_cast<char*>(
+          internal::GetPageAddress(&*(portal.GetIteratorBegin() + begin)));
+    const char *last =
+        reinterpret_cast<const char*>(&*(portal.GetIteratorBegin() + end-1));
+
+    std::vector<void*> pages;
+    for (char *page = firstPage; page <= last; page += pageSize)
+      {
+      pages.push_back(page);
+      }
+    std::vector<int> targetNodes(pages.size(), internal::GetCurrentNode());
+    std::vector<int> status(pages.size(), -1);
+
+    // MPOL_MF_MOVE: only move pages used by this process alone.
+    const int moveFlag = (1 << 1);
+    if ((targetNodes[0] < 0) ||
+        (syscall(SYS_move_pages, 0, pages.size(), &pages[0], &targetNodes[0],
+                 &status[0], moveFlag) != 0))
+      {
+      failures++;
+      }
+    }
+  return (failures == 0);
+#else
+  (void)array;
+  return false;
+#endif
+}
+
+}
+}
+} // namespace dax::openmp::cont
+
+#endif //__dax_openmp_cont_PlacementOpenMP_h
@@ -0,0 +1,76 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_openmp_cont_ScheduleOpenMP_h
+#define __dax_openmp_cont_ScheduleOpenMP_h
+
+#include <dax/internal/ExportMacros.h>
+
+namespace dax {
+namespace openmp {
+namespace cont {
+
+/// How the OpenMP device adapter hands out the iterations of its parallel
+/// loops. Static has the least overhead and suits worklets that do about the
+/// same work per index. Dynamic and guided cost more per chunk but balance
+/// worklets whose work varies a lot per index.
+///
+enum ScheduleType
+{
+  SCHEDULE_STATIC,
+  SCHEDULE_DYNAMIC,
+  SCHEDULE_GUIDED
+};
+
+namespace internal {
+
+struct ScheduleSettings
+{
+  ScheduleType Type;
+  int ChunkSize;
+};
+
+DAX_CONT_EXPORT ScheduleSettings &GetScheduleSettings()
+{
+  static ScheduleSettings settings = { SCHEDULE_STATIC, 0 };
+  return settings;
+}
+
+} // namespace internal
+
+/// Sets the schedule used by all subsequent loops of the OpenMP device
+/// adapter. A chunk size of 0 uses the OpenMP default for the schedule type.
+///
+DAX_CONT_EXPORT void SetSchedule(ScheduleType type, int chunkSize = 0)
+{
+  internal::GetScheduleSettings().Type = type;
+  internal::GetScheduleSettings().ChunkSize = (chunkSize > 0) ? chunkSize : 0;
+}
+
+DAX_CONT_EXPORT ScheduleType GetScheduleType()
+{
+  return internal::GetScheduleSettings().Type;
+}
+
+DAX_CONT_EXPORT int GetScheduleChunkSize()
+{
+  return internal::GetScheduleSettings().ChunkSize;
+}
+
+}
+}
+} // namespace dax::openmp::cont
+
+#endif //__dax_openmp_cont_ScheduleOpenMP_h
@@ -16,12 +16,12 @@
 #ifndef __dax_openmp_cont_internal_ArrayManagerExecutionOpenMP_h
 #define __dax_openmp_cont_internal_ArrayManagerExecutionOpenMP_h
 
-#include <dax/openmp/cont/internal/SetThrustForOpenMP.h>
-
+#include <dax/openmp/cont/PlacementOpenMP.h>
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
 
+#include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/internal/ArrayManagerExecution.h>
-#include <dax/thrust/cont/internal/ArrayManagerExecutionThrustShare.h>
+#include <dax/cont/internal/ArrayManagerExecutionShareWithControl.h>
 
 // These must be placed in the dax::cont::internal namespace so that
 // the template can be found.
@@ -33,15 +33,43 @@ namespace internal {
 template <typename T, class ArrayContainerTag>
 class ArrayManagerExecution
     <T, ArrayContainerTag, dax::openmp::cont::DeviceAdapterTagOpenMP>
-    : public dax::thrust::cont::internal::ArrayManagerExecutionThrustShare
+    : public dax::cont::internal::ArrayManagerExecutionShareWithControl
         <T, ArrayContainerTag>
 {
+};
+
+/// Basic arrays are allocated by the control thread, so without help all of
+/// their pages would land on its NUMA node. Newly allocated output arrays are
+/// instead first touched in parallel, with the static partition Schedule
+/// uses.
+///
+template <typename T>
+class ArrayManagerExecution
+    <T,
+    dax::cont::ArrayContainerControlTagBasic,
+    dax::openmp::cont::DeviceAdapterTagOpenMP>
+    : public dax::cont::internal::ArrayManagerExecutionShareWithControl
+        <T, dax::cont::ArrayContainerControlTagBasic>
+{
 public:
-  typedef dax::thrust::cont::internal::ArrayManagerExecutionThrustShare
-      <T, ArrayContainerTag> Superclass;
-  typedef typename Superclass::ValueType ValueType;
-  typedef typename Superclass::PortalType PortalType;
-  typedef typename Superclass::PortalConstType PortalConstType;
+  typedef dax::cont::internal::ArrayManagerExecutionShareWithControl
+      <T, dax::cont::ArrayContainerControlTagBasic> Superclass;
+  typedef typename Superclass::ContainerType ContainerType;
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    // Reused memory may still hold the input of an in place algorithm, so
+    // only touch memory that was just allocated.
+    const T *oldArray = controlArray.GetPortalConst().GetIteratorBegin();
+    this->Superclass::AllocateArrayForOutput(controlArray, numberOfValues);
+
+    if (dax::openmp::cont::GetFirstTouchOutput() &&
+        (controlArray.GetPortalConst().GetIteratorBegin() != oldArray))
+      {
+      dax::openmp::cont::internal::FirstTouch(this->GetPortal());
+      }
+  }
 };
 
 }
@@ -16,15 +16,27 @@
 #ifndef __dax_openmp_cont_internal_DeviceAdapterAlgorithmOpenMP_h
 #define __dax_openmp_cont_internal_DeviceAdapterAlgorithmOpenMP_h
 
-#include <dax/openmp/cont/internal/SetThrustForOpenMP.h>
-
+#include <dax/openmp/cont/ScheduleOpenMP.h>
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
 #include <dax/openmp/cont/internal/ArrayManagerExecutionOpenMP.h>
 
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/exec/internal/IJKIndex.h>
+
+#include <dax/Functional.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorExecution.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithm.h>
+#include <dax/cont/internal/DeviceAdapterAlgorithmGeneral.h>
+
+#include <boost/type_traits/remove_reference.hpp>
 
-// Here are the actual implementation of the algorithms.
-#include <dax/thrust/cont/internal/DeviceAdapterAlgorithmThrust.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
 
 #include <omp.h>
 
@@ -32,14 +44,195 @@ namespace dax {
 namespace cont {
 
 template<>
-struct DeviceAdapterAlgorithm<dax::openmp::cont::DeviceAdapterTagOpenMP>
-    : public dax::thrust::cont::internal::DeviceAdapterAlgorithmThrust<
-          dax::openmp::cont::DeviceAdapterTagOpenMP>
+struct DeviceAdapterAlgorithm<dax::openmp::cont::DeviceAdapterTagOpenMP> :
+    dax::cont::internal::DeviceAdapterAlgorithmGeneral<
+        DeviceAdapterAlgorithm<dax::openmp::cont::DeviceAdapterTagOpenMP>,
+        dax::openmp::cont::DeviceAdapterTagOpenMP>
 {
 private:
-  typedef dax::thrust::cont::internal::DeviceAdapterAlgorithmThrust<
-      dax::openmp::cont::DeviceAdapterTagOpenMP> Superclass;
+  typedef dax::openmp::cont::DeviceAdapterTagOpenMP DeviceAdapterTag;
+
+  // Arrays shorter than this are sorted by a single thread.
+  static const dax::Id SERIAL_SORT_SIZE = 4096;
+
+  // Makes the loops below that use schedule(runtime) follow the schedule
+  // selected with dax::openmp::cont::SetSchedule.
+  DAX_CONT_EXPORT static void ApplySchedule()
+  {
+    omp_sched_t kind = omp_sched_static;
+    switch (dax::openmp::cont::GetScheduleType())
+      {
+      case dax::openmp::cont::SCHEDULE_STATIC:  kind = omp_sched_static; break;
+      case dax::openmp::cont::SCHEDULE_DYNAMIC: kind = omp_sched_dynamic; break;
+      case dax::openmp::cont::SCHEDULE_GUIDED:  kind = omp_sched_guided; break;
+      }
+    omp_set_schedule(kind, dax::openmp::cont::GetScheduleChunkSize());
+  }
+
+  // The scans, compaction and sort split their arrays into one contiguous
+  // block per thread. Each block is visited by its own loop iteration, so
+  // the block decomposition is the same from one parallel loop to the next.
+  DAX_CONT_EXPORT static dax::Id GetNumberOfBlocks(dax::Id numValues)
+  {
+    return std::max(dax::Id(1),
+                    std::min(static_cast<dax::Id>(omp_get_max_threads()),
+                             numValues));
+  }
+
+  DAX_EXEC_CONT_EXPORT static dax::Id GetBlockBegin(dax::Id block,
+                                                    dax::Id numBlocks,
+                                                    dax::Id numValues)
+  {
+    // Avoids computing block*numValues, which can overflow dax::Id.
+    const dax::Id blockSize = numValues / numBlocks;
+    const dax::Id remainder = numValues % numBlocks;
+    return block*blockSize + std::min(block, remainder);
+  }
+
+  template<class InputPortalType, class OutputPortalType, class BinaryFunctor>
+  DAX_CONT_EXPORT static
+  typename boost::remove_reference<typename OutputPortalType::ValueType>::type
+  ScanInclusivePortals(InputPortalType inputPortal,
+                       OutputPortalType outputPortal,
+                       BinaryFunctor binaryOperator)
+  {
+    typedef typename boost::remove_reference<
+        typename OutputPortalType::ValueType>::type ValueType;
+
+    const dax::Id numValues = inputPortal.GetNumberOfValues();
+    if (numValues < 1) { return ValueType(); }
+
+    // Reduce each block, combine the reductions of the preceding blocks into
+    // an offset for each block, then scan each block from its offset. There
+    // is no identity for an arbitrary operator, so every block is non-empty
+    // and the first block starts without an offset.
+    const dax::Id numBlocks = GetNumberOfBlocks(numValues);
+    std::vector<ValueType> blockSums(numBlocks);
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      ValueType sum = inputPortal.Get(begin);
+      for (dax::Id index = begin+1; index < end; index++)
+        {
+        sum = binaryOperator(sum, inputPortal.Get(index));
+        }
+      blockSums[block] = sum;
+      }
+
+    for (dax::Id block = 1; block < numBlocks; block++)
+      {
+      blockSums[block] = binaryOperator(blockSums[block-1], blockSums[block]);
+      }
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      ValueType sum = (block == 0) ? inputPortal.Get(begin)
+                                   : binaryOperator(blockSums[block-1],
+                                                    inputPortal.Get(begin));
+      outputPortal.Set(begin, sum);
+      for (dax::Id index = begin+1; index < end; index++)
+        {
+        sum = binaryOperator(sum, inputPortal.Get(index));
+        outputPortal.Set(index, sum);
+        }
+      }
+
+    return blockSums[numBlocks-1];
+  }
+
+  template<class InputPortalType, class OutputPortalType>
+  DAX_CONT_EXPORT static
+  typename boost::remove_reference<typename OutputPortalType::ValueType>::type
+  ScanExclusivePortals(InputPortalType inputPortal,
+                       OutputPortalType outputPortal)
+  {
+    typedef typename boost::remove_reference<
+        typename OutputPortalType::ValueType>::type ValueType;
+
+    const dax::Id numValues = inputPortal.GetNumberOfValues();
+    if (numValues < 1) { return ValueType(0); }
+
+    const dax::Id numBlocks = GetNumberOfBlocks(numValues);
+    std::vector<ValueType> blockSums(numBlocks);
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      ValueType sum = ValueType(0);
+      for (dax::Id index = begin; index < end; index++)
+        {
+        sum = sum + inputPortal.Get(index);
+        }
+      blockSums[block] = sum;
+      }
+
+    // Turn the block sums into the exclusive offset of each block.
+    ValueType total = ValueType(0);
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const ValueType blockSum = blockSums[block];
+      blockSums[block] = total;
+      total = total + blockSum;
+      }
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      ValueType sum = blockSums[block];
+      for (dax::Id index = begin; index < end; index++)
+        {
+        // Read before writing since the input and output may be the same.
+        const ValueType value = inputPortal.Get(index);
+        outputPortal.Set(index, sum);
+        sum = sum + value;
+        }
+      }
+
+    return total;
+  }
+
+public:
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &output)
+  {
+    return DeviceAdapterAlgorithm::ScanInclusive(input, output, dax::Add());
+  }
+
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &output,
+      BinaryFunctor binaryOperator)
+  {
+    const dax::Id numValues = input.GetNumberOfValues();
+    return ScanInclusivePortals(input.PrepareForInput(),
+                                output.PrepareForOutput(numValues),
+                                binaryOperator);
+  }
+
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static T ScanExclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &output)
+  {
+    const dax::Id numValues = input.GetNumberOfValues();
+    return ScanExclusivePortals(input.PrepareForInput(),
+                                output.PrepareForOutput(numValues));
+  }
 
+private:
   template<class FunctorType>
   class ScheduleKernel
   {
@@ -49,13 +242,14 @@ private:
     {  }
 
     DAX_CONT_EXPORT void SetErrorMessageBuffer(
-        dax::exec::internal::ErrorMessageBuffer &errorMessage)
+        const dax::exec::internal::ErrorMessageBuffer &errorMessage)
     {
       this->ErrorMessage = errorMessage;
       this->Functor.SetErrorMessageBuffer(errorMessage);
     }
 
-    DAX_EXEC_EXPORT void operator()(dax::Id index) const {
+    template<typename IndexType>
+    DAX_EXEC_EXPORT void operator()(IndexType index) const {
       // The OpenMP device adapter causes array classes to be shared between
       // control and execution environment. This means that it is possible for an
       // exception to be thrown even though this is typically not allowed.
@@ -83,26 +277,230 @@ private:
   };
 
 public:
-  // Override the thrust version of Schedule to handle exceptions that can occur
-  // because we are running on a CPU.
   template<class FunctorType>
   DAX_CONT_EXPORT
   static void Schedule(FunctorType functor, dax::Id numInstances)
   {
-     Superclass::Schedule(
-           DeviceAdapterAlgorithm::ScheduleKernel<FunctorType>(functor),
-           numInstances);
+    const dax::Id MESSAGE_SIZE = 1024;
+    char errorString[MESSAGE_SIZE];
+    errorString[0] = '\0';
+    dax::exec::internal::ErrorMessageBuffer
+        errorMessage(errorString, MESSAGE_SIZE);
+
+    ScheduleKernel<FunctorType> kernel(functor);
+    kernel.SetErrorMessageBuffer(errorMessage);
+
+    ApplySchedule();
+#pragma omp parallel for schedule(runtime)
+    for (dax::Id index = 0; index < numInstances; index++)
+      {
+      kernel(index);
+      }
+
+    if (errorMessage.IsErrorRaised())
+      {
+      throw dax::cont::ErrorExecution(errorString);
+      }
   }
 
   template<class FunctorType>
   DAX_CONT_EXPORT
   static void Schedule(FunctorType functor, dax::Id3 rangeMax)
   {
-    //default behavior for the general algorithm is to defer to the default
-    //schedule implementation.
-    Superclass::Schedule(
-           DeviceAdapterAlgorithm::ScheduleKernel<FunctorType>(functor),
-           rangeMax);
+    const dax::Id MESSAGE_SIZE = 1024;
+    char errorString[MESSAGE_SIZE];
+    errorString[0] = '\0';
+    dax::exec::internal::ErrorMessageBuffer
+        errorMessage(errorString, MESSAGE_SIZE);
+
+    ScheduleKernel<FunctorType> kernel(functor);
+    kernel.SetErrorMessageBuffer(errorMessage);
+
+    // Threads are handed whole rows of i, the index with the best cache
+    // coherence, and the index only needs its i updated within a row.
+    ApplySchedule();
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (dax::Id k = 0; k < rangeMax[2]; k++)
+      {
+      for (dax::Id j = 0; j < rangeMax[1]; j++)
+        {
+        dax::exec::internal::IJKIndex index(rangeMax, dax::make_Id3(0, j, k));
+        for (dax::Id i = 0; i < rangeMax[0]; i++)
+          {
+          index.SetI(i);
+          kernel(index);
+          }
+        }
+      }
+
+    if (errorMessage.IsErrorRaised())
+      {
+      throw dax::cont::ErrorExecution(errorString);
+      }
+  }
+
+private:
+  template<typename T, typename U, class CIn, class CStencil, class COut>
+  DAX_CONT_EXPORT static void StreamCompactPortals(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
+      const dax::cont::ArrayHandle<U,CStencil,DeviceAdapterTag>& stencil,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output)
+  {
+    typedef typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>
+        ::PortalConstExecution InputPortalType;
+    typedef typename dax::cont::ArrayHandle<U,CStencil,DeviceAdapterTag>
+        ::PortalConstExecution StencilPortalType;
+    typedef typename dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>
+        ::PortalExecution OutputPortalType;
+
+    const dax::Id numValues = stencil.GetNumberOfValues();
+    const dax::Id numBlocks = GetNumberOfBlocks(numValues);
+    StencilPortalType stencilPortal = stencil.PrepareForInput();
+
+    // Count the values each block keeps and turn the counts into the output
+    // offset of each block.
+    std::vector<dax::Id> blockOffsets(numBlocks+1, 0);
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      dax::Id count = 0;
+      for (dax::Id index = begin; index < end; index++)
+        {
+        if (dax::not_default_constructor<U>()(stencilPortal.Get(index)))
+          {
+          count++;
+          }
+        }
+      blockOffsets[block+1] = count;
+      }
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      blockOffsets[block+1] += blockOffsets[block];
+      }
+
+    InputPortalType inputPortal = input.PrepareForInput();
+    OutputPortalType outputPortal =
+        output.PrepareForOutput(blockOffsets[numBlocks]);
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      const dax::Id begin = GetBlockBegin(block, numBlocks, numValues);
+      const dax::Id end = GetBlockBegin(block+1, numBlocks, numValues);
+      dax::Id outIndex = blockOffsets[block];
+      for (dax::Id index = begin; index < end; index++)
+        {
+        if (dax::not_default_constructor<U>()(stencilPortal.Get(index)))
+          {
+          outputPortal.Set(outIndex, inputPortal.Get(index));
+          outIndex++;
+          }
+        }
+      }
+  }
+
+public:
+  template<typename T, typename U, class CIn, class CStencil, class COut>
+  DAX_CONT_EXPORT static void StreamCompact(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
+      const dax::cont::ArrayHandle<U,CStencil,DeviceAdapterTag>& stencil,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output)
+  {
+    DAX_ASSERT_CONT(input.GetNumberOfValues() == stencil.GetNumberOfValues());
+    StreamCompactPortals(input, stencil, output);
+  }
+
+  template<typename T, class CStencil, class COut>
+  DAX_CONT_EXPORT static void StreamCompact(
+      const dax::cont::ArrayHandle<T,CStencil,DeviceAdapterTag> &stencil,
+      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &output)
+  {
+    StreamCompactPortals(
+          dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                              stencil.GetNumberOfValues(),
+                                              DeviceAdapterTag()),
+          stencil,
+          output);
+  }
+
+private:
+  // Sorts each block in its own thread, then merges neighboring sorted runs
+  // in parallel until one run remains.
+  template<class IteratorType, class Compare>
+  DAX_CONT_EXPORT static void SortIterators(IteratorType begin,
+                                            IteratorType end,
+                                            Compare comp)
+  {
+    const dax::Id numValues = static_cast<dax::Id>(end - begin);
+    const dax::Id numBlocks = GetNumberOfBlocks(numValues);
+    if ((numValues < SERIAL_SORT_SIZE) || (numBlocks < 2))
+      {
+      std::sort(begin, end, comp);
+      return;
+      }
+
+#pragma omp parallel for schedule(static)
+    for (dax::Id block = 0; block < numBlocks; block++)
+      {
+      std::sort(begin + GetBlockBegin(block, numBlocks, numValues),
+                begin + GetBlockBegin(block+1, numBlocks, numValues),
+                comp);
+      }
+
+    // Merge through a buffer since the portal iterators may be proxies that
+    // std::inplace_merge cannot rotate.
+    typedef typename std::iterator_traits<IteratorType>::value_type ValueType;
+    std::vector<ValueType> buffer(numValues);
+
+    for (dax::Id width = 1; width < numBlocks; width *= 2)
+      {
+      const dax::Id numMerges = (numBlocks + 2*width - 1) / (2*width);
+#pragma omp parallel for schedule(static)
+      for (dax::Id merge = 0; merge < numMerges; merge++)
+        {
+        const dax::Id first = merge*2*width;
+        const dax::Id middle = std::min(first + width, numBlocks);
+        const dax::Id last = std::min(first + 2*width, numBlocks);
+        if (middle < last)
+          {
+          const dax::Id firstIndex = GetBlockBegin(first, numBlocks, numValues);
+          const dax::Id middleIndex =
+              GetBlockBegin(middle, numBlocks, numValues);
+          const dax::Id lastIndex = GetBlockBegin(last, numBlocks, numValues);
+          std::merge(begin + firstIndex, begin + middleIndex,
+                     begin + middleIndex, begin + lastIndex,
+                     buffer.begin() + firstIndex,
+                     comp);
+          std::copy(buffer.begin() + firstIndex,
+                    buffer.begin() + lastIndex,
+                    begin + firstIndex);
+          }
+        }
+      }
+  }
+
+public:
+  template<typename T, class Container>
+  DAX_CONT_EXPORT static void Sort(
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &values)
+  {
+    DeviceAdapterAlgorithm::Sort(values, std::less<T>());
+  }
+
+  template<typename T, class Container, class Compare>
+  DAX_CONT_EXPORT static void Sort(
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &values,
+      Compare comp)
+  {
+    typedef typename dax::cont::ArrayHandle<T,Container,DeviceAdapterTag>
+        ::PortalExecution PortalType;
+
+    PortalType arrayPortal = values.PrepareForInPlace();
+    SortIterators(arrayPortal.GetIteratorBegin(),
+                  arrayPortal.GetIteratorEnd(),
+                  comp);
   }
 
   DAX_CONT_EXPORT static void Synchronize()
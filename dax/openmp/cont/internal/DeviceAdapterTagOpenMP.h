@@ -16,8 +16,6 @@
 #ifndef __dax_openmp_cont_internal_DeviceAdapterTagOpenMP_h
 #define __dax_openmp_cont_internal_DeviceAdapterTagOpenMP_h
 
-#include <dax/openmp/cont/internal/SetThrustForOpenMP.h>
-
 namespace dax {
 namespace openmp {
 namespace cont {
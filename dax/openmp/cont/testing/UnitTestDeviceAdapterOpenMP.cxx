@@ -22,6 +22,17 @@
 
 int UnitTestDeviceAdapterOpenMP(int, char *[])
 {
-  return dax::cont::testing::TestingDeviceAdapter
-      <dax::openmp::cont::DeviceAdapterTagOpenMP>::Run();
+  typedef dax::cont::testing::TestingDeviceAdapter
+      <dax::openmp::cont::DeviceAdapterTagOpenMP> Testing;
+
+  int result = Testing::Run();
+
+  // The algorithms must not depend on how loop iterations are handed out.
+  dax::openmp::cont::SetSchedule(dax::openmp::cont::SCHEDULE_DYNAMIC, 64);
+  result += Testing::Run();
+  dax::openmp::cont::SetSchedule(dax::openmp::cont::SCHEDULE_GUIDED);
+  result += Testing::Run();
+  dax::openmp::cont::SetSchedule(dax::openmp::cont::SCHEDULE_STATIC);
+
+  return result;
 }
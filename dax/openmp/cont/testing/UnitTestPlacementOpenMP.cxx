@@ -0,0 +1,98 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2013 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_OPENMP
+
+#include <dax/openmp/cont/DeviceAdapterOpenMP.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 1 << 20;
+
+typedef dax::cont::DeviceAdapterAlgorithm<
+    dax::openmp::cont::DeviceAdapterTagOpenMP> Algorithm;
+typedef dax::cont::ArrayHandle<dax::Id> IdArrayHandleType;
+
+void CheckIndices(const IdArrayHandleType &array)
+{
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Array has wrong size.");
+  std::vector<dax::Id> values(ARRAY_SIZE);
+  array.CopyInto(values.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(values[index] == index, "Array has wrong value.");
+    }
+}
+
+void TestPlacement()
+{
+  DAX_TEST_ASSERT(dax::openmp::cont::GetFirstTouchOutput(),
+                  "First touch should be on by default.");
+
+  // Pinning may be refused, for example inside a restricted container, in
+  // which case everything else must still work.
+  std::cout << "Pinning threads: "
+            << (dax::openmp::cont::PinThreads() ? "done" : "not supported")
+            << std::endl;
+
+  std::cout << "Writing a first touched array." << std::endl;
+  IdArrayHandleType array;
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0), ARRAY_SIZE),
+                  array);
+  CheckIndices(array);
+
+  std::vector<int> nodes = dax::openmp::cont::GetPlacement(array);
+  DAX_TEST_ASSERT(static_cast<int>(nodes.size()) == omp_get_max_threads(),
+                  "Should get a node for each thread.");
+  std::cout << "Nodes of thread blocks:";
+  for (std::size_t block = 0; block < nodes.size(); block++)
+    {
+    DAX_TEST_ASSERT(nodes[block] >= -1, "Bad node.");
+    std::cout << " " << nodes[block];
+    }
+  std::cout << std::endl;
+
+  std::cout << "Moving the array to the nodes of its threads." << std::endl;
+  dax::openmp::cont::SetPlacement(array);
+  CheckIndices(array);
+
+  std::cout << "Writing an array without first touch." << std::endl;
+  dax::openmp::cont::SetFirstTouchOutput(false);
+  IdArrayHandleType array2;
+  Algorithm::Copy(array, array2);
+  CheckIndices(array2);
+  dax::openmp::cont::SetFirstTouchOutput(true);
+
+  std::cout << "Scanning in place over reused memory." << std::endl;
+  std::vector<dax::Id> ones(ARRAY_SIZE, 1);
+  Algorithm::Copy(dax::cont::make_ArrayHandle(ones), array2);
+  Algorithm::ScanExclusive(array2, array2);
+  CheckIndices(array2);
+}
+
+} // anonymous namespace
+
+int UnitTestPlacementOpenMP(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestPlacement);
+}
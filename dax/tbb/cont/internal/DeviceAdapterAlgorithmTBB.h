@@ -28,6 +28,7 @@
 #include <dax/Extent.h>
 #include <dax/cont/arg/Topology.h>
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
 #include <dax/cont/ErrorExecution.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithm.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithmGeneral.h>
@@ -235,6 +236,191 @@ private:
     return body.Sum;
   }
 
+  template<class InputPortalType, class OutputPortalType, class BinaryFunctor>
+  struct ScanInclusiveOperatorBody
+  {
+    typedef typename boost::remove_reference<
+        typename OutputPortalType::ValueType>::type ValueType;
+    // There is no identity value for an arbitrary operator, so track whether
+    // Sum holds anything yet.
+    ValueType Sum;
+    bool HasSum;
+    InputPortalType InputPortal;
+    OutputPortalType OutputPortal;
+    BinaryFunctor BinaryOperator;
+
+    DAX_CONT_EXPORT
+    ScanInclusiveOperatorBody(const InputPortalType &inputPortal,
+                              const OutputPortalType &outputPortal,
+                              BinaryFunctor binaryOperator)
+      : Sum(), HasSum(false),
+        InputPortal(inputPortal),
+        OutputPortal(outputPortal),
+        BinaryOperator(binaryOperator)
+    {  }
+
+    DAX_EXEC_CONT_EXPORT
+    ScanInclusiveOperatorBody(const ScanInclusiveOperatorBody &body,
+                              ::tbb::split)
+      : Sum(), HasSum(false),
+        InputPortal(body.InputPortal),
+        OutputPortal(body.OutputPortal),
+        BinaryOperator(body.BinaryOperator) {  }
+
+    template<class Tag>
+    DAX_EXEC_EXPORT
+    void operator()(const ::tbb::blocked_range<dax::Id> &range, Tag)
+    {
+      typedef typename InputPortalType::IteratorType InIterator;
+      typedef typename OutputPortalType::IteratorType OutIterator;
+
+      ValueType temp = this->Sum;
+      bool hasSum = this->HasSum;
+      InIterator inIter = this->InputPortal.GetIteratorBegin() + range.begin();
+      OutIterator outIter = this->OutputPortal.GetIteratorBegin() + range.begin();
+      for (dax::Id index = range.begin(); index != range.end();
+           ++index, ++inIter, ++outIter)
+        {
+        temp = hasSum ? this->BinaryOperator(temp, *inIter) : *inIter;
+        hasSum = true;
+        if (Tag::is_final_scan()) { *outIter = temp; }
+        }
+      this->Sum = temp;
+      this->HasSum = hasSum;
+    }
+
+    DAX_EXEC_CONT_EXPORT
+    void reverse_join(const ScanInclusiveOperatorBody &left)
+    {
+      if (!left.HasSum) { return; }
+      this->Sum =
+          this->HasSum ? this->BinaryOperator(left.Sum, this->Sum) : left.Sum;
+      this->HasSum = true;
+    }
+
+    DAX_EXEC_CONT_EXPORT
+    void assign(const ScanInclusiveOperatorBody &src)
+    {
+      this->Sum = src.Sum;
+      this->HasSum = src.HasSum;
+    }
+  };
+
+  template<class KeysPortalType,
+           class InputPortalType,
+           class OutputPortalType>
+  struct ScanByKeyBody
+  {
+    typedef typename boost::remove_reference<
+        typename OutputPortalType::ValueType>::type ValueType;
+    ValueType Sum;
+    // True once the range scanned so far contains the start of a segment, in
+    // which case sums from the left no longer apply.
+    bool Restarted;
+    KeysPortalType KeysPortal;
+    InputPortalType InputPortal;
+    OutputPortalType OutputPortal;
+    bool Exclusive;
+
+    DAX_CONT_EXPORT
+    ScanByKeyBody(const KeysPortalType &keysPortal,
+                  const InputPortalType &inputPortal,
+                  const OutputPortalType &outputPortal,
+                  bool exclusive)
+      : Sum(ValueType(0)), Restarted(false),
+        KeysPortal(keysPortal),
+        InputPortal(inputPortal),
+        OutputPortal(outputPortal),
+        Exclusive(exclusive)
+    {  }
+
+    DAX_EXEC_CONT_EXPORT
+    ScanByKeyBody(const ScanByKeyBody &body, ::tbb::split)
+      : Sum(ValueType(0)), Restarted(false),
+        KeysPortal(body.KeysPortal),
+        InputPortal(body.InputPortal),
+        OutputPortal(body.OutputPortal),
+        Exclusive(body.Exclusive) {  }
+
+    template<class Tag>
+    DAX_EXEC_EXPORT
+    void operator()(const ::tbb::blocked_range<dax::Id> &range, Tag)
+    {
+      ValueType temp = this->Sum;
+      bool restarted = this->Restarted;
+      for (dax::Id index = range.begin(); index != range.end(); ++index)
+        {
+        if ((index == 0) ||
+            !(this->KeysPortal.Get(index-1) == this->KeysPortal.Get(index)))
+          {
+          temp = ValueType(0);
+          restarted = true;
+          }
+        // Read first since the input and output may be the same array.
+        const ValueType value = this->InputPortal.Get(index);
+        if (Tag::is_final_scan() && this->Exclusive)
+          {
+          this->OutputPortal.Set(index, temp);
+          }
+        temp = temp + value;
+        if (Tag::is_final_scan() && !this->Exclusive)
+          {
+          this->OutputPortal.Set(index, temp);
+          }
+        }
+      this->Sum = temp;
+      this->Restarted = restarted;
+    }
+
+    DAX_EXEC_CONT_EXPORT
+    void reverse_join(const ScanByKeyBody &left)
+    {
+      if (!this->Restarted)
+        {
+        this->Sum = left.Sum + this->Sum;
+        this->Restarted = left.Restarted;
+        }
+    }
+
+    DAX_EXEC_CONT_EXPORT
+    void assign(const ScanByKeyBody &src)
+    {
+      this->Sum = src.Sum;
+      this->Restarted = src.Restarted;
+    }
+  };
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanByKeyTBB(
+      const dax::cont::ArrayHandle<T,KIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &keys,
+      const dax::cont::ArrayHandle<U,VIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &values,
+      dax::cont::ArrayHandle<U,VOut,dax::tbb::cont::DeviceAdapterTagTBB>
+          &output,
+      bool exclusive)
+  {
+    typedef typename dax::cont::ArrayHandle<
+        T,KIn,dax::tbb::cont::DeviceAdapterTagTBB>::PortalConstExecution
+        KeysPortalType;
+    typedef typename dax::cont::ArrayHandle<
+        U,VIn,dax::tbb::cont::DeviceAdapterTagTBB>::PortalConstExecution
+        InputPortalType;
+    typedef typename dax::cont::ArrayHandle<
+        U,VOut,dax::tbb::cont::DeviceAdapterTagTBB>::PortalExecution
+        OutputPortalType;
+
+    const dax::Id arrayLength = values.GetNumberOfValues();
+    DAX_ASSERT_CONT(keys.GetNumberOfValues() == arrayLength);
+
+    ScanByKeyBody<KeysPortalType,InputPortalType,OutputPortalType>
+        body(keys.PrepareForInput(),
+             values.PrepareForInput(),
+             output.PrepareForOutput(arrayLength),
+             exclusive);
+    ::tbb::parallel_scan( ::tbb::blocked_range<dax::Id>(0, arrayLength), body);
+  }
+
 public:
   template<typename T, class CIn, class COut>
   DAX_CONT_EXPORT static T ScanInclusive(
@@ -260,6 +446,54 @@ public:
           output.PrepareForOutput(input.GetNumberOfValues()));
   }
 
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &input,
+      dax::cont::ArrayHandle<T,COut,dax::tbb::cont::DeviceAdapterTagTBB>
+          &output,
+      BinaryFunctor binaryOperator)
+  {
+    typedef typename dax::cont::ArrayHandle<
+        T,CIn,dax::tbb::cont::DeviceAdapterTagTBB>::PortalConstExecution
+        InputPortalType;
+    typedef typename dax::cont::ArrayHandle<
+        T,COut,dax::tbb::cont::DeviceAdapterTagTBB>::PortalExecution
+        OutputPortalType;
+
+    const dax::Id arrayLength = input.GetNumberOfValues();
+    ScanInclusiveOperatorBody<InputPortalType,OutputPortalType,BinaryFunctor>
+        body(input.PrepareForInput(),
+             output.PrepareForOutput(arrayLength),
+             binaryOperator);
+    ::tbb::parallel_scan( ::tbb::blocked_range<dax::Id>(0, arrayLength), body);
+    return body.Sum;
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanInclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &keys,
+      const dax::cont::ArrayHandle<U,VIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &values,
+      dax::cont::ArrayHandle<U,VOut,dax::tbb::cont::DeviceAdapterTagTBB>
+          &output)
+  {
+    ScanByKeyTBB(keys, values, output, false);
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanExclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &keys,
+      const dax::cont::ArrayHandle<U,VIn,dax::tbb::cont::DeviceAdapterTagTBB>
+          &values,
+      dax::cont::ArrayHandle<U,VOut,dax::tbb::cont::DeviceAdapterTagTBB>
+          &output)
+  {
+    ScanByKeyTBB(keys, values, output, true);
+  }
+
 private:
   template<class FunctorType>
   class ScheduleKernel
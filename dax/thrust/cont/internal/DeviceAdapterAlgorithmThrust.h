@@ -20,6 +20,7 @@
 #include <dax/thrust/cont/internal/MakeThrustIterator.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
 #include <dax/cont/ErrorExecution.h>
 
 #include <dax/Functional.h>
@@ -151,6 +152,47 @@ private:
     return *(IteratorEnd(output) - 1);
   }
 
+  template<class InputPortal, class OutputPortal, class BinaryFunctor>
+  DAX_CONT_EXPORT static
+  typename InputPortal::ValueType ScanInclusivePortal(const InputPortal &input,
+                                                      const OutputPortal &output,
+                                                      BinaryFunctor binaryOp)
+  {
+    ::thrust::inclusive_scan(IteratorBegin(input),
+                             IteratorEnd(input),
+                             IteratorBegin(output),
+                             binaryOp);
+
+    //return the value at the last index in the array, as that is the sum
+    return *(IteratorEnd(output) - 1);
+  }
+
+  template<class KeysPortal, class ValuesPortal, class OutputPortal>
+  DAX_CONT_EXPORT static void ScanInclusiveByKeyPortal(
+      const KeysPortal &keys,
+      const ValuesPortal &values,
+      const OutputPortal &output)
+  {
+    ::thrust::inclusive_scan_by_key(IteratorBegin(keys),
+                                    IteratorEnd(keys),
+                                    IteratorBegin(values),
+                                    IteratorBegin(output));
+  }
+
+  template<class KeysPortal, class ValuesPortal, class OutputPortal>
+  DAX_CONT_EXPORT static void ScanExclusiveByKeyPortal(
+      const KeysPortal &keys,
+      const ValuesPortal &values,
+      const OutputPortal &output)
+  {
+    typedef typename ValuesPortal::ValueType ValueType;
+    ::thrust::exclusive_scan_by_key(IteratorBegin(keys),
+                                    IteratorEnd(keys),
+                                    IteratorBegin(values),
+                                    IteratorBegin(output),
+                                    ValueType(0));
+  }
+
   template<class ValuesPortal>
   DAX_CONT_EXPORT static void SortPortal(const ValuesPortal &values)
   {
@@ -385,6 +427,62 @@ public:
                                output.PrepareForOutput(numberOfValues));
   }
 
+  template<typename T, class CIn, class COut, class BinaryFunctor>
+  DAX_CONT_EXPORT static T ScanInclusive(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output,
+      BinaryFunctor binaryOp)
+  {
+    dax::Id numberOfValues = input.GetNumberOfValues();
+    if (numberOfValues <= 0)
+      {
+      output.PrepareForOutput(0);
+      return T();
+      }
+
+    return ScanInclusivePortal(input.PrepareForInput(),
+                               output.PrepareForOutput(numberOfValues),
+                               binaryOp);
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanInclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output)
+  {
+    dax::Id numberOfValues = values.GetNumberOfValues();
+    DAX_ASSERT_CONT(keys.GetNumberOfValues() == numberOfValues);
+    if (numberOfValues <= 0)
+      {
+      output.PrepareForOutput(0);
+      return;
+      }
+
+    ScanInclusiveByKeyPortal(keys.PrepareForInput(),
+                             values.PrepareForInput(),
+                             output.PrepareForOutput(numberOfValues));
+  }
+
+  template<typename T, typename U, class KIn, class VIn, class VOut>
+  DAX_CONT_EXPORT static void ScanExclusiveByKey(
+      const dax::cont::ArrayHandle<T,KIn,DeviceAdapterTag> &keys,
+      const dax::cont::ArrayHandle<U,VIn,DeviceAdapterTag> &values,
+      dax::cont::ArrayHandle<U,VOut,DeviceAdapterTag> &output)
+  {
+    dax::Id numberOfValues = values.GetNumberOfValues();
+    DAX_ASSERT_CONT(keys.GetNumberOfValues() == numberOfValues);
+    if (numberOfValues <= 0)
+      {
+      output.PrepareForOutput(0);
+      return;
+      }
+
+    ScanExclusiveByKeyPortal(keys.PrepareForInput(),
+                             values.PrepareForInput(),
+                             output.PrepareForOutput(numberOfValues));
+  }
+
 // Because of some funny code conversions in nvcc, kernels for devices have to
 // be public.
 #ifndef DAX_CUDA
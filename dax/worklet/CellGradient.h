@@ -25,9 +25,15 @@
 namespace dax {
 namespace worklet {
 
-class CellGradient : public dax::exec::WorkletMapCell
+/// Computes the gradient of a point field at the center of each cell with
+/// the math precision given by \c PrecisionTagType, either
+/// dax::math::PrecisionTagExact or dax::math::PrecisionTagFast.
+///
+template<class PrecisionTagType>
+class CellGradientWithPrecision : public dax::exec::WorkletMapCell
 {
 public:
+  typedef PrecisionTagType PrecisionTag;
 
   typedef void ControlSignature(Topology, Field(Point), Field(Point), Field(Out));
   typedef _4 ExecutionSignature(_2,_3);
@@ -43,7 +49,57 @@ public:
     return dax::exec::CellDerivative(parametricCellCenter,
                                      coords,
                                      pointField,
-                                     CellTag());
+                                     CellTag(),
+                                     PrecisionTag());
+  }
+};
+
+typedef CellGradientWithPrecision<dax::math::PrecisionTagExact> CellGradient;
+
+/// Computes the per-cell operator that CellGradientCached uses to find the
+/// gradient at the cell center. The operator depends only on the point
+/// coordinates, so for a mesh that does not move it can be computed once and
+/// reused for every new field. The output array holds values of type
+/// dax::exec::CellDerivativeOperator<CellTag>::Type, where CellTag is the
+/// cell type of the grid (for example, 8 dax::Vector3 per hexahedron).
+///
+class CellGradientOperator : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  typename dax::exec::CellDerivativeOperator<CellTag>::Type operator()(
+      const dax::exec::CellField<dax::Vector3,CellTag> &coords) const
+  {
+    return dax::exec::make_CellDerivativeOperator(
+          dax::exec::ParametricCoordinates<CellTag>::Center(),
+          coords,
+          CellTag());
+  }
+};
+
+/// Computes the gradient of a point field at the center of each cell from the
+/// operators produced by CellGradientOperator. The result matches
+/// CellGradient, but each cell costs only one small matrix-vector product.
+///
+class CellGradientCached : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(In), Field(Out));
+  typedef _4 ExecutionSignature(_2,_3);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &pointField,
+      const typename dax::exec::CellDerivativeOperator<CellTag>::Type
+          &gradientOperator) const
+  {
+    return dax::exec::ApplyCellDerivativeOperator(gradientOperator,
+                                                  pointField);
   }
 };
 
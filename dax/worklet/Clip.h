@@ -0,0 +1,273 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __Clip_worklet_
+#define __Clip_worklet_
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+#include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/worklet/internal/ClipTable.h>
+
+namespace dax {
+namespace worklet {
+
+namespace internal{
+namespace clip{
+// -----------------------------------------------------------------------------
+template<typename T, typename U>
+DAX_EXEC_EXPORT
+int GetClassification(const T clipValue, const U& values, int numVertices)
+{
+  int cellClass = 0;
+  for (int vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+    {
+    cellClass |= (values[vertexIndex] > clipValue) << vertexIndex;
+    }
+  return cellClass;
+}
+
+// -----------------------------------------------------------------------------
+template<typename T>
+DAX_EXEC_EXPORT
+int GetSubTetrahedronClassification(const T hexClass, int subTet)
+{
+  return ((hexClass >> HexTetTable[subTet][0]) & 1) << 0 |
+         ((hexClass >> HexTetTable[subTet][1]) & 1) << 1 |
+         ((hexClass >> HexTetTable[subTet][2]) & 1) << 2 |
+         ((hexClass >> HexTetTable[subTet][3]) & 1) << 3;
+}
+}
+}
+
+// -----------------------------------------------------------------------------
+/// Counts the tetrahedra each cell generates when clipped. The result is the
+/// classification array for ClipGenerate. Supports tetrahedra, hexahedra and
+/// voxels.
+///
+class ClipClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_CONT_EXPORT ClipClassify(dax::Scalar clipValue)
+    : ClipValue(clipValue) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &values) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    return this->GetNumTets(
+          values,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Scalar ClipValue;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id GetNumTets(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                     dax::CellTagTetrahedron) const
+  {
+    const int tetClass =
+        internal::clip::GetClassification(this->ClipValue, values, 4);
+    return dax::worklet::internal::clip::TetNumTets[tetClass];
+  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id GetNumTets(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                     dax::CellTagHexahedron) const
+  {
+    const int hexClass =
+        internal::clip::GetClassification(this->ClipValue, values, 8);
+    return dax::worklet::internal::clip::HexNumTets[hexClass];
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Generates the tetrahedra of the part of each cell where the point field is
+/// greater than the clip value. Hexahedra and voxels are split into six
+/// tetrahedra before clipping.
+///
+/// Points on cut edges are always interpolated from the vertex with the
+/// smaller point id, and points that land on a vertex are emitted as that
+/// vertex. That way every cell sharing an edge or vertex produces the same
+/// interpolation key, and the edge-keyed point merge of
+/// dax::cont::GenerateInterpolatedCells shares them just as it does for
+/// marching cubes.
+///
+class ClipGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(Topology, Geometry(Out), Field(Point,In));
+  typedef void ExecutionSignature(Vertices(_1), _2, _3, VisitIndex);
+
+  DAX_CONT_EXPORT ClipGenerate(dax::Scalar clipValue)
+    : ClipValue(clipValue){ }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildTetrahedron(
+          verts,
+          outCell,
+          values,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Scalar ClipValue;
+
+  typedef dax::Tuple<dax::Id,4> TetIdsType;
+  typedef dax::Tuple<dax::Scalar,4> TetValuesType;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void BuildTetrahedron(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagTetrahedron) const
+  {
+    const int tetClass =
+        internal::clip::GetClassification(this->ClipValue, values, 4);
+
+    TetIdsType ids;
+    TetValuesType tetValues;
+    for (int vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+      {
+      ids[vertexIndex] = verts[vertexIndex];
+      tetValues[vertexIndex] = values[vertexIndex];
+      }
+    this->ClipTetrahedron(ids, tetValues, tetClass, inputCellVisitIndex, outCell);
+  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void BuildTetrahedron(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagHexahedron) const
+  {
+    using dax::worklet::internal::clip::HexTetTable;
+    using dax::worklet::internal::clip::TetNumTets;
+
+    const int hexClass =
+        internal::clip::GetClassification(this->ClipValue, values, 8);
+
+    // Find the sub-tetrahedron that generates the tetrahedron we are visiting.
+    dax::Id visitIndex = inputCellVisitIndex;
+    for (int subTet = 0; subTet < 6; ++subTet)
+      {
+      const int tetClass =
+          internal::clip::GetSubTetrahedronClassification(hexClass, subTet);
+      const dax::Id numTets = TetNumTets[tetClass];
+      if (visitIndex < numTets)
+        {
+        TetIdsType ids;
+        TetValuesType tetValues;
+        for (int vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+          {
+          ids[vertexIndex] = verts[HexTetTable[subTet][vertexIndex]];
+          tetValues[vertexIndex] = values[HexTetTable[subTet][vertexIndex]];
+          }
+        this->ClipTetrahedron(ids, tetValues, tetClass, visitIndex, outCell);
+        return;
+        }
+      visitIndex -= numTets;
+      }
+  }
+
+  DAX_EXEC_EXPORT void ClipTetrahedron(
+      const TetIdsType &ids,
+      const TetValuesType &values,
+      int tetClass,
+      dax::Id visitIndex,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell) const
+  {
+    using dax::worklet::internal::clip::TetEdges;
+    using dax::worklet::internal::clip::TetTable;
+
+    for (dax::Id outVertIndex = 0;
+         outVertIndex < outCell.NUM_VERTICES;
+         ++outVertIndex)
+      {
+      const unsigned char pointCode =
+          TetTable[tetClass][(visitIndex*4)+outVertIndex];
+      if (pointCode < 4)
+        {
+        outCell.SetInterpolationPoint(outVertIndex,
+                                      ids[pointCode],
+                                      ids[pointCode],
+                                      0);
+        continue;
+        }
+
+      int vertA = TetEdges[pointCode-4][0];
+      int vertB = TetEdges[pointCode-4][1];
+      if (ids[vertB] < ids[vertA])
+        {
+        vertA = TetEdges[pointCode-4][1];
+        vertB = TetEdges[pointCode-4][0];
+        }
+
+      // Find the weight for linear interpolation
+      const dax::Scalar weight = (this->ClipValue - values[vertA]) /
+                                 (values[vertB] - values[vertA]);
+
+      if (weight <= 0)
+        {
+        outCell.SetInterpolationPoint(outVertIndex, ids[vertA], ids[vertA], 0);
+        }
+      else if (weight >= 1)
+        {
+        outCell.SetInterpolationPoint(outVertIndex, ids[vertB], ids[vertB], 0);
+        }
+      else
+        {
+        outCell.SetInterpolationPoint(outVertIndex,
+                                      ids[vertA],
+                                      ids[vertB],
+                                      weight);
+        }
+      }
+  }
+};
+}
+} //dax::worklet
+
+#endif
@@ -16,16 +16,24 @@
 #ifndef __Magnitude_worklet_
 #define __Magnitude_worklet_
 
-#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
 
+#include <dax/math/PrecisionPolicy.h>
 #include <dax/math/VectorAnalysis.h>
 
 namespace dax {
 namespace worklet {
 
-class Magnitude : public dax::exec::WorkletMapField
+/// Computes the magnitude of each vector with the math precision given by
+/// \c PrecisionTagType, either dax::math::PrecisionTagExact or
+/// dax::math::PrecisionTagFast.
+///
+template<class PrecisionTagType>
+class MagnitudeWithPrecision : public dax::exec::WorkletMapFieldPacket<8>
 {
 public:
+  typedef PrecisionTagType PrecisionTag;
+
   typedef void ControlSignature(Field(In), Field(Out));
   typedef void ExecutionSignature(_1,_2);
 
@@ -33,10 +41,23 @@ public:
   void operator()(const dax::Vector3 &inValue,
                   dax::Scalar &outValue) const
   {
-    outValue = dax::math::Magnitude(inValue);
+    outValue = dax::math::Magnitude(inValue, PrecisionTag());
+  }
+
+  template<int Width>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Tuple<dax::Vector3,Width> &inValues,
+                  dax::Tuple<dax::Scalar,Width> &outValues) const
+  {
+    for (int lane = 0; lane < Width; lane++)
+      {
+      outValues[lane] = dax::math::Magnitude(inValues[lane], PrecisionTag());
+      }
   }
 };
 
+typedef MagnitudeWithPrecision<dax::math::PrecisionTagExact> Magnitude;
+
 }
 }
 
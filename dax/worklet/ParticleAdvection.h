@@ -0,0 +1,100 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __ParticleAdvection_worklet_
+#define __ParticleAdvection_worklet_
+
+#include <dax/exec/WorkletMapField.h>
+
+namespace dax {
+namespace worklet {
+
+/// Advances particles through a vector field with a fixed number of fourth
+/// order Runge-Kutta steps. Each particle is a separate work item.
+///
+/// The arguments are the current particle positions, the original index of
+/// each particle, a field evaluator execution object (such as
+/// dax::exec::FieldEvaluatorUniformGrid), a result execution object
+/// (dax::exec::ParticleAdvectionResult), and outputs for the new positions and
+/// a status that is 1 if the particle is still inside the field and 0 if it
+/// left. A particle whose next step would sample outside the field stops at
+/// its last position. dax::cont::ParticleAdvection drives this worklet.
+///
+class ParticleAdvectionRK4 : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), Field(In), ExecObject(),
+                                ExecObject(), Field(Out), Field(Out));
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6);
+
+  DAX_CONT_EXPORT
+  ParticleAdvectionRK4(dax::Scalar stepSize, dax::Id numberOfSteps)
+    : StepSize(stepSize), NumberOfSteps(numberOfSteps) {  }
+
+  template<class EvaluatorType, class ResultType>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Vector3 &inPoint,
+                  dax::Id particleIndex,
+                  const EvaluatorType &field,
+                  const ResultType &result,
+                  dax::Vector3 &outPoint,
+                  dax::Id &status) const
+  {
+    const dax::Scalar h = this->StepSize;
+    const dax::Scalar halfH = dax::Scalar(0.5)*h;
+    const dax::Scalar sixthH = h/dax::Scalar(6);
+
+    result.BeginParticle(particleIndex, inPoint);
+
+    dax::Vector3 point = inPoint;
+    dax::Vector3 k1, k2, k3, k4;
+    bool inside = field.Evaluate(point, k1);
+    dax::Id step = 0;
+    while (inside && (step < this->NumberOfSteps))
+      {
+      // Every sample has to be inside the field for the step to be valid.
+      // The velocity at the new point is the first sample of the next step,
+      // so we evaluate it here to decide whether to accept the step.
+      dax::Vector3 nextPoint;
+      inside = field.Evaluate(point + halfH*k1, k2)
+          && field.Evaluate(point + halfH*k2, k3)
+          && field.Evaluate(point + h*k3, k4);
+      if (inside)
+        {
+        nextPoint = point + sixthH*(k1 + dax::Scalar(2)*(k2 + k3) + k4);
+        inside = field.Evaluate(nextPoint, k1);
+        }
+      if (inside)
+        {
+        point = nextPoint;
+        step++;
+        result.AddStep(particleIndex, step, point);
+        }
+      }
+
+    result.EndParticle(particleIndex, step, point);
+    outPoint = point;
+    status = inside ? 1 : 0;
+  }
+
+private:
+  dax::Scalar StepSize;
+  dax::Id NumberOfSteps;
+};
+
+}
+} // namespace dax::worklet
+
+#endif //__ParticleAdvection_worklet_
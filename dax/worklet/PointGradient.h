@@ -0,0 +1,167 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __PointGradient_worklet_
+#define __PointGradient_worklet_
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellMeasure.h>
+#include <dax/exec/Derivative.h>
+#include <dax/exec/ParametricCoordinates.h>
+#include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/math/VectorAnalysis.h>
+
+namespace dax {
+namespace worklet {
+
+/// Computes the gradient of a point field at each point of a uniform grid.
+/// The first argument is the point index (usually an ArrayHandleCounting) and
+/// the second a dax::exec::PointGradientUniformGrid execution object.
+/// dax::cont::PointGradient drives this worklet.
+///
+class PointGradientUniform : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), ExecObject(), Field(Out));
+  typedef _3 ExecutionSignature(_1, _2);
+
+  template<class GradientType>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(dax::Id pointIndex,
+                          const GradientType &gradient) const
+  {
+    return gradient.GetGradient(pointIndex);
+  }
+};
+
+/// Computes the gradient of a point field at the center of each cell
+/// multiplied by the measure (volume, area or length) of the cell, and the
+/// measure itself. Summing both over the cells around a point and dividing
+/// gives the measure-weighted average gradient at the point.
+///
+class PointGradientCellContribution : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Point),
+                                Field(Out), Field(Out));
+  typedef void ExecutionSignature(_2, _3, _4, _5);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::exec::CellField<dax::Vector3,CellTag> &coords,
+                  const dax::exec::CellField<dax::Scalar,CellTag> &pointField,
+                  dax::Vector3 &weightedGradient,
+                  dax::Scalar &weight) const
+  {
+    weight = dax::exec::CellMeasure(coords, CellTag());
+    weightedGradient = weight * dax::exec::CellDerivative(
+          dax::exec::ParametricCoordinates<CellTag>::Center(),
+          coords,
+          pointField,
+          CellTag());
+  }
+};
+
+/// Divides the summed contributions of PointGradientCellContribution around
+/// each point. The execution objects are dax::exec::PointIncidentCellSum
+/// over the weighted gradients and over the weights.
+///
+class PointGradientAverage : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), ExecObject(), ExecObject(),
+                                Field(Out));
+  typedef _4 ExecutionSignature(_1, _2, _3);
+
+  template<class GradientSumType, class WeightSumType>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(dax::Id pointIndex,
+                          const GradientSumType &weightedGradients,
+                          const WeightSumType &weights) const
+  {
+    const dax::Scalar totalWeight = weights.Sum(pointIndex);
+    if (totalWeight > 0)
+      {
+      return weightedGradients.Sum(pointIndex) * (1/totalWeight);
+      }
+    else
+      {
+      return dax::make_Vector3(0, 0, 0);
+      }
+  }
+};
+
+/// Computes the normal of each polygon scaled by twice its area. Summing
+/// these over the polygons around a point gives the area-weighted normal
+/// direction at that point.
+///
+class PointNormalCellContribution : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagTriangle> &coords)
+      const
+  {
+    return dax::math::TriangleNormal(coords[0], coords[1], coords[2]);
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagQuadrilateral>
+          &coords) const
+  {
+    return dax::math::Cross(coords[2] - coords[0], coords[3] - coords[1]);
+  }
+};
+
+/// Normalizes the summed contributions of PointNormalCellContribution around
+/// each point. The execution object is a dax::exec::PointIncidentCellSum
+/// over the contributions. Points with no well defined normal get a zero
+/// vector.
+///
+class PointNormalAverage : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), ExecObject(), Field(Out));
+  typedef _3 ExecutionSignature(_1, _2);
+
+  template<class NormalSumType>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(dax::Id pointIndex,
+                          const NormalSumType &normals) const
+  {
+    const dax::Vector3 normal = normals.Sum(pointIndex);
+    const dax::Scalar magnitude = dax::math::Magnitude(normal);
+    if (magnitude > 0)
+      {
+      return normal * (1/magnitude);
+      }
+    else
+      {
+      return dax::make_Vector3(0, 0, 0);
+      }
+  }
+};
+
+}
+} // namespace dax::worklet
+
+#endif //__PointGradient_worklet_
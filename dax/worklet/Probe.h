@@ -0,0 +1,90 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __Probe_worklet_
+#define __Probe_worklet_
+
+#include <dax/exec/WorkletMapField.h>
+
+namespace dax {
+namespace worklet {
+
+/// Finds the cell of a source grid containing each input point. The second
+/// argument is a locator execution object, typically from
+/// dax::cont::CellLocatorUniformBins::PrepareForInput. Produces the containing
+/// cell index (-1 if none), the parametric coordinates in that cell, and a
+/// valid mask that is 1 for points found in a cell and 0 otherwise.
+///
+/// Resampling onto a uniform grid is done by invoking this worklet on the
+/// uniform grid's point coordinates followed by ProbeInterpolate on each
+/// field of the source.
+///
+class ProbeLocate : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), ExecObject(),
+                                Field(Out), Field(Out), Field(Out));
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5);
+
+  template<class LocatorType>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Vector3 &point,
+                  const LocatorType &locator,
+                  dax::Id &cellIndex,
+                  dax::Vector3 &pcoords,
+                  dax::Id &valid) const
+  {
+    cellIndex = locator.FindCell(point, pcoords);
+    valid = (cellIndex >= 0) ? 1 : 0;
+    if (!valid)
+      {
+      pcoords = dax::Vector3(dax::Scalar(0));
+      }
+  }
+};
+
+/// Interpolates a source point field at the cells and parametric coordinates
+/// found by ProbeLocate. The third argument is an execution object from
+/// dax::cont::CellLocatorUniformBins::PrepareFieldForInput. Points that were
+/// not located are given a value of zero.
+///
+class ProbeInterpolate : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), Field(In), ExecObject(), Field(Out));
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  template<class FieldType, typename ValueType>
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex,
+                  const dax::Vector3 &pcoords,
+                  const FieldType &field,
+                  ValueType &value) const
+  {
+    if (cellIndex >= 0)
+      {
+      value = field.GetValue(cellIndex, pcoords);
+      }
+    else
+      {
+      value = ValueType(dax::Scalar(0));
+      }
+  }
+};
+
+}
+} // namespace dax::worklet
+
+#endif //__Probe_worklet_
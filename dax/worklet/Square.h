@@ -16,18 +16,20 @@
 #ifndef __Square_worklet_
 #define __Square_worklet_
 
-#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/WorkletMapFieldPacket.h>
 
 namespace dax {
 namespace worklet {
 
-class Square : public dax::exec::WorkletMapField
+class Square : public dax::exec::WorkletMapFieldPacket<8>
 {
 public:
   typedef void ControlSignature(Field(In), Field(Out));
   typedef _2 ExecutionSignature(_1);
 
 
+  // ValueType is also a dax::Tuple packet of 8 values, which the
+  // elementwise Tuple operators handle directly.
   template<class ValueType>
   DAX_EXEC_EXPORT
   ValueType operator()(const ValueType &inValue) const
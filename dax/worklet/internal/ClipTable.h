@@ -0,0 +1,103 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#ifndef __dax_worklet_internal_ClipTable_h
+#define __dax_worklet_internal_ClipTable_h
+
+#include <dax/internal/ExportMacros.h>
+
+namespace dax {
+namespace worklet{
+namespace internal{
+namespace clip{
+
+// Cases are indexed by a bit mask of the vertices whose value is greater than
+// the clip value (bit i set for vertex i), the same way as the marching cubes
+// tables.
+//
+// Output tetrahedra are described with point codes. Codes 0-3 are the
+// vertices of the input tetrahedron. Codes 4-9 are the points interpolated on
+// the edges listed in TetEdges. Every output tetrahedron has the same
+// orientation as the input tetrahedron.
+
+// ------------------------------------------------------------------- tetEdges
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetEdges[6][2] =
+{ {0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3} };
+
+// -------------------------------------------------------------------- numTets
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetNumTets[16] =
+{ 0, 1, 1, 3, 1, 3, 3, 3, 1, 3, 3, 3, 3, 3, 3, 1 };
+
+// -------------------------------------------------------------------- tetTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetTable[16][12] =
+{
+   {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 4, 5, 6, 255, 255, 255, 255, 255, 255, 255, 255},
+   {1, 7, 4, 8, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 5, 6, 8, 0, 5, 8, 7, 0, 7, 8, 1},
+   {2, 5, 7, 9, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 6, 4, 9, 0, 9, 4, 7, 0, 9, 7, 2},
+   {1, 4, 8, 9, 1, 4, 9, 5, 1, 5, 9, 2},
+   {0, 1, 2, 9, 0, 1, 9, 8, 0, 8, 9, 6},
+   {3, 8, 6, 9, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 4, 5, 9, 0, 4, 9, 8, 0, 8, 9, 3},
+   {1, 7, 4, 9, 1, 9, 4, 6, 1, 9, 6, 3},
+   {0, 3, 1, 9, 0, 9, 1, 7, 0, 9, 7, 5},
+   {2, 5, 7, 8, 2, 5, 8, 6, 2, 6, 8, 3},
+   {0, 2, 3, 8, 0, 2, 8, 7, 0, 7, 8, 4},
+   {1, 3, 2, 6, 1, 6, 2, 5, 1, 6, 5, 4},
+   {0, 1, 2, 3, 255, 255, 255, 255, 255, 255, 255, 255}
+};
+
+// ---------------------------------------------------------------- hexTetTable
+// A hexahedron (or voxel) is split into six tetrahedra around the diagonal
+// from vertex 0 to vertex 6. Every face diagonal of this split goes through
+// the vertex closer to 0 along that face, so neighboring cells of a structured
+// grid split their shared faces the same way.
+DAX_EXEC_CONSTANT_EXPORT const unsigned char HexTetTable[6][4] =
+{
+   {0, 1, 2, 6},
+   {0, 2, 3, 6},
+   {0, 3, 7, 6},
+   {0, 7, 4, 6},
+   {0, 4, 5, 6},
+   {0, 5, 1, 6}
+};
+
+// ----------------------------------------------------------------- hexNumTets
+// Total number of tetrahedra generated by the six tetrahedra of HexTetTable
+// for each hexahedron case.
+DAX_EXEC_CONSTANT_EXPORT const unsigned char HexNumTets[256] =
+{ 0, 6, 2, 10, 2, 10, 5, 12, 2, 10, 4, 14, 5, 12, 8, 14,
+  2, 10, 4, 14, 4, 14, 7, 16, 4, 14, 6, 18, 7, 16, 10, 18,
+  2, 10, 5, 12, 4, 14, 8, 14, 4, 14, 7, 16, 7, 16, 11, 16,
+  5, 12, 8, 14, 7, 16, 11, 16, 7, 16, 10, 18, 10, 18, 14, 18,
+  6, 18, 10, 18, 10, 18, 12, 16, 10, 18, 14, 18, 12, 16, 14, 14,
+  10, 18, 14, 18, 14, 18, 16, 16, 14, 18, 18, 18, 16, 16, 18, 14,
+  10, 18, 12, 16, 14, 18, 14, 14, 14, 18, 16, 16, 16, 16, 16, 12,
+  12, 16, 14, 14, 16, 16, 16, 12, 16, 16, 18, 14, 18, 14, 18, 10,
+  2, 10, 4, 14, 4, 14, 7, 16, 5, 12, 7, 16, 8, 14, 11, 16,
+  5, 12, 7, 16, 7, 16, 10, 18, 8, 14, 10, 18, 11, 16, 14, 18,
+  4, 14, 7, 16, 6, 18, 10, 18, 7, 16, 10, 18, 10, 18, 14, 18,
+  8, 14, 11, 16, 10, 18, 14, 18, 11, 16, 14, 18, 14, 18, 18, 18,
+  10, 18, 14, 18, 14, 18, 16, 16, 12, 16, 16, 16, 14, 14, 16, 12,
+  12, 16, 16, 16, 16, 16, 18, 14, 14, 14, 18, 14, 16, 12, 18, 10,
+  14, 18, 16, 16, 18, 18, 18, 14, 16, 16, 18, 14, 18, 14, 18, 10,
+  14, 14, 16, 12, 18, 14, 18, 10, 16, 12, 18, 10, 18, 10, 18, 6 };
+
+}}}} // dax::worklet::internal::clip
+
+#endif
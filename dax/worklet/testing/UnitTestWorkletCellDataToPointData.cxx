@@ -130,6 +130,7 @@ struct TestCellDataToPointDataWorklet
     dax::cont::ReduceKeysValues<
       dax::worklet::CellDataToPointDataReduceKeys,
       dax::cont::ArrayHandle<dax::Id> > reduceKeys(keyHandle, CD2PD);
+    reduceKeys.SetKeyRange(grid->GetNumberOfPoints());
 
     scheduler.Invoke(reduceKeys, valueHandle, resultHandle);
 
@@ -138,6 +139,19 @@ struct TestCellDataToPointDataWorklet
     resultHandle.CopyInto(pointData.begin());
 
     verifyPointData(grid, field, pointData);
+
+    std::cout << "Reducing again with the same reduction map" << std::endl;
+    dax::cont::ReduceKeysValues<
+      dax::worklet::CellDataToPointDataReduceKeys,
+      dax::cont::ArrayHandle<dax::Id> >
+        reuseKeys(reduceKeys.GetReductionMap(), CD2PD);
+    dax::cont::ArrayHandle<dax::Scalar> reuseResultHandle;
+    scheduler.Invoke(reuseKeys, valueHandle, reuseResultHandle);
+
+    std::vector<dax::Scalar> reusePointData(
+          reuseResultHandle.GetNumberOfValues());
+    reuseResultHandle.CopyInto(reusePointData.begin());
+    verifyPointData(grid, field, reusePointData);
   }
 };
 
@@ -75,6 +75,7 @@ void verifyGradient(
 }
 
 //-----------------------------------------------------------------------------
+template<class WorkletType>
 struct TestCellGradientWorklet
 {
   //----------------------------------------------------------------------------
@@ -101,7 +102,7 @@ struct TestCellGradientWorklet
 
     std::cout << "Running CellGradient worklet" << std::endl;
     dax::cont::Scheduler< > scheduler;
-    scheduler.Invoke(dax::worklet::CellGradient(),
+    scheduler.Invoke(WorkletType(),
                     grid.GetRealGrid(),
                     grid->GetPointCoordinates(),
                     fieldHandle,
@@ -121,10 +122,89 @@ struct TestCellGradientWorklet
     }
 };
 
+//-----------------------------------------------------------------------------
+struct TestCellGradientCachedWorklet
+{
+  //----------------------------------------------------------------------------
+  template<typename GridType>
+  DAX_CONT_EXPORT
+  void operator()(const GridType&) const
+    {
+    typedef typename GridType::CellTag CellTag;
+    typedef typename dax::exec::CellDerivativeOperator<CellTag>::Type
+        OperatorType;
+
+    dax::cont::testing::TestGrid<GridType> grid(DIM);
+
+    dax::Vector3 trueGradient = dax::make_Vector3(1.0, 1.0, 1.0);
+
+    std::vector<dax::Scalar> field(grid->GetNumberOfPoints());
+    for (dax::Id pointIndex = 0;
+         pointIndex < grid->GetNumberOfPoints();
+         pointIndex++)
+      {
+      field[pointIndex]
+          = dax::dot(grid->ComputePointCoordinates(pointIndex), trueGradient);
+      }
+    dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+        dax::cont::make_ArrayHandle(field);
+
+    dax::cont::ArrayHandle<OperatorType> operatorHandle;
+    dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+    dax::cont::ArrayHandle<dax::Vector3> uncachedGradientHandle;
+
+    std::cout << "Running CellGradientOperator worklet" << std::endl;
+    dax::cont::Scheduler< > scheduler;
+    scheduler.Invoke(dax::worklet::CellGradientOperator(),
+                     grid.GetRealGrid(),
+                     grid->GetPointCoordinates(),
+                     operatorHandle);
+
+    std::cout << "Running CellGradientCached worklet" << std::endl;
+    scheduler.Invoke(dax::worklet::CellGradientCached(),
+                     grid.GetRealGrid(),
+                     fieldHandle,
+                     operatorHandle,
+                     gradientHandle);
+    scheduler.Invoke(dax::worklet::CellGradient(),
+                     grid.GetRealGrid(),
+                     grid->GetPointCoordinates(),
+                     fieldHandle,
+                     uncachedGradientHandle);
+
+    std::cout << "Checking result" << std::endl;
+    std::vector<dax::Vector3> gradient(grid->GetNumberOfCells());
+    gradientHandle.CopyInto(gradient.begin());
+    std::vector<dax::Vector3> uncachedGradient(grid->GetNumberOfCells());
+    uncachedGradientHandle.CopyInto(uncachedGradient.begin());
+    for (dax::Id cellIndex = 0;
+         cellIndex < grid->GetNumberOfCells();
+         cellIndex++)
+      {
+      verifyGradient(grid.GetCellVertexCoordinates(cellIndex),
+                     gradient[cellIndex],
+                     trueGradient);
+      DAX_TEST_ASSERT(test_equal(gradient[cellIndex],
+                                 uncachedGradient[cellIndex]),
+                      "Cached gradient does not match CellGradient.");
+      }
+    }
+};
+
 //-----------------------------------------------------------------------------
 void TestCellGradient()
   {
-  dax::cont::testing::GridTesting::TryAllGridTypes( TestCellGradientWorklet() );
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestCellGradientWorklet<dax::worklet::CellGradient>() );
+
+  std::cout << "Fast precision" << std::endl;
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestCellGradientWorklet<dax::worklet::CellGradientWithPrecision<
+          dax::math::PrecisionTagFast> >() );
+
+  std::cout << "Cached operator" << std::endl;
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestCellGradientCachedWorklet() );
   }
 
 } // Anonymous namespace
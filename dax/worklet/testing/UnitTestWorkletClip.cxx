@@ -0,0 +1,244 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/Clip.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/GenerateInterpolatedCells.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/math/Sign.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <vector>
+
+namespace {
+const dax::Id DIM = 6;
+const dax::Scalar CLIPVALUE = 4;
+
+//-----------------------------------------------------------------------------
+struct CellCheckClip {
+  template <class Tag, class Functor>
+  void operator()(Tag t, Functor function) const {
+    this->DoClip(typename dax::CellTraits<Tag>::CanonicalCellTag(), t, function);
+  }
+private:
+  template <class Tag, typename T, class Functor>
+  void DoClip(Tag, T, const Functor&) const {  }
+  template <class Tag, class Functor>
+  void DoClip(dax::CellTagHexahedron, Tag t, Functor function) const {
+    function(t);
+  }
+  template <class Tag, class Functor>
+  void DoClip(dax::CellTagTetrahedron, Tag t, Functor function) const {
+    function(t);
+  }
+};
+
+//-----------------------------------------------------------------------------
+struct TestClipWorklet
+{
+  typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+  typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+
+  typedef dax::CellTagTetrahedron CellType;
+
+  typedef dax::cont::UnstructuredGrid<
+      CellType,ArrayContainer,ArrayContainer,DeviceAdapter>
+      UnstructuredGridType;
+
+  typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+      FieldHandleType;
+
+  //----------------------------------------------------------------------------
+  template<class InputGridType>
+  DAX_CONT_EXPORT
+  static void RunClip(const InputGridType &inGrid,
+                      FieldHandleType fieldHandle,
+                      dax::Scalar clipValue,
+                      bool removeDuplicatePoints,
+                      UnstructuredGridType &outGrid)
+  {
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainer, DeviceAdapter>
+      ClassifyResultType;
+    typedef dax::cont::GenerateInterpolatedCells<
+      dax::worklet::ClipGenerate,ClassifyResultType> GenerateIC;
+
+    dax::cont::Scheduler<DeviceAdapter> scheduler;
+
+    ClassifyResultType classification;
+    scheduler.Invoke(dax::worklet::ClipClassify(clipValue),
+                     inGrid,
+                     fieldHandle,
+                     classification);
+
+    GenerateIC generate(classification,
+                        dax::worklet::ClipGenerate(clipValue));
+    generate.SetRemoveDuplicatePoints(removeDuplicatePoints);
+    scheduler.Invoke(generate, inGrid, outGrid, fieldHandle);
+  }
+
+  //----------------------------------------------------------------------------
+  static dax::Scalar TetVolume(const dax::Vector3 &p0,
+                               const dax::Vector3 &p1,
+                               const dax::Vector3 &p2,
+                               const dax::Vector3 &p3)
+  {
+    return dax::dot(p1-p0, dax::math::Cross(p2-p0, p3-p0))/6;
+  }
+
+  //----------------------------------------------------------------------------
+  // Returns the total volume of the grid and checks that all the points
+  // satisfy the clip. The test tetrahedra do not all have the same
+  // orientation, so we add up the magnitude of each cell volume.
+  static dax::Scalar CheckOutput(const UnstructuredGridType &outGrid,
+                                 const dax::Vector3 &gradient,
+                                 dax::Scalar clipValue)
+  {
+    std::vector<dax::Id> connections(
+          outGrid.GetCellConnections().GetNumberOfValues());
+    outGrid.GetCellConnections().CopyInto(connections.begin());
+    std::vector<dax::Vector3> points(outGrid.GetNumberOfPoints());
+    outGrid.GetPointCoordinates().CopyInto(points.begin());
+
+    for (std::size_t pointIndex = 0; pointIndex < points.size(); pointIndex++)
+      {
+      DAX_TEST_ASSERT(dax::dot(points[pointIndex], gradient) >= clipValue-0.0001,
+                      "Output point is on the wrong side of the clip.");
+      }
+
+    dax::Scalar volume = 0;
+    for (std::size_t cellIndex = 0;
+         cellIndex < connections.size()/4;
+         cellIndex++)
+      {
+      volume += dax::math::Abs(TetVolume(points[connections[4*cellIndex+0]],
+                                         points[connections[4*cellIndex+1]],
+                                         points[connections[4*cellIndex+2]],
+                                         points[connections[4*cellIndex+3]]));
+      }
+    return volume;
+  }
+
+  //----------------------------------------------------------------------------
+  template<class InputGridType>
+  DAX_CONT_EXPORT
+  void operator()(const InputGridType&) const
+    {
+    dax::cont::testing::TestGrid<InputGridType,ArrayContainer,DeviceAdapter>
+        inGrid(DIM);
+
+    const dax::Vector3 gradient = dax::make_Vector3(1.0, 1.0, 1.0);
+    dax::Id numPoints = inGrid->GetNumberOfPoints();
+    std::vector<dax::Scalar> field(numPoints);
+    std::vector<dax::Scalar> negatedField(numPoints);
+    for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+      {
+      dax::Vector3 coordinates = inGrid.GetPointCoordinates(pointIndex);
+      field[pointIndex] = dax::dot(coordinates, gradient);
+      negatedField[pointIndex] = -field[pointIndex];
+      }
+    FieldHandleType fieldHandle = dax::cont::make_ArrayHandle(field,
+                                                              ArrayContainer(),
+                                                              DeviceAdapter());
+    FieldHandleType negatedFieldHandle =
+        dax::cont::make_ArrayHandle(negatedField,
+                                    ArrayContainer(),
+                                    DeviceAdapter());
+
+    try
+      {
+      std::cout << "Clipping below every value" << std::endl;
+      UnstructuredGridType allGrid;
+      RunClip(inGrid.GetRealGrid(), fieldHandle, -1, true, allGrid);
+      const dax::Scalar totalVolume = CheckOutput(allGrid, gradient, -1);
+      DAX_TEST_ASSERT(allGrid.GetNumberOfPoints() == numPoints,
+                      "Unclipped grid should keep the input points.");
+
+      std::cout << "Clipping without merging points" << std::endl;
+      UnstructuredGridType unmergedGrid;
+      RunClip(inGrid.GetRealGrid(), fieldHandle, CLIPVALUE, false, unmergedGrid);
+      DAX_TEST_ASSERT(unmergedGrid.GetNumberOfCells() > 0, "Nothing clipped.");
+      DAX_TEST_ASSERT(unmergedGrid.GetNumberOfPoints() ==
+                      4*unmergedGrid.GetNumberOfCells(),
+                      "Incorrect number of points when not merging.");
+      const dax::Scalar unmergedVolume =
+          CheckOutput(unmergedGrid, gradient, CLIPVALUE);
+
+      std::cout << "Clipping with merged points" << std::endl;
+      UnstructuredGridType clipGrid;
+      RunClip(inGrid.GetRealGrid(), fieldHandle, CLIPVALUE, true, clipGrid);
+      DAX_TEST_ASSERT(clipGrid.GetNumberOfCells() ==
+                      unmergedGrid.GetNumberOfCells(),
+                      "Merging points changed the number of cells.");
+      DAX_TEST_ASSERT(clipGrid.GetNumberOfPoints() <
+                      unmergedGrid.GetNumberOfPoints(),
+                      "Points were not merged.");
+      const dax::Scalar volume = CheckOutput(clipGrid, gradient, CLIPVALUE);
+      DAX_TEST_ASSERT(test_equal(volume, unmergedVolume),
+                      "Merging points changed the volume.");
+
+      std::cout << "Clipping the other side" << std::endl;
+      UnstructuredGridType otherGrid;
+      RunClip(inGrid.GetRealGrid(), negatedFieldHandle, -CLIPVALUE, true,
+              otherGrid);
+      const dax::Scalar otherVolume =
+          CheckOutput(otherGrid, -1*gradient, -CLIPVALUE);
+      DAX_TEST_ASSERT(test_equal(volume + otherVolume, totalVolume),
+                      "Both sides of the clip do not add up to the input.");
+
+      // The cells fill the whole box for hexahedra, so we know the volume on
+      // the low side of the plane x+y+z=CLIPVALUE.
+      if (dax::CellTraits<typename InputGridType::CellTag>::NUM_VERTICES == 8)
+        {
+        const dax::Scalar boxSize = DIM-1;
+        DAX_TEST_ASSERT(test_equal(totalVolume, boxSize*boxSize*boxSize),
+                        "Bad volume of unclipped grid.");
+        DAX_TEST_ASSERT(test_equal(otherVolume,
+                                   CLIPVALUE*CLIPVALUE*CLIPVALUE/6),
+                        "Bad clipped volume.");
+        }
+      }
+    catch (dax::cont::ErrorControl error)
+      {
+      std::cout << "Got error: " << error.GetMessage() << std::endl;
+      DAX_TEST_ASSERT(true==false,error.GetMessage());
+      }
+    }
+};
+
+//-----------------------------------------------------------------------------
+void TestClip()
+  {
+  dax::cont::testing::GridTesting::TryAllGridTypes(TestClipWorklet(),
+                                                   CellCheckClip());
+  }
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletClip(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestClip);
+}
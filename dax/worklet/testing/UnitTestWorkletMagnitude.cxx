@@ -31,6 +31,7 @@ namespace {
 const dax::Id DIM = 8;
 
 //-----------------------------------------------------------------------------
+template<class WorkletType>
 struct TestMagnitudeWorklet
 {
   //----------------------------------------------------------------------------
@@ -44,7 +45,7 @@ struct TestMagnitudeWorklet
 
   std::cout << "Running Magnitude worklet" << std::endl;
   dax::cont::Scheduler< > scheduler;
-  scheduler.Invoke(dax::worklet::Magnitude(),
+  scheduler.Invoke(WorkletType(),
                    grid->GetPointCoordinates(),
                    magnitudeHandle);
 
@@ -67,7 +68,13 @@ struct TestMagnitudeWorklet
 //-----------------------------------------------------------------------------
 void TestMagnitude()
   {
-  dax::cont::testing::GridTesting::TryAllGridTypes(TestMagnitudeWorklet());
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestMagnitudeWorklet<dax::worklet::Magnitude>());
+
+  std::cout << "Fast precision" << std::endl;
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestMagnitudeWorklet<dax::worklet::MagnitudeWithPrecision<
+          dax::math::PrecisionTagFast> >());
   }
 
 
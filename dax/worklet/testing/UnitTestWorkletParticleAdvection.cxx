@@ -0,0 +1,170 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/ParticleAdvection.h>
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ParticleAdvection.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 10;
+
+dax::cont::UniformGrid<> MakeGrid()
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+  return grid;
+}
+
+//-----------------------------------------------------------------------------
+void TestConstantField()
+{
+  std::cout << "Advecting through constant field" << std::endl;
+  dax::cont::UniformGrid<> grid = MakeGrid();
+
+  std::vector<dax::Vector3> velocity(grid.GetNumberOfPoints(),
+                                     dax::make_Vector3(1.0, 0.0, 0.0));
+
+  // The first seed stays inside, the second leaves the grid during the
+  // second round, and the third starts outside.
+  std::vector<dax::Vector3> seeds;
+  seeds.push_back(dax::make_Vector3(1.0, 2.5, 3.5));
+  seeds.push_back(dax::make_Vector3(7.0, 4.0, 4.0));
+  seeds.push_back(dax::make_Vector3(-1.0, 4.0, 4.0));
+
+  const dax::Scalar stepSize = 0.5;
+  const dax::Id stepsPerRound = 3;
+  const dax::Id numberOfRounds = 4;
+
+  dax::cont::ParticleAdvection<> advection(grid,
+                                           dax::cont::make_ArrayHandle(velocity),
+                                           stepSize,
+                                           stepsPerRound);
+  advection.SetRecordPolylines(true);
+  advection.Run(dax::cont::make_ArrayHandle(seeds), numberOfRounds);
+
+  std::cout << "Checking result" << std::endl;
+  DAX_TEST_ASSERT(advection.GetNumberOfActiveParticles() == 1,
+                  "Wrong number of particles still in the grid.");
+
+  std::vector<dax::Vector3> endPoints(seeds.size());
+  advection.GetEndPoints().CopyInto(endPoints.begin());
+  DAX_TEST_ASSERT(test_equal(endPoints[0], dax::make_Vector3(7.0, 2.5, 3.5)),
+                  "Bad end point for particle inside the grid.");
+  DAX_TEST_ASSERT(test_equal(endPoints[1], dax::make_Vector3(9.0, 4.0, 4.0)),
+                  "Bad end point for particle leaving the grid.");
+  DAX_TEST_ASSERT(test_equal(endPoints[2], seeds[2]),
+                  "Particle outside the grid moved.");
+
+  const dax::Id pointsPerPolyline = advection.GetPointsPerPolyline();
+  DAX_TEST_ASSERT(pointsPerPolyline == numberOfRounds*stepsPerRound + 1,
+                  "Wrong polyline stride.");
+  std::vector<dax::Id> lengths(seeds.size());
+  advection.GetPolylineLengths().CopyInto(lengths.begin());
+  DAX_TEST_ASSERT(lengths[0] == pointsPerPolyline, "Bad polyline length.");
+  DAX_TEST_ASSERT(lengths[1] == 5, "Bad polyline length.");
+  DAX_TEST_ASSERT(lengths[2] == 1, "Bad polyline length.");
+
+  std::vector<dax::Vector3> polylines(seeds.size()*pointsPerPolyline);
+  advection.GetPolylinePoints().CopyInto(polylines.begin());
+  for (dax::Id particle = 0; particle < 2; particle++)
+    {
+    for (dax::Id step = 0; step < lengths[particle]; step++)
+      {
+      dax::Vector3 expected =
+          seeds[particle] + dax::make_Vector3(step*stepSize, 0, 0);
+      DAX_TEST_ASSERT(
+            test_equal(polylines[particle*pointsPerPolyline + step], expected),
+            "Bad polyline point.");
+      }
+    }
+  DAX_TEST_ASSERT(test_equal(polylines[2*pointsPerPolyline], seeds[2]),
+                  "Polyline does not start at seed.");
+}
+
+//-----------------------------------------------------------------------------
+void TestRotationalField()
+{
+  std::cout << "Advecting through rotational field" << std::endl;
+  dax::cont::UniformGrid<> grid = MakeGrid();
+
+  // Rotation about the center of the grid. Trilinear interpolation of this
+  // field is exact, so particles should stay on circles up to the
+  // integration error.
+  const dax::Scalar center = 0.5*(DIM-1);
+  std::vector<dax::Vector3> velocity(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 coords = grid.ComputePointCoordinates(pointIndex);
+    velocity[pointIndex] =
+        dax::make_Vector3(-(coords[1]-center), coords[0]-center, 0.5);
+    }
+
+  std::vector<dax::Vector3> seeds;
+  for (dax::Id seedIndex = 0; seedIndex < 8; seedIndex++)
+    {
+    seeds.push_back(dax::make_Vector3(center + 0.5*seedIndex, center, 0.0));
+    }
+
+  dax::cont::ParticleAdvection<> advection(grid,
+                                           dax::cont::make_ArrayHandle(velocity),
+                                           0.05,
+                                           10);
+  advection.Run(dax::cont::make_ArrayHandle(seeds), 8);
+
+  std::vector<dax::Vector3> endPoints(seeds.size());
+  advection.GetEndPoints().CopyInto(endPoints.begin());
+  for (std::size_t seedIndex = 0; seedIndex < seeds.size(); seedIndex++)
+    {
+    const dax::Scalar radius = 0.5*seedIndex;
+    const dax::Vector3 offset =
+        endPoints[seedIndex] - dax::make_Vector3(center, center, 0);
+    DAX_TEST_ASSERT(
+          test_equal(dax::math::Magnitude(dax::make_Vector2(offset[0],
+                                                            offset[1])),
+                     radius,
+                     0.001),
+          "Particle left its circle.");
+    DAX_TEST_ASSERT(test_equal(offset[2], dax::Scalar(0.5*0.05*10*8)),
+                    "Bad vertical motion.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestParticleAdvection()
+{
+  TestConstantField();
+  TestRotationalField();
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletParticleAdvection(int, char *[])
+  {
+  return dax::cont::testing::Testing::Run(TestParticleAdvection);
+  }
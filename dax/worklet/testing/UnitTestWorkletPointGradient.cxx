@@ -0,0 +1,246 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/cont/PointGradient.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/math/Exp.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 8;
+
+//-----------------------------------------------------------------------------
+struct TestPointGradientWorklet
+{
+  template<typename GridType>
+  DAX_CONT_EXPORT
+  void operator()(const GridType&) const
+    {
+    dax::cont::testing::TestGrid<GridType> grid(DIM);
+
+    dax::Vector3 trueGradient = dax::make_Vector3(1.0, -2.0, 0.5);
+
+    std::vector<dax::Scalar> field(grid->GetNumberOfPoints());
+    for (dax::Id pointIndex = 0;
+         pointIndex < grid->GetNumberOfPoints();
+         pointIndex++)
+      {
+      field[pointIndex] =
+          dax::dot(grid->ComputePointCoordinates(pointIndex), trueGradient)
+          + 3;
+      }
+    dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+        dax::cont::make_ArrayHandle(field);
+
+    typedef dax::cont::PointGradient<GridType> PointGradientType;
+    typename PointGradientType::VectorArrayHandleType gradientHandle;
+
+    std::cout << "Running PointGradient" << std::endl;
+    PointGradientType pointGradient(grid.GetRealGrid());
+    pointGradient.Run(fieldHandle, gradientHandle);
+
+    std::cout << "Checking result" << std::endl;
+    DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues()
+                    == grid->GetNumberOfPoints(),
+                    "Wrong number of gradients.");
+    std::vector<dax::Vector3> gradient(grid->GetNumberOfPoints());
+    gradientHandle.CopyInto(gradient.begin());
+    for (dax::Id pointIndex = 0;
+         pointIndex < grid->GetNumberOfPoints();
+         pointIndex++)
+      {
+      DAX_TEST_ASSERT(test_equal(gradient[pointIndex], trueGradient),
+                      "Got bad gradient");
+      }
+    }
+};
+
+//-----------------------------------------------------------------------------
+void TestUniformQuadratic()
+{
+  std::cout << "Central differences on a uniform grid" << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+  grid.SetOrigin(dax::make_Vector3(-1.0, 2.0, 0.25));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1.0, 2.0));
+
+  // f = x^2 + y*z. Central differences are exact for quadratics, so the
+  // interior gradient is (2x, z, y).
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 coords = grid.ComputePointCoordinates(pointIndex);
+    field[pointIndex] = coords[0]*coords[0] + coords[1]*coords[2];
+    }
+
+  dax::cont::PointGradient<dax::cont::UniformGrid<> > pointGradient(grid);
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+  pointGradient.Run(dax::cont::make_ArrayHandle(field), gradientHandle);
+
+  std::vector<dax::Vector3> gradient(grid.GetNumberOfPoints());
+  gradientHandle.CopyInto(gradient.begin());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Id3 ijk = dax::flatIndexToIndex3(pointIndex, grid.GetExtent());
+    if ((ijk[0] < 1) || (ijk[0] > DIM-2) ||
+        (ijk[1] < 1) || (ijk[1] > DIM-2) ||
+        (ijk[2] < 1) || (ijk[2] > DIM-2))
+      {
+      continue;
+      }
+    dax::Vector3 coords = grid.ComputePointCoordinates(pointIndex);
+    dax::Vector3 expected =
+        dax::make_Vector3(2*coords[0], coords[2], coords[1]);
+    DAX_TEST_ASSERT(test_equal(gradient[pointIndex], expected),
+                    "Got bad central difference");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestIncidence()
+{
+  std::cout << "Point to cell incidence" << std::endl;
+  typedef dax::cont::UnstructuredGrid<dax::CellTagHexahedron> GridType;
+  dax::cont::testing::TestGrid<GridType> grid(DIM);
+
+  dax::cont::PointGradient<GridType> pointGradient(grid.GetRealGrid());
+  dax::cont::PointGradient<GridType>::IdArrayHandleType offsetsHandle =
+      pointGradient.GetPointOffsets();
+  dax::cont::PointGradient<GridType>::IdArrayHandleType cellIdsHandle =
+      pointGradient.GetIncidentCellIds();
+
+  DAX_TEST_ASSERT(offsetsHandle.GetNumberOfValues()
+                  == grid->GetNumberOfPoints()+1,
+                  "Wrong number of offsets.");
+  DAX_TEST_ASSERT(cellIdsHandle.GetNumberOfValues()
+                  == grid->GetNumberOfCells()*8,
+                  "Wrong number of incident cells.");
+
+  std::vector<dax::Id> offsets(offsetsHandle.GetNumberOfValues());
+  offsetsHandle.CopyInto(offsets.begin());
+  std::vector<dax::Id> cellIds(cellIdsHandle.GetNumberOfValues());
+  cellIdsHandle.CopyInto(cellIds.begin());
+
+  DAX_TEST_ASSERT(offsets.back() == grid->GetNumberOfCells()*8,
+                  "Bad final offset.");
+  // The test hexahedra share the point layout of a DIM^3 uniform grid. A
+  // corner point touches one cell, an interior point touches eight.
+  DAX_TEST_ASSERT(offsets[1] - offsets[0] == 1, "Bad corner incidence.");
+  dax::Id interior = 1 + DIM + DIM*DIM;
+  DAX_TEST_ASSERT(offsets[interior+1] - offsets[interior] == 8,
+                  "Bad interior incidence.");
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid->GetNumberOfPoints();
+       pointIndex++)
+    {
+    for (dax::Id entry = offsets[pointIndex];
+         entry < offsets[pointIndex+1];
+         entry++)
+      {
+      dax::cont::testing::CellConnections<dax::CellTagHexahedron> vertices =
+          grid.GetCellConnections(cellIds[entry]);
+      bool found = false;
+      for (int vertex = 0; vertex < 8; vertex++)
+        {
+        found |= (vertices[vertex] == pointIndex);
+        }
+      DAX_TEST_ASSERT(found, "Incident cell does not use point.");
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestNormals()
+{
+  std::cout << "Vertex normals of a pyramid surface" << std::endl;
+  // Apex over a square base; four triangles wound counterclockwise when
+  // viewed from outside.
+  const dax::Vector3 points[5] = {
+    dax::make_Vector3( 0.0,  0.0, 1.0),
+    dax::make_Vector3( 1.0,  1.0, 0.0),
+    dax::make_Vector3(-1.0,  1.0, 0.0),
+    dax::make_Vector3(-1.0, -1.0, 0.0),
+    dax::make_Vector3( 1.0, -1.0, 0.0)
+  };
+  const dax::Id connections[12] = { 0, 4, 1,  0, 1, 2,  0, 2, 3,  0, 3, 4 };
+
+  std::vector<dax::Vector3> pointVector(points, points+5);
+  std::vector<dax::Id> connectionVector(connections, connections+12);
+
+  typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> GridType;
+  GridType grid(dax::cont::make_ArrayHandle(connectionVector),
+                dax::cont::make_ArrayHandle(pointVector));
+
+  dax::cont::PointGradient<GridType> pointGradient(grid);
+  dax::cont::PointGradient<GridType>::VectorArrayHandleType normalsHandle;
+  pointGradient.RunNormals(normalsHandle);
+
+  std::vector<dax::Vector3> normals(5);
+  normalsHandle.CopyInto(normals.begin());
+
+  DAX_TEST_ASSERT(test_equal(normals[0], dax::make_Vector3(0.0, 0.0, 1.0)),
+                  "Bad apex normal.");
+  // Each base corner touches two faces with normals (1,0,1)/sqrt(2) and
+  // (0,1,1)/sqrt(2) (up to sign of x and y).
+  dax::Scalar invSqrt6 = dax::math::RSqrt(dax::Scalar(6));
+  DAX_TEST_ASSERT(test_equal(normals[1],
+                             dax::make_Vector3(1.0, 1.0, 2.0)*invSqrt6),
+                  "Bad corner normal.");
+  DAX_TEST_ASSERT(test_equal(normals[3],
+                             dax::make_Vector3(-1.0, -1.0, 2.0)*invSqrt6),
+                  "Bad corner normal.");
+  for (int pointIndex = 0; pointIndex < 5; pointIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(dax::math::Magnitude(normals[pointIndex]),
+                               dax::Scalar(1)),
+                    "Normal not unit length.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestPointGradient()
+{
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestPointGradientWorklet(),
+        dax::testing::Testing::CellCheckTopologicalDimensions<3>());
+  TestUniformQuadratic();
+  TestIncidence();
+  TestNormals();
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletPointGradient(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestPointGradient);
+}
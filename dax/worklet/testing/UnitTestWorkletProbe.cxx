@@ -0,0 +1,178 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/Probe.h>
+
+#include <dax/CellTag.h>
+#include <dax/Types.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/CellLocatorUniformBins.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 8;
+
+dax::Scalar ScalarFieldValue(const dax::Vector3 &coordinates)
+{
+  return dax::dot(coordinates, dax::make_Vector3(1.0, 2.0, 3.0));
+}
+
+bool InsideSourceBounds(const dax::Vector3 &coordinates)
+{
+  for (int dimension = 0; dimension < 3; dimension++)
+    {
+    if ((coordinates[dimension] < 0) || (coordinates[dimension] > DIM-1))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template<class CellTag>
+void TestProbeCells(bool sourceFillsBounds)
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> SourceGridType;
+  dax::cont::testing::TestGrid<SourceGridType> source(DIM);
+
+  std::vector<dax::Scalar> scalars(source->GetNumberOfPoints());
+  std::vector<dax::Vector3> vectors(source->GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < source->GetNumberOfPoints();
+       pointIndex++)
+    {
+    vectors[pointIndex] = source->ComputePointCoordinates(pointIndex);
+    scalars[pointIndex] = ScalarFieldValue(vectors[pointIndex]);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> scalarHandle =
+      dax::cont::make_ArrayHandle(scalars);
+  dax::cont::ArrayHandle<dax::Vector3> vectorHandle =
+      dax::cont::make_ArrayHandle(vectors);
+
+  // The target grid sticks out past the source on all sides and does not
+  // line up with its points.
+  dax::cont::UniformGrid<> target;
+  target.SetOrigin(dax::make_Vector3(-0.75, -0.75, -0.75));
+  target.SetSpacing(dax::make_Vector3(0.5, 0.5, 0.5));
+  target.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(18, 18, 18));
+
+  dax::cont::CellLocatorUniformBins<SourceGridType> locator(
+        source.GetRealGrid(), target, dax::make_Id3(5, 6, 7));
+
+  dax::cont::ArrayHandle<dax::Id> cellIdHandle;
+  dax::cont::ArrayHandle<dax::Vector3> pcoordsHandle;
+  dax::cont::ArrayHandle<dax::Id> validHandle;
+  dax::cont::ArrayHandle<dax::Scalar> probedScalarHandle;
+  dax::cont::ArrayHandle<dax::Vector3> probedVectorHandle;
+
+  std::cout << "Running Probe worklets" << std::endl;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::ProbeLocate(),
+                   target.GetPointCoordinates(),
+                   locator.PrepareForInput(),
+                   cellIdHandle,
+                   pcoordsHandle,
+                   validHandle);
+  scheduler.Invoke(dax::worklet::ProbeInterpolate(),
+                   cellIdHandle,
+                   pcoordsHandle,
+                   locator.PrepareFieldForInput(scalarHandle),
+                   probedScalarHandle);
+  scheduler.Invoke(dax::worklet::ProbeInterpolate(),
+                   cellIdHandle,
+                   pcoordsHandle,
+                   locator.PrepareFieldForInput(vectorHandle),
+                   probedVectorHandle);
+
+  std::cout << "Checking result" << std::endl;
+  DAX_TEST_ASSERT(validHandle.GetNumberOfValues()
+                  == target.GetNumberOfPoints(),
+                  "Wrong number of probed points.");
+  DAX_TEST_ASSERT(probedScalarHandle.GetNumberOfValues()
+                  == target.GetNumberOfPoints(),
+                  "Wrong number of probed values.");
+
+  std::vector<dax::Id> valid(target.GetNumberOfPoints());
+  std::vector<dax::Id> cellIds(target.GetNumberOfPoints());
+  std::vector<dax::Scalar> probedScalars(target.GetNumberOfPoints());
+  std::vector<dax::Vector3> probedVectors(target.GetNumberOfPoints());
+  validHandle.CopyInto(valid.begin());
+  cellIdHandle.CopyInto(cellIds.begin());
+  probedScalarHandle.CopyInto(probedScalars.begin());
+  probedVectorHandle.CopyInto(probedVectors.begin());
+
+  dax::Id numValid = 0;
+  for (dax::Id pointIndex = 0;
+       pointIndex < target.GetNumberOfPoints();
+       pointIndex++)
+    {
+    const dax::Vector3 coordinates =
+        target.ComputePointCoordinates(pointIndex);
+    if (!InsideSourceBounds(coordinates))
+      {
+      DAX_TEST_ASSERT(valid[pointIndex] == 0,
+                      "Point outside of source marked valid.");
+      DAX_TEST_ASSERT(cellIds[pointIndex] == -1,
+                      "Point outside of source found a cell.");
+      DAX_TEST_ASSERT(test_equal(probedScalars[pointIndex], dax::Scalar(0)),
+                      "Invalid point not zeroed.");
+      continue;
+      }
+    if (sourceFillsBounds)
+      {
+      DAX_TEST_ASSERT(valid[pointIndex] == 1,
+                      "Point inside of source not found.");
+      }
+    if (valid[pointIndex] == 1)
+      {
+      numValid++;
+      DAX_TEST_ASSERT(cellIds[pointIndex] >= 0, "Valid point has no cell.");
+      DAX_TEST_ASSERT(test_equal(probedScalars[pointIndex],
+                                 ScalarFieldValue(coordinates)),
+                      "Got bad probed scalar.");
+      DAX_TEST_ASSERT(test_equal(probedVectors[pointIndex], coordinates),
+                      "Got bad probed vector.");
+      }
+    }
+  DAX_TEST_ASSERT(numValid > 0, "No points were probed.");
+}
+
+//-----------------------------------------------------------------------------
+void TestProbe()
+  {
+  std::cout << "*** Probing hexahedra ***" << std::endl;
+  TestProbeCells<dax::CellTagHexahedron>(true);
+  std::cout << "*** Probing tetrahedra ***" << std::endl;
+  TestProbeCells<dax::CellTagTetrahedron>(false);
+  }
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletProbe(int, char *[])
+  {
+  return dax::cont::testing::Testing::Run(TestProbe);
+  }